@@ -0,0 +1,87 @@
+#include <stdint.h>
+#include <stdbool.h>
+
+#ifndef adcmux_inc_h
+#define adcmux_inc_h
+
+// Serviço único do ADC para vários clientes: o ADC converte em rodízio (round robin) os canais pedidos,
+// um só fluxo de DMA (dois canais encadeados em ping-pong, escrita em anel) traz os quadros para a RAM
+// e a interrupção de fim de bloco distribui as amostras aos clientes.
+// Cada cliente escolhe canal (0-3: GPIO26-29, 4: sensor de temperatura) e taxa; recebe a média das
+// amostras do seu canal em cada período (decimação em bloco, que também filtra) numa fila circular própria,
+// com contadores de amostras produzidas, lidas e descartadas (fila cheia).
+// Taxa dos quadros: o mínimo múltiplo comum das taxas pedidas (ou a maior delas, se não couber),
+// multiplicada até o ADC ficar acima do seu mínimo. Clientes cuja taxa não divide a dos quadros
+// recebem a taxa inteira mais próxima (adcmux_client_rate())
+
+#define adcmux_channels 5
+#define adcmux_max_clients 8
+#define adcmux_adc_clock 48000000u
+#define adcmux_max_rate 500000u   // Conversões por segundo no total (limite do ADC)
+#define adcmux_min_rate 1000u     // Abaixo disso o divisor do ADC não alcança (~733 por segundo)
+#define adcmux_max_block 256      // Amostras por bloco do DMA (potência de 2)
+#define adcmux_min_block 4
+#define adcmux_block_us 2000      // Duração desejada de um bloco: latência máxima de entrega
+
+typedef struct adcmux_client {
+    uint8_t channel;
+    uint32_t rate_hz;            // Taxa pedida
+    uint32_t stride;             // Quadros por amostra entregue
+    uint16_t *buffer;            // Fila circular (tamanho potência de 2)
+    uint32_t size;
+    volatile uint32_t head;      // Escrito só pela interrupção
+    volatile uint32_t tail;      // Escrito só pelo leitor
+    uint32_t sum;                // Soma da janela em andamento
+    uint32_t count;
+    volatile uint32_t produced;  // Amostras entregues à fila
+    volatile uint32_t dropped;   // Amostras descartadas com a fila cheia
+    uint32_t reported;           // produced no último relatório
+    struct adcmux_client *next;  // Próximo cliente do mesmo canal
+} adcmux_client_t;
+
+// Contadores do fluxo
+typedef struct {
+    uint32_t frame_rate;         // Quadros (um ciclo do rodízio) por segundo
+    uint32_t block_size;         // Amostras por bloco do DMA
+    volatile uint32_t blocks;    // Blocos distribuídos
+    volatile uint32_t block_overruns; // Blocos reescritos pelo DMA antes da distribuição
+    volatile uint32_t fifo_overruns;  // Estouros do FIFO do ADC
+} adcmux_stats_t;
+
+extern adcmux_stats_t adcmux_stats;
+
+// Registra um cliente antes de adcmux_start(); buffer com size amostras (potência de 2)
+void adcmux_add_client(adcmux_client_t *client, uint8_t channel, uint32_t rate_hz, uint16_t *buffer, uint32_t size);
+
+// Calcula as taxas, configura ADC e DMA (DMA_IRQ_1 no núcleo que chamar) e inicia as conversões
+void adcmux_start(void);
+
+// Distribui um bloco de amostras do rodízio aos clientes (chamada pela interrupção do DMA)
+void adcmux_demux(const uint16_t *samples, uint32_t count);
+
+// Taxa efetivamente entregue ao cliente (depois de adcmux_start())
+uint32_t adcmux_client_rate(const adcmux_client_t *client);
+
+// Amostras esperando na fila do cliente
+static inline uint32_t adcmux_available(const adcmux_client_t *client) {
+    return client->head - client->tail;
+}
+
+// Lê a amostra mais antiga; false se a fila estiver vazia
+bool adcmux_read(adcmux_client_t *client, uint16_t *sample);
+
+// Lê até max amostras, da mais antiga à mais nova; retorna quantas leu
+uint32_t adcmux_read_block(adcmux_client_t *client, uint16_t *samples, uint32_t max);
+
+// Esvazia a fila e fica com a amostra mais nova; false (sample intacto) se a fila estiver vazia
+bool adcmux_read_latest(adcmux_client_t *client, uint16_t *sample);
+
+// Imprime, por cliente, taxa pedida e obtida, vazão desde o último relatório e descartes
+void adcmux_report(void);
+
+#ifdef ADCMUX_HOST
+// Só no computador: esquece clientes e contadores, para planejar outra combinação
+void adcmux_host_reset(void);
+#endif
+
+#endif
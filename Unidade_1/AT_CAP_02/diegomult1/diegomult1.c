@@ -1,12 +1,13 @@
 #include <stdio.h>
 #include "pico/stdlib.h"
 #include "pico/multicore.h"
-#include "hardware/adc.h"
 #include "hardware/gpio.h"
 #include "pico/time.h"
 #include <stdlib.h>
 #include "hardware/pwm.h"
 #include "hardware/clocks.h" // Adicionado para clock_get_hz e clk_sys
+#include "telemetry/telemetry.h"
+#include "adcmux/adcmux.h"
 
 
 /* ――― Pinos do Joystick ――― */
@@ -33,6 +34,21 @@ volatile uint8_t global_state = 0; // 0 = baixo, 1 = moderado, 2 = alto, 3 = cr
 /* ――― Período do Alarme (Núcleo 0) ――― */
 #define ALARM_PERIOD_MS 50
 
+/* ――― Serviço do ADC: os dois eixos no mesmo fluxo de DMA, uma média por período do alarme ――― */
+#define JOYSTICK_RATE_HZ (1000 / ALARM_PERIOD_MS)
+#define JOYSTICK_BUFFER_SIZE 8  // Fila de cada eixo (potência de 2)
+#define ADC_REPORT_MS 5000      // Intervalo do relatório de vazão do ADC
+
+/* ――― Telemetria pela USB ――― */
+#define TELEMETRY_BINARY 1   // 1: quadros binários (telemetry/telemetry_decode.cpp gera o CSV); 0: linhas de texto
+#define TELEMETRY_JOYSTICK 1 // Leitura do joystick (núcleo 0)
+#define TELEMETRY_STATE 2    // Estado calculado (núcleo 1)
+
+/* ――― Clientes do ADC (canal = GPIO - 26) ――― */
+adcmux_client_t joystick_vrx_client, joystick_vry_client;
+uint16_t joystick_vrx_buffer[JOYSTICK_BUFFER_SIZE], joystick_vry_buffer[JOYSTICK_BUFFER_SIZE];
+uint16_t vrx_value = 2048, vry_value = 2048; // Últimos valores (centro até a primeira média)
+
 void inicializar_pino(uint pino, uint direcao)
 {
     gpio_init(pino);
@@ -42,13 +58,16 @@ void inicializar_pino(uint pino, uint direcao)
 /* ――― Função de Alarme (Núcleo 0) ――― */
 int64_t joystick_alarm_callback(alarm_id_t id, void *user_data)
 {
-    adc_select_input(0);
-    uint16_t vry_value = adc_read();
-    adc_select_input(1);
-    uint16_t vrx_value = adc_read();
+    adcmux_read_latest(&joystick_vry_client, &vry_value);
+    adcmux_read_latest(&joystick_vrx_client, &vrx_value);
     uint32_t joystick_data = (vrx_value << 16) | vry_value;
     multicore_fifo_push_blocking(joystick_data);
+#if TELEMETRY_BINARY
+    int32_t values[] = { vrx_value, vry_value };
+    telemetry_send(TELEMETRY_JOYSTICK, time_us_32(), values, count_of(values));
+#else
     printf("[CORE 0] VRx: %d, VRy: %d (enviado para CORE 1)\n", vrx_value, vry_value);
+#endif
     return ALARM_PERIOD_MS * 1000;
 }
 
@@ -59,13 +78,23 @@ int main(void)
 {
     stdio_init_all();
     sleep_ms(2000);
-    adc_init();
-    adc_gpio_init(JOYSTICK_VRY);
-    adc_gpio_init(JOYSTICK_VRX);
+#if TELEMETRY_BINARY
+    telemetry_define(TELEMETRY_JOYSTICK, "joystick", "vrx,vry");
+    telemetry_define(TELEMETRY_STATE, "estado", "vrx,vry,atividade,estado");
+#endif
+    adcmux_add_client(&joystick_vry_client, JOYSTICK_VRY - 26, JOYSTICK_RATE_HZ, joystick_vry_buffer, JOYSTICK_BUFFER_SIZE);
+    adcmux_add_client(&joystick_vrx_client, JOYSTICK_VRX - 26, JOYSTICK_RATE_HZ, joystick_vrx_buffer, JOYSTICK_BUFFER_SIZE);
+    adcmux_start();
     multicore_launch_core1(core1_entry);
     add_alarm_in_ms(ALARM_PERIOD_MS, joystick_alarm_callback, NULL, true);
+    uint32_t last_report_us = time_us_32();
     while (true)
     {
+        if (time_us_32() - last_report_us >= ADC_REPORT_MS * 1000)
+        {
+            last_report_us += ADC_REPORT_MS * 1000;
+            adcmux_report();
+        }
         tight_loop_contents();
     }
 }
@@ -106,8 +135,6 @@ static void core1_entry(void)
             uint16_t received_vrx = (joystick_data >> 16) & 0xFFFF;
             uint16_t received_vry = joystick_data & 0xFFFF;
 
-            printf("[CORE 1] Recebeu VRx: %d, VRy: %d\n", received_vrx, received_vry);
-
             uint16_t activity_level = (abs(2048 - received_vrx) + abs(2048 - received_vry));
 
             // Determina o estado global
@@ -127,6 +154,12 @@ static void core1_entry(void)
             {
                 global_state = 0; // Baixo
             }
+#if TELEMETRY_BINARY
+            int32_t values[] = { received_vrx, received_vry, activity_level, global_state };
+            telemetry_send(TELEMETRY_STATE, time_us_32(), values, count_of(values));
+#else
+            printf("[CORE 1] Recebeu VRx: %d, VRy: %d\n", received_vrx, received_vry);
+#endif
             // Controle do Buzzer PWM (GPIO 21) - BIPE
             if (global_state == 3)
             {
@@ -0,0 +1,297 @@
+#include <stdio.h>
+#include <string.h>
+#include <assert.h>
+#ifdef ADCMUX_HOST
+// No computador (adcmux_test.c): só o planejamento e a distribuição, sem ADC nem DMA
+#define __dmb() __atomic_thread_fence(__ATOMIC_SEQ_CST)
+#else
+#include "pico/stdlib.h"
+#include "hardware/adc.h"
+#include "hardware/dma.h"
+#include "hardware/irq.h"
+#include "hardware/sync.h"
+#endif
+#include "adcmux.h"
+
+adcmux_stats_t adcmux_stats;
+
+static adcmux_client_t *adcmux_clients[adcmux_max_clients];
+static int adcmux_client_count = 0;
+static adcmux_client_t *adcmux_channel_clients[adcmux_channels]; // Clientes de cada canal (lista)
+static uint8_t adcmux_order[adcmux_channels]; // Canais na ordem do rodízio (crescente)
+static uint32_t adcmux_order_count = 0;
+static uint32_t adcmux_phase = 0;              // Posição no rodízio da próxima amostra
+#ifndef ADCMUX_HOST
+static uint32_t adcmux_report_us = 0;
+
+// Dois blocos consecutivos; alinhados ao tamanho total, cada bloco fica alinhado ao próprio tamanho (anel)
+static uint16_t adcmux_buffer[2 * adcmux_max_block] __attribute__((aligned(2 * adcmux_max_block * sizeof(uint16_t))));
+static int adcmux_dma_chan[2];
+#endif
+
+void adcmux_add_client(adcmux_client_t *client, uint8_t channel, uint32_t rate_hz, uint16_t *buffer, uint32_t size) {
+    assert(adcmux_client_count < adcmux_max_clients);
+    assert(channel < adcmux_channels && rate_hz > 0);
+    assert(size && (size & (size - 1)) == 0);
+
+    *client = (adcmux_client_t){ .channel = channel, .rate_hz = rate_hz, .buffer = buffer, .size = size };
+    client->next = adcmux_channel_clients[channel];
+    adcmux_channel_clients[channel] = client;
+    adcmux_clients[adcmux_client_count++] = client;
+}
+
+static uint32_t adcmux_gcd(uint32_t a, uint32_t b) {
+    while (b) {
+        uint32_t t = a % b;
+
+        a = b;
+        b = t;
+    }
+
+    return a;
+}
+
+// Taxa dos quadros e decimação de cada cliente; devolve a taxa total de conversões
+static uint32_t adcmux_plan(void) {
+    uint32_t lcm = 1, max_rate = 0;
+
+    adcmux_order_count = 0;
+    for (int channel = 0; channel < adcmux_channels; channel++) {
+        if (adcmux_channel_clients[channel]) {
+            adcmux_order[adcmux_order_count++] = channel;
+        }
+    }
+    assert(adcmux_order_count > 0);
+
+    for (int i = 0; i < adcmux_client_count; i++) {
+        uint32_t rate = adcmux_clients[i]->rate_hz;
+
+        if (rate > max_rate) {
+            max_rate = rate;
+        }
+        if (lcm <= adcmux_max_rate) {
+            uint64_t next = (uint64_t)(lcm / adcmux_gcd(lcm, rate)) * rate;
+
+            lcm = next > adcmux_max_rate ? adcmux_max_rate + 1 : (uint32_t)next; // Grande demais: fica sem MMC
+        }
+    }
+    assert(max_rate * adcmux_order_count <= adcmux_max_rate);
+
+    uint32_t frame_rate = lcm * adcmux_order_count <= adcmux_max_rate ? lcm : max_rate;
+    uint32_t multiple = frame_rate;
+
+    while (frame_rate * adcmux_order_count < adcmux_min_rate) {
+        frame_rate += multiple;
+    }
+
+    for (int i = 0; i < adcmux_client_count; i++) {
+        adcmux_client_t *client = adcmux_clients[i];
+
+        client->stride = (frame_rate + client->rate_hz / 2) / client->rate_hz;
+    }
+    adcmux_stats.frame_rate = frame_rate;
+
+    // Maior bloco (potência de 2) que não passa de adcmux_block_us
+    uint32_t total_rate = frame_rate * adcmux_order_count;
+    uint32_t block = adcmux_max_block;
+
+    while (block > adcmux_min_block && (uint64_t)block * 1000000 > (uint64_t)total_rate * adcmux_block_us) {
+        block >>= 1;
+    }
+    adcmux_stats.block_size = block;
+
+    return total_rate;
+}
+
+uint32_t adcmux_client_rate(const adcmux_client_t *client) {
+    return client->stride ? adcmux_stats.frame_rate / client->stride : 0;
+}
+
+static inline void adcmux_push(adcmux_client_t *client, uint16_t sample) {
+    uint32_t head = client->head;
+
+    if (head - client->tail == client->size) {
+        client->dropped++;
+        return;
+    }
+    client->buffer[head & (client->size - 1)] = sample;
+    __dmb(); // A amostra fica visível antes do novo índice (leitor no outro núcleo)
+    client->head = head + 1;
+    client->produced++;
+}
+
+void adcmux_demux(const uint16_t *samples, uint32_t count) {
+    uint32_t phase = adcmux_phase;
+
+    for (uint32_t i = 0; i < count; i++) {
+        adcmux_client_t *client = adcmux_channel_clients[adcmux_order[phase]];
+
+        if (++phase == adcmux_order_count) {
+            phase = 0;
+        }
+        for (; client; client = client->next) {
+            client->sum += samples[i];
+            if (++client->count == client->stride) {
+                adcmux_push(client, (uint16_t)((client->sum + client->stride / 2) / client->stride));
+                client->sum = 0;
+                client->count = 0;
+            }
+        }
+    }
+
+    adcmux_phase = phase;
+}
+
+bool adcmux_read(adcmux_client_t *client, uint16_t *sample) {
+    uint32_t tail = client->tail;
+
+    if (client->head == tail) {
+        return false;
+    }
+    __dmb();
+    *sample = client->buffer[tail & (client->size - 1)];
+    client->tail = tail + 1;
+
+    return true;
+}
+
+uint32_t adcmux_read_block(adcmux_client_t *client, uint16_t *samples, uint32_t max) {
+    uint32_t tail = client->tail;
+    uint32_t count = client->head - tail;
+
+    if (count > max) {
+        count = max;
+    }
+    __dmb();
+    for (uint32_t i = 0; i < count; i++) {
+        samples[i] = client->buffer[(tail + i) & (client->size - 1)];
+    }
+    client->tail = tail + count;
+
+    return count;
+}
+
+bool adcmux_read_latest(adcmux_client_t *client, uint16_t *sample) {
+    uint32_t head = client->head;
+
+    if (head == client->tail) {
+        return false;
+    }
+    __dmb();
+    *sample = client->buffer[(head - 1) & (client->size - 1)];
+    client->tail = head;
+
+    return true;
+}
+
+#ifdef ADCMUX_HOST
+// Só o planejamento: as amostras chegam por adcmux_demux(), como se viessem do DMA
+void adcmux_start(void) {
+    adcmux_plan();
+}
+
+void adcmux_host_reset(void) {
+    memset(adcmux_clients, 0, sizeof(adcmux_clients));
+    memset(adcmux_channel_clients, 0, sizeof(adcmux_channel_clients));
+    memset(&adcmux_stats, 0, sizeof(adcmux_stats));
+    adcmux_client_count = 0;
+    adcmux_order_count = 0;
+    adcmux_phase = 0;
+}
+#else
+// Fim de bloco: o outro canal já assumiu o fluxo (encadeamento); o bloco é distribuído aqui mesmo.
+// Se o canal que terminou já foi disparado de novo, o bloco foi (em parte) reescrito: conta e distribui
+static void adcmux_dma_irq_handler(void) {
+    for (int i = 0; i < 2; i++) {
+        if (!dma_channel_get_irq1_status(adcmux_dma_chan[i])) {
+            continue;
+        }
+        dma_channel_acknowledge_irq1(adcmux_dma_chan[i]);
+
+        if (dma_channel_is_busy(adcmux_dma_chan[i])) {
+            adcmux_stats.block_overruns++;
+        }
+        adcmux_demux(adcmux_buffer + i * adcmux_stats.block_size, adcmux_stats.block_size);
+        adcmux_stats.blocks++;
+    }
+
+    if (adc_hw->fcs & ADC_FCS_OVER_BITS) {
+        adcmux_stats.fifo_overruns++;
+        adc_hw->fcs |= ADC_FCS_OVER_BITS; // Limpa o indicador (escrever 1)
+    }
+}
+
+void adcmux_start(void) {
+    uint32_t total_rate = adcmux_plan();
+    uint32_t block = adcmux_stats.block_size;
+    uint32_t mask = 0;
+
+    adc_init();
+    for (uint32_t i = 0; i < adcmux_order_count; i++) {
+        uint8_t channel = adcmux_order[i];
+
+        mask |= 1u << channel;
+        if (channel < 4) {
+            adc_gpio_init(26 + channel);
+        }
+        else {
+            adc_set_temp_sensor_enabled(true);
+        }
+    }
+    adc_select_input(adcmux_order[0]); // O rodízio segue em ordem crescente a partir do canal selecionado
+    adc_set_round_robin(adcmux_order_count > 1 ? mask : 0);
+    adc_fifo_setup(true, true, 1, false, false);
+    adc_set_clkdiv((float)adcmux_adc_clock / total_rate - 1);
+
+    // Ring: cada canal escreve sempre o seu bloco, mesmo com as interrupções desligadas
+    int ring_bits = 0;
+    while ((1u << ring_bits) < block * sizeof(uint16_t)) {
+        ring_bits++;
+    }
+
+    adcmux_dma_chan[0] = dma_claim_unused_channel(true);
+    adcmux_dma_chan[1] = dma_claim_unused_channel(true);
+    for (int i = 0; i < 2; i++) {
+        dma_channel_config config = dma_channel_get_default_config(adcmux_dma_chan[i]);
+
+        channel_config_set_transfer_data_size(&config, DMA_SIZE_16);
+        channel_config_set_read_increment(&config, false);
+        channel_config_set_write_increment(&config, true);
+        channel_config_set_ring(&config, true, ring_bits);
+        channel_config_set_dreq(&config, DREQ_ADC);
+        channel_config_set_chain_to(&config, adcmux_dma_chan[i ^ 1]);
+        dma_channel_configure(adcmux_dma_chan[i], &config, adcmux_buffer + i * block, &adc_hw->fifo, block, false);
+        dma_channel_set_irq1_enabled(adcmux_dma_chan[i], true);
+    }
+
+    irq_add_shared_handler(DMA_IRQ_1, adcmux_dma_irq_handler, PICO_SHARED_IRQ_HANDLER_DEFAULT_ORDER_PRIORITY);
+    irq_set_enabled(DMA_IRQ_1, true);
+
+    adcmux_report_us = time_us_32();
+    adc_fifo_drain();
+    dma_channel_start(adcmux_dma_chan[0]);
+    adc_run(true);
+}
+
+void adcmux_report(void) {
+    uint32_t now = time_us_32();
+    uint32_t elapsed_us = now - adcmux_report_us;
+
+    adcmux_report_us = now;
+    printf("ADC: %lu quadros/s x %lu canais, blocos %lu (%lu amostras), perdidos %lu, fifo %lu\n",
+           adcmux_stats.frame_rate, adcmux_order_count, adcmux_stats.blocks, adcmux_stats.block_size,
+           adcmux_stats.block_overruns, adcmux_stats.fifo_overruns);
+
+    for (int i = 0; i < adcmux_client_count; i++) {
+        adcmux_client_t *client = adcmux_clients[i];
+        uint32_t produced = client->produced;
+        uint32_t delivered = produced - client->reported;
+
+        client->reported = produced;
+        printf("ADC cliente %d: canal %u, pedido %lu/s, obtido %lu/s, vazao %lu/s, entregues %lu, descartados %lu, na fila %lu\n",
+               i, client->channel, client->rate_hz, adcmux_client_rate(client),
+               elapsed_us ? (uint32_t)((uint64_t)delivered * 1000000 / elapsed_us) : 0,
+               produced, client->dropped, adcmux_available(client));
+    }
+}
+#endif
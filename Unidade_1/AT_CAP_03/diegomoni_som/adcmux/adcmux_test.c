@@ -0,0 +1,178 @@
+// Confere o serviço do ADC (adcmux.c) no computador, sem ADC nem DMA: para combinações de clientes, o
+// planejamento (taxa dos quadros, decimação de cada cliente, tamanho do bloco) e a distribuição de um fluxo
+// de rodízio sintético de 2 s, entregue em pedaços de tamanhos aleatórios como os blocos do DMA.
+// Cada amostra entregue deve ser exatamente a média arredondada das amostras do seu canal no período, e as
+// contagens de entregues e descartados (fila cheia) devem bater com a taxa obtida. O microfone é lido em
+// blocos de 256 (adcmux_read_block), como no laço principal de diegomoni_som.c.
+// Falha (código de saída 1) se alguma conferência não passar.
+//
+// Compilação: gcc -std=c11 -O2 -DADCMUX_HOST -o adcmux_test adcmux_test.c adcmux.c
+// Uso:        adcmux_test
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdbool.h>
+#include "adcmux.h"
+
+#define test_seconds 2
+#define test_max_clients 5
+
+typedef struct {
+    uint8_t channel;
+    uint32_t rate_hz;
+    uint32_t size;       // Fila do cliente
+    bool drain;          // false: nunca lida (a fila enche e o resto é descartado)
+    uint32_t expect_rate;
+    uint32_t block;      // Leitura em blocos deste tamanho quando houver um inteiro (0: amostra a amostra)
+} test_client_t;
+
+typedef struct {
+    const char *name;
+    uint32_t frame_rate, block_size;
+    int count;
+    test_client_t clients[test_max_clients];
+} test_case_t;
+
+static const test_case_t test_cases[] = {
+    { "joystick (2 eixos a 20/s)", 500, 4, 2, {
+        { 0, 20, 1024, true, 20, 0 }, { 1, 20, 1024, true, 20, 0 } } },
+    { "placa combinada", 16000, 128, 5, {
+        { 0, 20, 1024, true, 20, 0 }, { 1, 20, 1024, true, 20, 0 }, { 2, 16000, 1024, true, 16000, 0 },
+        { 4, 1000, 1024, true, 1000, 0 }, { 2, 50, 16, false, 50, 0 } } }, // 100 produzidas, 16 na fila, 84 descartadas
+    { "taxas sem MMC pequeno", 44100, 128, 2, {
+        { 3, 44100, 1024, true, 44100, 0 }, { 4, 1000, 1024, true, 1002, 0 } } },
+    { "microfone (16 kHz, blocos de 256 como diegomoni_som)", 16000, 32, 1, {
+        { 2, 16000, 4096, true, 16000, 256 } } },
+};
+
+// Valor sintético do canal no quadro frame (varia com o canal e de quadro a quadro, sem padrão curto)
+static uint16_t test_sample(int channel, uint32_t frame) {
+    return (uint16_t)((channel * 700 + frame * 13 + (frame * frame) % 97) % 4096);
+}
+
+// Confere uma amostra entregue com a média do seu período; devolve 1 se diferir
+static uint32_t check_sample(const adcmux_client_t *client, uint32_t index, uint16_t sample) {
+    uint32_t sum = 0;
+
+    for (uint32_t frame = index * client->stride; frame < (index + 1) * client->stride; frame++) {
+        sum += test_sample(client->channel, frame);
+    }
+
+    return sample != (sum + client->stride / 2) / client->stride;
+}
+
+// Lê a fila do cliente (amostra a amostra ou em blocos inteiros) conferindo cada amostra; devolve as diferentes
+static uint32_t read_client(adcmux_client_t *client, uint32_t block, uint32_t *delivered) {
+    uint32_t errors = 0;
+    uint16_t samples[256];
+
+    if (block) {
+        while (adcmux_available(client) >= block) {
+            uint32_t count = adcmux_read_block(client, samples, block);
+
+            for (uint32_t i = 0; i < count; i++) {
+                errors += check_sample(client, (*delivered)++, samples[i]);
+            }
+        }
+        return errors;
+    }
+    while (adcmux_read(client, &samples[0])) {
+        errors += check_sample(client, (*delivered)++, samples[0]);
+    }
+
+    return errors;
+}
+
+static bool run_case(const test_case_t *test) {
+    static adcmux_client_t clients[test_max_clients];
+    static uint16_t buffers[test_max_clients][4096];
+    uint32_t delivered[test_max_clients] = { 0 };
+    uint32_t value_errors = 0;
+    bool ok = true;
+
+    adcmux_host_reset();
+    for (int i = 0; i < test->count; i++) {
+        adcmux_add_client(&clients[i], test->clients[i].channel, test->clients[i].rate_hz, buffers[i],
+                          test->clients[i].size);
+    }
+    adcmux_start();
+
+    printf("%s: quadros %u/s, bloco %u\n", test->name, adcmux_stats.frame_rate, adcmux_stats.block_size);
+    ok = ok && adcmux_stats.frame_rate == test->frame_rate && adcmux_stats.block_size == test->block_size;
+
+    // Rodízio em ordem crescente dos canais pedidos
+    uint8_t order[adcmux_channels];
+    int channels = 0;
+    for (int channel = 0; channel < adcmux_channels; channel++) {
+        for (int i = 0; i < test->count; i++) {
+            if (test->clients[i].channel == channel) {
+                order[channels++] = (uint8_t)channel;
+                break;
+            }
+        }
+    }
+
+    uint32_t frames = adcmux_stats.frame_rate * test_seconds, total = frames * channels;
+    uint16_t *stream = malloc(total * sizeof(uint16_t));
+    for (uint32_t frame = 0; frame < frames; frame++) {
+        for (int k = 0; k < channels; k++) {
+            stream[frame * channels + k] = test_sample(order[k], frame);
+        }
+    }
+
+    srand(1);
+    for (uint32_t position = 0; position < total;) {
+        uint32_t length = 1 + rand() % 300;
+
+        if (length > total - position) {
+            length = total - position;
+        }
+        adcmux_demux(stream + position, length);
+        position += length;
+
+        for (int i = 0; i < test->count; i++) {
+            if (test->clients[i].drain) {
+                value_errors += read_client(&clients[i], test->clients[i].block, &delivered[i]);
+            }
+        }
+    }
+    free(stream);
+
+    // Fila nunca lida: ficam as mais antigas
+    for (int i = 0; i < test->count; i++) {
+        if (!test->clients[i].drain) {
+            value_errors += read_client(&clients[i], 0, &delivered[i]);
+        }
+    }
+
+    for (int i = 0; i < test->count; i++) {
+        const test_client_t *expect = &test->clients[i];
+        uint32_t rate = adcmux_client_rate(&clients[i]);
+        uint32_t produced_expected = frames / clients[i].stride;
+        uint32_t kept = produced_expected < expect->size ? produced_expected : expect->size;
+        uint32_t dropped_expected = expect->drain ? 0 : produced_expected - kept;
+        bool client_ok = rate == expect->expect_rate &&
+                         clients[i].produced == (expect->drain ? produced_expected : kept) &&
+                         clients[i].dropped == dropped_expected &&
+                         delivered[i] == (expect->drain ? produced_expected : kept);
+
+        printf("  canal %u: pedido %u/s, obtido %u/s (decimacao %u), entregues %u, descartados %u (esperados %u)%s\n",
+               expect->channel, expect->rate_hz, rate, clients[i].stride, clients[i].produced, clients[i].dropped,
+               dropped_expected, client_ok ? "" : "  <- ERRO");
+        ok = ok && client_ok;
+    }
+    printf("  amostras diferentes da media do periodo: %u\n", value_errors);
+
+    return ok && value_errors == 0;
+}
+
+int main(void) {
+    bool ok = true;
+
+    for (size_t i = 0; i < sizeof(test_cases) / sizeof(test_cases[0]); i++) {
+        ok = run_case(&test_cases[i]) && ok;
+    }
+    printf("%s\n", ok ? "OK" : "FALHOU");
+
+    return ok ? 0 : 1;
+}
@@ -7,63 +7,70 @@ Matrícula:20251RSE.MTC0017
 */
 #include <stdio.h>
 #include <stdlib.h>
+#include <string.h>
 #include "pico/stdlib.h"
-#include "hardware/adc.h"
 #include "hardware/timer.h"
-#include "hardware/pio.h"
-#include "ws2812.pio.h"
+#include "telemetry/telemetry.h"
+#include "streamstats/streamstats.h"
+#include "adcmux/adcmux.h"
+#include "envelope/envelope.h"
+#include "spectrum/spectrum.h"
+#include "goertzel/goertzel.h"
+#include "neopixel/neopixel.h"
+#include "hardware/clocks.h"
+#include "hardware/sync.h"
+#include "hardware/structs/systick.h"
 
 #define MIC_PIN 28        // GPIO28 (ADC2)
 #define NEOPIXEL_PIN 7    // GPIO7
-#define SAMPLE_RATE 10000 // 10ms
 #define NUM_LEDS 8        // Número de LEDs na matriz
-#define MAX_AMPLITUDE 3000 // Ajuste conforme necessidade 2000 -3000
-#define SOUND_THRESHOLD 800 //limiar de detecção de som
-#define GAIN 3.3f //fator de ganho (3.3 max) 
+#define BUTTON_A_PIN 5    // Botão A: alterna entre o nível do som e o espectro
+#define MAX_AMPLITUDE 24000 // Envoltória (Q15, depois do ganho) que acende todos os LEDs
+#define SOUND_THRESHOLD 6400 //limiar de detecção de som (Q15)
+#define GAIN_Q8 845 //fator de ganho em Q8 (3,3; 3.3 max)
+#define ENVELOPE_DC_CUTOFF_HZ 20 // Corte do passa-altas que remove a polarização do microfone
+#define ENVELOPE_ATTACK_US 1000  // Ataque da envoltória (1 ms)
+#define ENVELOPE_RELEASE_US 300000 // Liberação da envoltória (300 ms)
+#define TELEMETRY_BINARY 1 // 1: quadros binários (telemetry/telemetry_decode.cpp gera o CSV); 0: linhas de texto
+#define TELEMETRY_MIC 1    // Tipo do registro do microfone
+#define TELEMETRY_SPECTRUM 2 // Tipo do registro do espectro
+#define TELEMETRY_TONE 3   // Tipo do registro dos eventos de tom
+#define MIC_RATE_HZ 16000  // Amostras por segundo do microfone (48 MHz / 16000 = 3000 ciclos do ADC: taxa exata)
+#define MIC_BLOCK_SIZE 256 // Amostras processadas de cada vez (16 ms)
+#define MIC_BUFFER_SIZE 4096 // Fila do microfone no serviço do ADC (256 ms, potência de 2)
+#define MIC_STATS_PANE MIC_RATE_HZ // Amostras por painel das estatísticas (1 s)
+#define MIC_STATS_PANES 5  // Janela deslizante de 5 s
+#define MIC_STATS_P2_STRIDE 17 // Quantis: uma amostra a cada 17 entra no P² (primo: não acompanha a fase de um tom de 1 kHz)
+#define MIC_OFFSET 2048    // Nível de repouso nominal do microfone (meio da escala; o real é medido pela envoltória)
+#define SPECTRUM_POINTS 512 // FFT sobre os últimos 512 códigos (32 ms, janelas com 50% de sobreposição)
+#define SPECTRUM_LOW_HZ 100 // Início da primeira faixa (as 8 faixas vão até 8 kHz)
+#define SPECTRUM_DECAY_DB_S 20 // Queda do pico retido de cada faixa
+#define SPECTRUM_TOP_DB (-6)   // Nível (dB do fundo de escala) que acende um LED com o brilho máximo
+#define SPECTRUM_RANGE_DB 48   // Faixa de níveis mostrada: abaixo de SPECTRUM_TOP_DB - 48 dB o LED apaga
+#define MAINS_HZ 60         // Frequência da rede: o zumbido de máquinas fica nela e no dobro
+#define TONE_MIN_RMS 4      // Abaixo deste RMS (LSB) nenhum tom é detectado
+#define TONE_ON_RATIO_Q8 77 // Tom presente: 30% da energia na frequência (Q8)
+#define TONE_OFF_RATIO_Q8 38 // Tom ausente: menos de 15% (histerese)
+#define LED_MODE_BAR 0      // LEDs: barra com o nível do som
+#define LED_MODE_SPECTRUM 1 // LEDs: um por faixa do espectro
+#define UPDATE_MS 50       // Período de atualização dos LEDs e da telemetria
+#define ADC_REPORT_MS 5000 // Intervalo do relatório de vazão do ADC
 
 // Variáveis globais
-volatile uint16_t mic_raw = 0;
-volatile int16_t mic_amplitude = 0;
-float filtered_amplitude = 0;
-#define FILTER_ALPHA 0.7f  // Fator de suavizar sinal do microfone, reduzindo ruído
-
-PIO pio = pio0; //Seleciona o bloco PIO
-uint sm; //Guarda o número da máquina
-uint32_t led_colors[NUM_LEDS]; //Buffer que armazena as cores
-
-// Buffer para armazenar as cores dos LEDs (24 bits por LED)
-uint32_t led_colors[NUM_LEDS];
-
-// Inicializa o PIO e state machine para WS2812
-void neoPixel_init() {
-    uint offset = pio_add_program(pio, &ws2812_program);
-    if (offset == (uint)-1) {
-        printf("Erro: não foi possível adicionar o programa PIO\n");
-        return;
-    }
-    sm = pio_claim_unused_sm(pio, true);
-    if (sm == (uint)-1) {
-        printf("Erro: não foi possível alocar state machine\n");
-        return;
-    }
-    ws2812_program_init(pio, sm, offset, NEOPIXEL_PIN, 800000, false);
-    printf("PIO inicializado: offset=%u, sm=%u\n", offset, sm);
-}
-
-// Atualiza o buffer do LED na posição index com cor RGB
-void neoPixel_set_pixel_color(int index, uint8_t r, uint8_t g, uint8_t b) {
-    // WS2812 usa ordem GRB
-    led_colors[index] = ((uint32_t)g << 16) | ((uint32_t)r << 8) | b;
-}
-
-// Envia o buffer completo para a fita WS2812
-void neoPixel_show() {
-    for (int i = 0; i < NUM_LEDS; i++) {
-        pio_sm_put_blocking(pio, sm, led_colors[i] << 8u);
-    }
-    // Pequena pausa para garantir atualização (reset)
-    sleep_us(80);
-}
+uint16_t mic_raw = 0;
+envelope_t mic_envelope;   // Envoltória de pico e RMS do som (Q15), sem o nível DC
+uint32_t dsp_cycles = 0;   // Ciclos gastos pela envoltória desde o último relatório
+uint32_t dsp_samples = 0;  // Amostras processadas desde o último relatório
+spectrum_t mic_spectrum;   // Espectro do som em 8 faixas (modo LED_MODE_SPECTRUM)
+uint32_t fft_cycles = 0;   // Ciclos gastos pelo espectro desde o último relatório
+uint32_t fft_blocks = 0;   // Blocos analisados desde o último relatório
+goertzel_bank_t mic_tones; // Detectores de tons conhecidos (zumbido da rede, alarme, bipe do semáforo)
+uint32_t tone_cycles = 0;  // Ciclos gastos pelos detectores desde o último relatório
+char spectrum_fields[128]; // Campos do registro do espectro (com as frequências das faixas)
+int led_mode = LED_MODE_BAR;
+streamstats_t mic_stats;   // Estatísticas das amostras (sem filtro) nos últimos 5 s
+adcmux_client_t mic_client; // Canal do microfone no serviço do ADC
+uint16_t mic_buffer[MIC_BUFFER_SIZE];
 
 // Atualiza o buffer com gráfico de barras colorido e envia para a matrix
 void update_leds_bar(int amplitude) {
@@ -88,6 +95,9 @@ void update_leds_bar(int amplitude) {
                 uint8_t intensity = 30 + (i * 15);
                 neoPixel_set_pixel_color(i, intensity, intensity / 4, 0);
             }
+        } else if (NUM_LEDS - 1 - i < mic_tones.count && mic_tones.detectors[NUM_LEDS - 1 - i].active) {
+            // Tom detectado: os LEDs do fim da barra (um por detector) ficam azuis
+            neoPixel_set_pixel_color(i, 0, 0, 40);
         } else {
             // LEDs apagados
             neoPixel_set_pixel_color(i, 0, 0, 0);
@@ -95,6 +105,28 @@ void update_leds_bar(int amplitude) {
     }
     neoPixel_show();
 }
+// Mostra o espectro: cada LED é uma faixa (graves no primeiro), com o brilho pelo pico retido em dB
+// e a cor pela altura do nível (verde, amarelo, vermelho)
+void update_leds_spectrum() {
+    for (int i = 0; i < NUM_LEDS; i++) {
+        int32_t level = (mic_spectrum.hold_q8[i] >> spectrum_db_frac_bits) - (SPECTRUM_TOP_DB - SPECTRUM_RANGE_DB);
+        int32_t scaled = level <= 0 ? 0 : level >= SPECTRUM_RANGE_DB ? 255 : level * 255 / SPECTRUM_RANGE_DB;
+
+        if (scaled == 0) {
+            neoPixel_set_pixel_color(i, 0, 0, 0);
+        } else if (scaled < 85) {
+            neoPixel_set_pixel_color(i, 0, 4 + scaled / 3, 0);
+        } else if (scaled < 170) {
+            uint8_t intensity = 4 + scaled / 3;
+            neoPixel_set_pixel_color(i, intensity, intensity, 0);
+        } else {
+            uint8_t intensity = 4 + scaled / 2;
+            neoPixel_set_pixel_color(i, intensity, intensity / 4, 0);
+        }
+    }
+    neoPixel_show();
+}
+
 //test
 void test_leds() {
     for (int i = 0; i < NUM_LEDS; i++) {
@@ -108,51 +140,200 @@ void test_leds() {
 }
 
 
-// Timer callback para leitura do microfone
-bool timer_callback(repeating_timer_t *rt) {
-    mic_raw = adc_read();
-    mic_amplitude = mic_raw - 2048;
-    // Amplifica o sinal para compensar suavização
-    //float amplified = mic_amplitude * 2.0f;
-    
-    filtered_amplitude = FILTER_ALPHA * mic_amplitude + (1 - FILTER_ALPHA) * filtered_amplitude;
-    filtered_amplitude *= GAIN;  // Amplifica o sinal filtrado
-
-    // Limita para evitar overflow
-    if (filtered_amplitude > 32767) filtered_amplitude = 32767;
-    if (filtered_amplitude < -32768) filtered_amplitude = -32768;
-    return true;
+// Evento de um detector de tom (ligou ou desligou)
+void handle_tone_event(int index) {
+    const goertzel_detector_t *detector = &mic_tones.detectors[index];
+#if TELEMETRY_BINARY
+    int32_t values[] = { index, detector->frequency_hz, detector->active, (detector->ratio_q8 * 100) >> goertzel_ratio_bits };
+    telemetry_send(TELEMETRY_TONE, time_us_32(), values, count_of(values));
+#else
+    printf("Tom %s (%lu Hz): %s, razao %u%%\n", detector->name, detector->frequency_hz,
+           detector->active ? "presente" : "ausente", (detector->ratio_q8 * 100) >> goertzel_ratio_bits);
+#endif
+}
+
+// Processa um bloco de amostras do microfone (laço principal, sem interrupção por amostra)
+// - Estatísticas de todas as amostras (o desvio padrão é o nível RMS do som)
+// - Envoltória em ponto fixo, com o custo medido em ciclos pelo SysTick (contador decrescente de 24 bits)
+// - Detectores de tons (Goertzel), com os eventos tratados aqui mesmo
+// - No modo de espectro, FFT dos últimos SPECTRUM_POINTS códigos, também medida
+void process_mic_block(const uint16_t *samples, uint32_t count) {
+    streamstats_add_block(&mic_stats, samples, count);
+    mic_raw = samples[count - 1];
+
+    uint32_t start = systick_hw->cvr;
+    envelope_process(&mic_envelope, samples, count);
+    dsp_cycles += (start - systick_hw->cvr) & 0xFFFFFF;
+    dsp_samples += count;
+
+    start = systick_hw->cvr;
+    uint32_t changed = goertzel_bank_process(&mic_tones, samples, count);
+    tone_cycles += (start - systick_hw->cvr) & 0xFFFFFF;
+    for (int d = 0; changed; d++, changed >>= 1) {
+        if (changed & 1) {
+            handle_tone_event(d);
+        }
+    }
+
+    if (led_mode == LED_MODE_SPECTRUM) {
+        start = systick_hw->cvr;
+        spectrum_process(&mic_spectrum, samples, count);
+        fft_cycles += (start - systick_hw->cvr) & 0xFFFFFF;
+        fft_blocks++;
+    }
 }
 
+// O microfone é um cliente do serviço do ADC: conversões contínuas na taxa exata, entregues por DMA
+// em blocos (ping-pong); outros canais podem ser acrescentados sem disputa
 void microphone_init() {
-    adc_init();
-    adc_gpio_init(MIC_PIN);
-    adc_select_input(2);
+    envelope_init(&mic_envelope, MIC_RATE_HZ, ENVELOPE_DC_CUTOFF_HZ, ENVELOPE_ATTACK_US, ENVELOPE_RELEASE_US, GAIN_Q8);
+    spectrum_init(&mic_spectrum, MIC_RATE_HZ, SPECTRUM_POINTS, SPECTRUM_LOW_HZ, MIC_BLOCK_SIZE, SPECTRUM_DECAY_DB_S);
+
+    // Tons: o zumbido usa janelas de 64 ms (resolução de ~16 Hz, separa a rede do dobro) e precisa de
+    // 128 ms para ligar; alarme e bipe respondem em 32 a 48 ms. Desligam depois de 3 ou 4 janelas sem o tom
+    goertzel_bank_init(&mic_tones, MIC_RATE_HZ, MIC_BLOCK_SIZE, TONE_MIN_RMS);
+    goertzel_add(&mic_tones, "zumbido_rede", MAINS_HZ, 4, TONE_ON_RATIO_Q8, TONE_OFF_RATIO_Q8, 2, 3);
+    goertzel_add(&mic_tones, "zumbido_2x_rede", 2 * MAINS_HZ, 4, TONE_ON_RATIO_Q8, TONE_OFF_RATIO_Q8, 2, 3);
+    goertzel_add(&mic_tones, "alarme_3k1", 3100, 1, TONE_ON_RATIO_Q8, TONE_OFF_RATIO_Q8, 2, 4);
+    goertzel_add(&mic_tones, "bipe_4k", 4000, 1, TONE_ON_RATIO_Q8, TONE_OFF_RATIO_Q8, 3, 4); // buzzer_pwm_on(4000) do semáforo
+    systick_hw->rvr = 0xFFFFFF; // SysTick livre no clock do processador, para medir ciclos
+    systick_hw->csr = 0x5;
+    adcmux_add_client(&mic_client, MIC_PIN - 26, MIC_RATE_HZ, mic_buffer, MIC_BUFFER_SIZE);
+    adcmux_start();
 }
 
 void debug_microphone() {
-    printf("Filtrado: %.2f\n", filtered_amplitude);
+    // As estatísticas são das amostras brutas: média, extremos e quantis voltam a ser relativos ao repouso
+    streamstats_summary_t stats = { 0 };
+    streamstats_sliding(&mic_stats, &stats);
+    stats.moments.min -= MIC_OFFSET;
+    stats.moments.max -= MIC_OFFSET;
+    for (int q = 0; q < streamstats_quantiles; q++) {
+        stats.quantile_q8[q] -= MIC_OFFSET << 8;
+    }
+
+    int32_t mean = ((streamstats_mean_q8(&stats) - (MIC_OFFSET << 8)) * 100) >> 8;   // Centésimos de LSB
+    int32_t rms = (int32_t)((streamstats_stddev_q8(&stats) * 100) >> 8);
+    int32_t cycles = dsp_samples ? (int32_t)((uint64_t)dsp_cycles * 100 / dsp_samples) : 0; // Centésimos de ciclo
+    int32_t cycles_tones = dsp_samples ? (int32_t)((uint64_t)tone_cycles * 100 / dsp_samples) : 0;
+    dsp_cycles = 0;
+    tone_cycles = 0;
+    dsp_samples = 0;
+#if TELEMETRY_BINARY
+    // Envoltórias em centésimos de LSB (Q15 / 16), nível DC medido e custo da envoltória por amostra
+    int32_t values[] = {
+        (mic_envelope.peak * 100) >> 4, mic_raw,
+        mean, rms, stats.moments.min, stats.moments.max,
+        (stats.quantile_q8[0] * 100) >> 8, (stats.quantile_q8[1] * 100) >> 8, (stats.quantile_q8[2] * 100) >> 8,
+        (mic_envelope.rms * 100) >> 4, (envelope_dc_q8(&mic_envelope) * 100) >> 8, cycles, cycles_tones
+    };
+    telemetry_send(TELEMETRY_MIC, time_us_32(), values, count_of(values));
+#else
+    printf("Envoltoria: pico %d rms %d (Q15) dc %ld LSB %lu.%02lu ciclos/amostra (tons %lu.%02lu) | 5 s: rms %ld.%02ld min %ld max %ld\n",
+           mic_envelope.peak, mic_envelope.rms, envelope_dc_q8(&mic_envelope) >> 8, cycles / 100, cycles % 100,
+           cycles_tones / 100, cycles_tones % 100, rms / 100, rms % 100, stats.moments.min, stats.moments.max);
+#endif
+}
+
+// Níveis das faixas (pico retido, em centésimos de dB do fundo de escala), ciclos por bloco da FFT e
+// ocupação do núcleo (centésimos de %: ciclos do bloco sobre os ciclos de um período de bloco)
+void debug_spectrum() {
+    if (fft_blocks == 0) {
+        return;
+    }
+    uint32_t cycles = fft_cycles / fft_blocks;
+    uint32_t load = (uint32_t)((uint64_t)cycles * 10000 * MIC_RATE_HZ / ((uint64_t)clock_get_hz(clk_sys) * MIC_BLOCK_SIZE));
+    fft_cycles = 0;
+    fft_blocks = 0;
+#if TELEMETRY_BINARY
+    int32_t values[spectrum_bands + 2];
+    for (int band = 0; band < spectrum_bands; band++) {
+        values[band] = (mic_spectrum.hold_q8[band] * 100) >> spectrum_db_frac_bits;
+    }
+    values[spectrum_bands] = cycles;
+    values[spectrum_bands + 1] = load;
+    telemetry_send(TELEMETRY_SPECTRUM, time_us_32(), values, count_of(values));
+#else
+    printf("Espectro (dB):");
+    for (int band = 0; band < spectrum_bands; band++) {
+        printf(" %ld", (long)(mic_spectrum.hold_q8[band] >> spectrum_db_frac_bits));
+    }
+    printf(" | %lu ciclos/bloco, %lu.%02lu%% do nucleo\n", cycles, load / 100, load % 100);
+#endif
+}
+
+// Botão A (com pull-up): cada toque alterna o modo dos LEDs. Lido a cada UPDATE_MS, o que já filtra o repique
+void poll_button() {
+    static bool was_pressed = false;
+    bool pressed = !gpio_get(BUTTON_A_PIN);
+
+    if (pressed && !was_pressed) {
+        led_mode = led_mode == LED_MODE_BAR ? LED_MODE_SPECTRUM : LED_MODE_BAR;
+        printf("Modo dos LEDs: %s\n", led_mode == LED_MODE_BAR ? "nivel" : "espectro");
+    }
+    was_pressed = pressed;
 }
 
 int main() {
     stdio_init_all();
+#if TELEMETRY_BINARY
+    telemetry_define(TELEMETRY_MIC, "microfone", "filtrado:2,bruto,media_5s:2,rms_5s:2,min_5s,max_5s,p05_5s:2,p50_5s:2,p95_5s:2,"
+                     "envoltoria_rms:2,dc:2,ciclos_amostra:2,ciclos_tons:2");
+    telemetry_define(TELEMETRY_TONE, "tom", "detector,hz,presente,razao:2");
+#endif
+    streamstats_init(&mic_stats, MIC_STATS_PANE, MIC_STATS_PANES, MIC_STATS_P2_STRIDE);
     microphone_init();
-    neoPixel_init();
-
-    repeating_timer_t timer;
-    add_repeating_timer_ms(-10, timer_callback, NULL, &timer);
+    neoPixel_init(NEOPIXEL_PIN, NUM_LEDS);
+    gpio_init(BUTTON_A_PIN);
+    gpio_set_dir(BUTTON_A_PIN, GPIO_IN);
+    gpio_pull_up(BUTTON_A_PIN);
+#if TELEMETRY_BINARY
+    // Campos do espectro com a frequência inicial de cada faixa (hz100, hz187, ...)
+    int length = 0;
+    for (int band = 0; band < spectrum_bands; band++) {
+        length += snprintf(spectrum_fields + length, sizeof(spectrum_fields) - length, "hz%lu:2,",
+                           (unsigned long)spectrum_band_hz(&mic_spectrum, band));
+    }
+    snprintf(spectrum_fields + length, sizeof(spectrum_fields) - length, "ciclos_bloco,carga:2");
+    telemetry_define(TELEMETRY_SPECTRUM, "espectro", spectrum_fields);
+#endif
 
+    // Laço principal: processa os blocos completos do microfone, atualiza LEDs e telemetria a cada
+    // UPDATE_MS e dorme até a próxima interrupção (fim de bloco do DMA a cada ~2 ms)
+    uint32_t last_update_us = time_us_32(), last_report_us = last_update_us;
     while (1) {
-        int amplitude = abs((int)filtered_amplitude);
-        // Atualiza a matrix com o gráfico colorido
-        if (amplitude > SOUND_THRESHOLD) {
-            update_leds_bar(amplitude);  // Som detectado: atualiza LEDs
-        } else {
-            update_leds_bar(0);          // Som abaixo do limiar: apaga LEDs
+        uint16_t block[MIC_BLOCK_SIZE];
+
+        while (adcmux_available(&mic_client) >= MIC_BLOCK_SIZE) {
+            adcmux_read_block(&mic_client, block, MIC_BLOCK_SIZE);
+            process_mic_block(block, MIC_BLOCK_SIZE);
         }
-        
-        debug_microphone();
-        sleep_ms(50);
+
+        uint32_t now = time_us_32();
+        if (now - last_update_us >= UPDATE_MS * 1000) {
+            last_update_us += UPDATE_MS * 1000;
+
+            poll_button();
+
+            int amplitude = mic_envelope.peak;
+            // Atualiza a matrix com o gráfico colorido
+            if (led_mode == LED_MODE_SPECTRUM) {
+                update_leds_spectrum();      // Um LED por faixa do espectro
+                debug_spectrum();
+            } else if (amplitude > SOUND_THRESHOLD) {
+                update_leds_bar(amplitude);  // Som detectado: atualiza LEDs
+            } else {
+                update_leds_bar(0);          // Som abaixo do limiar: apaga LEDs
+            }
+
+            debug_microphone();
+        }
+        if (now - last_report_us >= ADC_REPORT_MS * 1000) {
+            last_report_us += ADC_REPORT_MS * 1000;
+            adcmux_report();
+        }
+
+        __wfi();
     }
 }
 
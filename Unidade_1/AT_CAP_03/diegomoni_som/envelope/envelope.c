@@ -0,0 +1,112 @@
+#include <assert.h>
+#include <string.h>
+#include "envelope.h"
+
+// Coeficiente (Q15) de um filtro de um polo com constante de tempo de time_us: ~1 / amostras da constante
+static int32_t envelope_coefficient(uint32_t sample_rate, uint32_t time_us) {
+    uint64_t samples_q8 = ((uint64_t)time_us * sample_rate << 8) / 1000000;
+
+    if (samples_q8 <= 256) {
+        return 1 << envelope_frac_bits; // Constante menor que uma amostra: segue o sinal
+    }
+
+    return (int32_t)(((1ULL << (envelope_frac_bits + 8)) + samples_q8 / 2) / samples_q8);
+}
+
+// Raiz quadrada inteira (arredondada para baixo), bit a bit
+static uint32_t envelope_isqrt(uint32_t value) {
+    uint32_t root = 0;
+    uint32_t bit = 1u << 30;
+
+    while (bit > value) {
+        bit >>= 2;
+    }
+    while (bit) {
+        if (value >= root + bit) {
+            value -= root + bit;
+            root = (root >> 1) + bit;
+        }
+        else {
+            root >>= 1;
+        }
+        bit >>= 2;
+    }
+
+    return root;
+}
+
+static int16_t envelope_saturate(int32_t value) {
+    return value > INT16_MAX ? INT16_MAX : value < INT16_MIN ? INT16_MIN : (int16_t)value;
+}
+
+void envelope_init(envelope_t *env, uint32_t sample_rate, uint32_t dc_cutoff_hz,
+                   uint32_t attack_us, uint32_t release_us, uint32_t gain_q8) {
+    assert(sample_rate > 0 && dc_cutoff_hz > 0 && dc_cutoff_hz < sample_rate / 8);
+
+    memset(env, 0, sizeof(*env));
+
+    // Corte de um polo: fc = fs / (2π * 2^n); escolhe o n mais próximo (fs / fc / 2π ~ fs * 163 / fc / 1024)
+    uint32_t samples = (uint32_t)(((uint64_t)sample_rate * 163 / 1024 + dc_cutoff_hz / 2) / dc_cutoff_hz);
+
+    env->dc_shift = 0;
+    while (env->dc_shift < 15 && (2u << env->dc_shift) <= samples + samples / 2) {
+        env->dc_shift++;
+    }
+    env->attack_q15 = envelope_coefficient(sample_rate, attack_us);
+    env->release_q15 = envelope_coefficient(sample_rate, release_us);
+    env->gain_q8 = gain_q8;
+}
+
+void envelope_process(envelope_t *env, const uint16_t *samples, uint32_t count) {
+    if (count == 0) {
+        return;
+    }
+    if (!env->primed) {
+        env->dc_q16 = (int32_t)samples[0] << 16;
+        env->primed = true;
+    }
+
+    int32_t dc = env->dc_q16;
+    int32_t peak = env->peak_q30;
+    const int32_t attack = env->attack_q15, release = env->release_q15;
+    const int dc_shift = env->dc_shift;
+    uint64_t sum_sq = 0;
+
+    for (uint32_t i = 0; i < count; i++) {
+        int32_t x = (int32_t)samples[i] << 16;
+
+        // Passa-altas: sinal menos o nível DC (passa-baixas de um polo)
+        dc += (x - dc) >> dc_shift;
+        int32_t y = (x - dc) >> 12; // LSB * 65536 -> LSB * 16 (Q15)
+
+        if (y > INT16_MAX) {
+            y = INT16_MAX;
+        }
+        else if (y < -INT16_MAX) {
+            y = -INT16_MAX;
+        }
+        sum_sq += (uint32_t)(y * y);
+
+        // Retificação e envoltória de pico: ataque quando o sinal passa a envoltória, liberação quando fica abaixo
+        int32_t error = ((y < 0 ? -y : y) << envelope_frac_bits) - peak;
+
+        peak += (error >> envelope_frac_bits) * (error > 0 ? attack : release);
+    }
+
+    env->dc_q16 = dc;
+    env->peak_q30 = peak;
+
+    // Envoltória RMS: a média quadrática do bloco entra com o coeficiente do bloco (count vezes o da amostra)
+    uint32_t block_ms = (uint32_t)(sum_sq / count);
+    int64_t error = (int64_t)block_ms - env->ms_q30;
+    int64_t coefficient = (int64_t)(error > 0 ? attack : release) * count;
+
+    if (coefficient > (1 << envelope_frac_bits)) {
+        coefficient = 1 << envelope_frac_bits;
+    }
+    env->ms_q30 = (uint32_t)(env->ms_q30 + ((error * coefficient) >> envelope_frac_bits));
+
+    // Estágio de ganho único, com saturação
+    env->peak = envelope_saturate((int32_t)(((int64_t)(peak >> envelope_frac_bits) * env->gain_q8) >> envelope_gain_frac_bits));
+    env->rms = envelope_saturate((int32_t)(((int64_t)envelope_isqrt(env->ms_q30) * env->gain_q8) >> envelope_gain_frac_bits));
+}
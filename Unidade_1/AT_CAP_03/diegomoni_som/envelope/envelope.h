@@ -0,0 +1,44 @@
+#include <stdint.h>
+#include <stdbool.h>
+
+#ifndef envelope_inc_h
+#define envelope_inc_h
+
+// Detector de envoltória do microfone em ponto fixo (Q15: 1,0 = 2048 LSB do ADC), processado em blocos.
+// Por amostra: passa-altas de um polo que remove o nível DC (a polarização real do microfone, não 2048),
+// retificação e envoltória de pico com constantes de ataque e de liberação separadas.
+// Por bloco: média quadrática suavizada com as mesmas constantes (envoltória RMS) e um único estágio
+// de ganho com saturação nas saídas. Só somas, deslocamentos e multiplicações de 32 bits por amostra;
+// compila também no computador (envelope_wav.c processa arquivos WAV gravados)
+
+#define envelope_frac_bits 15
+#define envelope_gain_frac_bits 8 // Ganho em Q8 (256 = 1,0)
+
+typedef struct {
+    uint8_t dc_shift;       // Passa-altas: o nível DC segue o sinal com constante de 2^dc_shift amostras
+    bool primed;            // Nível DC já iniciado pela primeira amostra
+    int32_t dc_q16;         // Nível DC em LSB * 65536
+    int32_t attack_q15;     // Coeficientes por amostra (fração do erro corrigida a cada amostra)
+    int32_t release_q15;
+    int32_t peak_q30;       // Envoltória de pico (Q15 << 15)
+    uint32_t ms_q30;        // Média quadrática suavizada (Q30)
+    uint32_t gain_q8;
+
+    // Saídas do último bloco, depois do ganho (Q15, saturadas)
+    int16_t peak;
+    int16_t rms;
+} envelope_t;
+
+// sample_rate em Hz; corte do passa-altas em Hz (arredondado para 2^n amostras); ataque e liberação em µs
+void envelope_init(envelope_t *env, uint32_t sample_rate, uint32_t dc_cutoff_hz,
+                   uint32_t attack_us, uint32_t release_us, uint32_t gain_q8);
+
+// Processa um bloco de códigos do ADC (12 bits) e atualiza peak e rms
+void envelope_process(envelope_t *env, const uint16_t *samples, uint32_t count);
+
+// Nível DC atual em LSB com 8 bits de fração
+static inline int32_t envelope_dc_q8(const envelope_t *env) {
+    return env->dc_q16 >> 8;
+}
+
+#endif
@@ -0,0 +1,142 @@
+// Executa a envoltória do microfone (envelope.c) sobre um arquivo WAV gravado, no computador.
+// As amostras (PCM de 8 ou 16 bits, primeiro canal) viram códigos de 12 bits como os do ADC, com a
+// polarização escolhida, e passam pelo mesmo código da placa em blocos; a saída é um CSV por bloco:
+//   tempo_s,pico,rms,dc
+// com as envoltórias em LSB (depois do ganho) e o nível DC medido em LSB. O tempo de processamento
+// por amostra vai para a saída de erros.
+//
+// Compilação: gcc -std=c11 -O2 -o envelope_wav envelope_wav.c envelope.c
+// Uso:        envelope_wav arquivo.wav [-b polarizacao_lsb] [-g ganho_q8] [-a ataque_us] [-r liberacao_us]
+//                          [-c corte_hz] [-n bloco] > saida.csv
+
+#define _POSIX_C_SOURCE 199309L
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include "envelope.h"
+
+#define envelope_wav_max_block 4096
+
+static uint32_t read_le(const uint8_t *bytes, int count) {
+    uint32_t value = 0;
+
+    for (int i = count - 1; i >= 0; i--) {
+        value = (value << 8) | bytes[i];
+    }
+
+    return value;
+}
+
+int main(int argc, char **argv) {
+    const char *path = NULL;
+    int32_t bias = 2048;
+    uint32_t gain_q8 = 256, attack_us = 1000, release_us = 300000, cutoff_hz = 20, block_size = 256;
+
+    for (int i = 1; i < argc; i++) {
+        if (argv[i][0] == '-' && i + 1 < argc) {
+            uint32_t value = (uint32_t)strtoul(argv[i + 1], NULL, 10);
+
+            switch (argv[i][1]) {
+            case 'b': bias = (int32_t)value; break;
+            case 'g': gain_q8 = value; break;
+            case 'a': attack_us = value; break;
+            case 'r': release_us = value; break;
+            case 'c': cutoff_hz = value; break;
+            case 'n': block_size = value; break;
+            default:
+                fprintf(stderr, "opcao desconhecida: %s\n", argv[i]);
+                return 2;
+            }
+            i++;
+        }
+        else {
+            path = argv[i];
+        }
+    }
+    if (!path || block_size == 0 || block_size > envelope_wav_max_block) {
+        fprintf(stderr, "uso: %s arquivo.wav [-b polarizacao_lsb] [-g ganho_q8] [-a ataque_us] [-r liberacao_us] [-c corte_hz] [-n bloco]\n", argv[0]);
+        return 2;
+    }
+
+    FILE *file = fopen(path, "rb");
+    uint8_t header[12], chunk[8];
+
+    if (!file || fread(header, 1, 12, file) != 12 || memcmp(header, "RIFF", 4) || memcmp(header + 8, "WAVE", 4)) {
+        fprintf(stderr, "%s: nao e um arquivo WAV\n", path);
+        return 1;
+    }
+
+    // Procura os blocos "fmt " e "data"
+    uint32_t rate = 0, channels = 0, bits = 0, data_size = 0;
+    while (fread(chunk, 1, 8, file) == 8) {
+        uint32_t size = read_le(chunk + 4, 4);
+
+        if (!memcmp(chunk, "fmt ", 4)) {
+            uint8_t format[16];
+
+            if (size < 16 || fread(format, 1, 16, file) != 16 || read_le(format, 2) != 1) {
+                fprintf(stderr, "%s: so PCM e suportado\n", path);
+                return 1;
+            }
+            channels = read_le(format + 2, 2);
+            rate = read_le(format + 4, 4);
+            bits = read_le(format + 14, 2);
+            fseek(file, size - 16 + (size & 1), SEEK_CUR);
+        }
+        else if (!memcmp(chunk, "data", 4)) {
+            data_size = size;
+            break;
+        }
+        else {
+            fseek(file, size + (size & 1), SEEK_CUR);
+        }
+    }
+    if (!rate || !channels || (bits != 8 && bits != 16) || !data_size) {
+        fprintf(stderr, "%s: formato nao suportado (PCM de 8 ou 16 bits)\n", path);
+        return 1;
+    }
+
+    envelope_t env;
+    envelope_init(&env, rate, cutoff_hz, attack_us, release_us, gain_q8);
+
+    uint32_t frame_bytes = channels * bits / 8;
+    uint32_t frames = data_size / frame_bytes;
+    uint8_t *frame = malloc(frame_bytes);
+    uint16_t block[envelope_wav_max_block];
+    uint32_t done = 0;
+    double seconds = 0;
+
+    printf("tempo_s,pico,rms,dc\n");
+    while (done < frames) {
+        uint32_t count = 0;
+
+        // Amostra de 16 bits -> 12 bits com sinal, somada à polarização (como o ADC veria o microfone)
+        while (count < block_size && done + count < frames && fread(frame, 1, frame_bytes, file) == frame_bytes) {
+            int32_t value = bits == 16 ? (int16_t)read_le(frame, 2) : ((int32_t)frame[0] - 128) << 8;
+            int32_t code = bias + (value >> 4);
+
+            block[count++] = (uint16_t)(code < 0 ? 0 : code > 4095 ? 4095 : code);
+        }
+        if (count == 0) {
+            break;
+        }
+
+        struct timespec start, end;
+        clock_gettime(CLOCK_MONOTONIC, &start);
+        envelope_process(&env, block, count);
+        clock_gettime(CLOCK_MONOTONIC, &end);
+        seconds += (end.tv_sec - start.tv_sec) + (end.tv_nsec - start.tv_nsec) * 1e-9;
+
+        done += count;
+        printf("%.4f,%.2f,%.2f,%.2f\n", (double)done / rate, env.peak / 16.0, env.rms / 16.0, envelope_dc_q8(&env) / 256.0);
+    }
+
+    fprintf(stderr, "%lu amostras a %lu Hz, corte %lu Hz (2^%u amostras), ataque %ld/32768, liberacao %ld/32768: %.1f ns por amostra\n",
+            (unsigned long)done, (unsigned long)rate, (unsigned long)cutoff_hz, env.dc_shift,
+            (long)env.attack_q15, (long)env.release_q15, done ? seconds * 1e9 / done : 0.0);
+    free(frame);
+    fclose(file);
+
+    return 0;
+}
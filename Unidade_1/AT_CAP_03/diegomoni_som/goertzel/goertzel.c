@@ -0,0 +1,132 @@
+#include <assert.h>
+#include <math.h>
+#include <string.h>
+#include "goertzel.h"
+
+#define goertzel_max_block 1024
+#define goertzel_max_state (1 << 29) // Limite do estado para a multiplicação em duas partes
+#define goertzel_pi 3.14159265358979323846
+
+// (s * c) >> 14 só com multiplicações de 32 bits (uma instrução no RP2040), para |s| < 2^29 e |c| < 2^15:
+// parte alta e parte baixa de s multiplicadas separadamente
+static inline int32_t goertzel_mul_q14(int32_t s, int32_t c) {
+    int32_t high = s >> 16;
+    int32_t low = s & 0xFFFF;
+
+    return high * c * (1 << (16 - goertzel_coefficient_bits)) + ((low * c) >> goertzel_coefficient_bits);
+}
+
+void goertzel_bank_init(goertzel_bank_t *bank, uint32_t sample_rate, uint32_t block_size, uint32_t min_rms) {
+    assert(sample_rate > 0 && block_size > 0 && block_size <= goertzel_max_block);
+
+    memset(bank, 0, sizeof(*bank));
+    bank->sample_rate = sample_rate;
+    bank->block_size = block_size;
+    bank->min_rms = min_rms;
+}
+
+int goertzel_add(goertzel_bank_t *bank, const char *name, uint32_t frequency_hz, uint32_t window_blocks,
+                 uint32_t on_ratio_q8, uint32_t off_ratio_q8, uint32_t on_windows, uint32_t off_windows) {
+    assert(bank->count < goertzel_max_detectors);
+    assert(frequency_hz > 0 && frequency_hz < bank->sample_rate / 2 && window_blocks > 0 && window_blocks < 0x10000);
+    assert(off_ratio_q8 <= on_ratio_q8 && on_ratio_q8 <= 0xFFFF && on_windows > 0 && off_windows > 0);
+
+    goertzel_detector_t *detector = &bank->detectors[bank->count];
+    double omega = 2.0 * goertzel_pi * frequency_hz / bank->sample_rate;
+    int32_t coefficient = (int32_t)lround(2.0 * cos(omega) * (1 << goertzel_coefficient_bits));
+
+    // O estado cresce até ~ amostras * amplitude / sen(ω): frequências muito perto de 0 ou de fs/2 com
+    // janelas longas não cabem
+    assert((double)window_blocks * bank->block_size * 2048 / fabs(sin(omega)) < goertzel_max_state);
+
+    memset(detector, 0, sizeof(*detector));
+    detector->name = name;
+    detector->frequency_hz = frequency_hz;
+    detector->coefficient_q14 = coefficient > INT16_MAX ? INT16_MAX : coefficient < -INT16_MAX ? -INT16_MAX : coefficient;
+    detector->window_blocks = (uint16_t)window_blocks;
+    detector->on_ratio_q8 = (uint16_t)on_ratio_q8;
+    detector->off_ratio_q8 = (uint16_t)off_ratio_q8;
+    detector->on_windows = (uint8_t)on_windows;
+    detector->off_windows = (uint8_t)off_windows;
+
+    return bank->count++;
+}
+
+// Fim de uma janela: razão entre a potência do tom e a energia da janela, e decisão com histerese.
+// Para uma senoide de amplitude A na frequência: |X|² = (A N / 2)² e energia = N A² / 2, então
+// 2 |X|² / (N * energia) = 1
+static bool goertzel_decide(goertzel_detector_t *detector, uint32_t samples, uint32_t min_rms) {
+    int64_t s1 = detector->s1, s2 = detector->s2;
+    int64_t power = s1 * s1 + s2 * s2 - s1 * goertzel_mul_q14(detector->s2, detector->coefficient_q14);
+    uint64_t scale = ((uint64_t)samples * detector->energy) >> (goertzel_ratio_bits + 1);
+    uint64_t ratio = 0;
+
+    if (detector->energy >= (uint64_t)min_rms * min_rms * samples && scale > 0 && power > 0) {
+        ratio = (uint64_t)power / scale;
+    }
+    detector->ratio_q8 = (uint16_t)(ratio > 0xFFFF ? 0xFFFF : ratio);
+    detector->s1 = 0;
+    detector->s2 = 0;
+    detector->energy = 0;
+    detector->blocks = 0;
+
+    // Conta as janelas seguidas do lado oposto ao estado atual
+    bool opposite = detector->active ? detector->ratio_q8 < detector->off_ratio_q8 : detector->ratio_q8 >= detector->on_ratio_q8;
+
+    detector->streak = opposite ? detector->streak + 1 : 0;
+    if (detector->streak < (detector->active ? detector->off_windows : detector->on_windows)) {
+        return false;
+    }
+    detector->active = !detector->active;
+    detector->streak = 0;
+
+    return true;
+}
+
+uint32_t goertzel_bank_process(goertzel_bank_t *bank, const uint16_t *samples, uint32_t count) {
+    assert(count == bank->block_size);
+
+    if (!bank->primed) {
+        bank->dc_q8 = (int32_t)samples[0] << 8;
+        bank->primed = true;
+    }
+
+    // Amostras sem o nível DC (em LSB) e energia do bloco, comuns a todos os detectores
+    int16_t centered[goertzel_max_block];
+    uint64_t energy = 0;
+    uint32_t sum = 0;
+
+    for (uint32_t i = 0; i < count; i++) {
+        int32_t x = (((int32_t)samples[i] << 8) - bank->dc_q8 + 128) >> 8;
+
+        centered[i] = (int16_t)x;
+        energy += (uint32_t)(x * x);
+        sum += samples[i];
+    }
+    int32_t mean_q8 = (int32_t)(((uint64_t)sum << 8) / count);
+    bank->dc_q8 += (mean_q8 - bank->dc_q8) >> goertzel_dc_shift;
+
+    uint32_t changed = 0;
+    for (int d = 0; d < bank->count; d++) {
+        goertzel_detector_t *detector = &bank->detectors[d];
+        int32_t s1 = detector->s1, s2 = detector->s2;
+        const int32_t coefficient = detector->coefficient_q14;
+
+        // s[n] = x[n] + 2 cos(ω) s[n-1] - s[n-2]
+        for (uint32_t i = 0; i < count; i++) {
+            int32_t s0 = centered[i] + goertzel_mul_q14(s1, coefficient) - s2;
+
+            s2 = s1;
+            s1 = s0;
+        }
+        detector->s1 = s1;
+        detector->s2 = s2;
+        detector->energy += energy;
+
+        if (++detector->blocks >= detector->window_blocks && goertzel_decide(detector, detector->window_blocks * count, bank->min_rms)) {
+            changed |= 1u << d;
+        }
+    }
+
+    return changed;
+}
@@ -0,0 +1,64 @@
+#include <stdint.h>
+#include <stdbool.h>
+
+#ifndef goertzel_inc_h
+#define goertzel_inc_h
+
+// Banco de detectores de tons por Goertzel em ponto fixo: cada detector mede a potência de uma única
+// frequência (qualquer, não só as raias de uma FFT) sobre uma janela de window_blocks blocos do ADC.
+// A decisão usa a razão entre a potência do tom e a energia total da janela (1,0 = senoide pura na
+// frequência), o que não depende do volume, com histerese em dois sentidos:
+//   nível: liga com razão >= on_ratio, desliga com razão < off_ratio (off_ratio < on_ratio)
+//   tempo: on_windows janelas seguidas acima para ligar, off_windows abaixo para desligar
+// Janelas com RMS abaixo de min_rms contam como sem tom (silêncio não liga nada).
+// Por amostra e detector: uma iteração com duas multiplicações de 32 bits; a energia é somada uma vez
+// por bloco para todos. Custa uma fração da FFT quando se quer saber de poucos tons conhecidos
+
+#define goertzel_max_detectors 8
+#define goertzel_coefficient_bits 14 // Coeficiente 2 cos(ω) em Q14
+#define goertzel_ratio_bits 8        // Razões em Q8 (256 = 1,0)
+#define goertzel_dc_shift 3          // Nível DC: média dos blocos suavizada com constante de 8 blocos
+
+typedef struct {
+    const char *name;
+    uint32_t frequency_hz;
+    int32_t coefficient_q14;
+    uint16_t window_blocks;
+    uint16_t on_ratio_q8, off_ratio_q8;
+    uint8_t on_windows, off_windows;
+
+    // Estado da janela em formação
+    int32_t s1, s2;
+    uint64_t energy;
+    uint16_t blocks;
+
+    // Última janela completa e decisão
+    uint16_t ratio_q8;
+    uint8_t streak;  // Janelas seguidas do lado oposto ao estado atual
+    bool active;
+} goertzel_detector_t;
+
+typedef struct {
+    uint32_t sample_rate;
+    uint32_t block_size;
+    uint32_t min_rms;
+    bool primed;
+    int32_t dc_q8;  // Nível DC (LSB * 256), subtraído das amostras
+    int count;
+    goertzel_detector_t detectors[goertzel_max_detectors];
+} goertzel_bank_t;
+
+// block_size: amostras entregues por chamada de goertzel_bank_process; min_rms em LSB
+void goertzel_bank_init(goertzel_bank_t *bank, uint32_t sample_rate, uint32_t block_size, uint32_t min_rms);
+
+// Acrescenta um detector e devolve o seu índice. A resolução em frequência é de cerca de
+// sample_rate / (window_blocks * block_size): janelas longas separam tons próximos (60 e 120 Hz),
+// janelas curtas respondem mais rápido (bipes)
+int goertzel_add(goertzel_bank_t *bank, const char *name, uint32_t frequency_hz, uint32_t window_blocks,
+                 uint32_t on_ratio_q8, uint32_t off_ratio_q8, uint32_t on_windows, uint32_t off_windows);
+
+// Processa um bloco de códigos do ADC (12 bits, block_size amostras); devolve a máscara dos detectores
+// que mudaram de estado (bit i: detector i ligou ou desligou, ver active)
+uint32_t goertzel_bank_process(goertzel_bank_t *bank, const uint16_t *samples, uint32_t count);
+
+#endif
@@ -0,0 +1,201 @@
+// Confere e mede o banco de detectores de tons (goertzel.c) no computador, com o banco configurado como em
+// diegomoni_som.c (60 e 120 Hz em janelas de 4 blocos, 3,1 kHz e 4 kHz em janelas de 1 bloco, 16 kHz).
+// Conferência:
+//   - Tons puros: cada tom liga só o seu detector (razão perto de 1,0, os outros perto de 0); 1 kHz não liga nenhum.
+//   - Ruído: silêncio (3 LSB) e ruído forte de banda larga não geram eventos.
+//   - Histerese: bipe de 4 kHz (200 ms ligado, 300 ms desligado) sobre um tom de 1 kHz e ruído gera um
+//     evento "liga" e um "desliga" por bipe, alternados, com atraso de on_windows/off_windows janelas.
+//   - Precisão: a razão em ponto fixo contra o Goertzel em precisão dupla das mesmas amostras.
+// Falha (código de saída 1) se alguma conferência não passar.
+// Medida: tempo do banco por bloco contra o do analisador de espectro (FFT de 512 pontos, spectrum.c).
+//
+// Compilação: gcc -std=c11 -O2 -o goertzel_test goertzel_test.c goertzel.c ../spectrum/spectrum.c -lm
+// Uso:        goertzel_test [-i repeticoes]
+
+#define _POSIX_C_SOURCE 199309L
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include <time.h>
+#include "goertzel.h"
+#include "../spectrum/spectrum.h"
+
+#define test_rate 16000
+#define test_block 256
+#define test_dc 1900
+#define test_pi 3.14159265358979323846
+#define test_beep_detector 3
+
+static double now_seconds(void) {
+    struct timespec time;
+
+    clock_gettime(CLOCK_MONOTONIC, &time);
+    return time.tv_sec + time.tv_nsec * 1e-9;
+}
+
+static double test_noise(void) {
+    return (rand() / (double)RAND_MAX - 0.5) * 2;
+}
+
+// Bloco de códigos do ADC a partir da amostra start: nível DC, tons e ruído uniforme de amplitude noise
+static void test_block_samples(uint16_t *codes, long start, const double *frequency, const double *amplitude,
+                               int tones, double noise) {
+    for (int i = 0; i < test_block; i++) {
+        double value = test_dc + noise * test_noise();
+
+        for (int k = 0; k < tones; k++) {
+            value += amplitude[k] * sin(2 * test_pi * frequency[k] * (start + i) / test_rate);
+        }
+        codes[i] = value < 0 ? 0 : value > 4095 ? 4095 : (uint16_t)lround(value);
+    }
+}
+
+// Mesmo banco de diegomoni_som.c
+static void test_bank(goertzel_bank_t *bank) {
+    goertzel_bank_init(bank, test_rate, test_block, 4);
+    goertzel_add(bank, "zumbido_rede", 60, 4, 77, 38, 2, 3);
+    goertzel_add(bank, "zumbido_2x_rede", 120, 4, 77, 38, 2, 3);
+    goertzel_add(bank, "alarme_3k1", 3100, 1, 77, 38, 2, 4);
+    goertzel_add(bank, "bipe_4k", 4000, 1, 77, 38, 3, 4);
+}
+
+int main(int argc, char **argv) {
+    uint32_t iterations = 20000;
+
+    if (argc == 3 && !strcmp(argv[1], "-i")) {
+        iterations = (uint32_t)strtoul(argv[2], NULL, 10);
+    }
+    else if (argc != 1) {
+        fprintf(stderr, "uso: %s [-i repeticoes]\n", argv[0]);
+        return 2;
+    }
+
+    static goertzel_bank_t bank;
+    uint16_t codes[test_block];
+    bool ok = true;
+
+    srand(1);
+
+    // Tons puros: 300 LSB de amplitude, 16 blocos (4 janelas dos detectores lentos)
+    const double tones[] = { 60, 120, 3100, 4000, 1000 };
+    for (int t = 0; t < 5; t++) {
+        double amplitude = 300;
+        bool tone_ok = true;
+
+        test_bank(&bank);
+        for (int b = 0; b < 16; b++) {
+            test_block_samples(codes, (long)b * test_block, &tones[t], &amplitude, 1, 3);
+            goertzel_bank_process(&bank, codes, test_block);
+        }
+        printf("tom %5.0f Hz: razoes", tones[t]);
+        for (int d = 0; d < bank.count; d++) {
+            const goertzel_detector_t *detector = &bank.detectors[d];
+            bool own = detector->frequency_hz == tones[t];
+
+            printf(" %s=%.3f%s", detector->name, detector->ratio_q8 / 256.0, detector->active ? "*" : "");
+            tone_ok = tone_ok && detector->active == own && (own ? detector->ratio_q8 >= 230 : detector->ratio_q8 < 13);
+        }
+        printf("%s\n", tone_ok ? "" : "  <- ERRO");
+        ok = ok && tone_ok;
+    }
+
+    // Ruído sem tom: fraco e forte
+    const double noises[] = { 3, 800 };
+    for (int n = 0; n < 2; n++) {
+        int events = 0;
+
+        test_bank(&bank);
+        for (int b = 0; b < 200; b++) {
+            test_block_samples(codes, (long)b * test_block, NULL, NULL, 0, noises[n]);
+            events += __builtin_popcount(goertzel_bank_process(&bank, codes, test_block));
+        }
+        printf("ruido de %.0f LSB: %d eventos\n", noises[n], events);
+        ok = ok && events == 0;
+    }
+
+    // Bipes: cada evento do detector de 4 kHz deve alternar e vir logo depois da borda do bipe
+    // (ligar: on_windows janelas de 16 ms; desligar: off_windows; mais uma janela de folga para a borda)
+    const double block_ms = test_block * 1000.0 / test_rate;
+    int beep_events = 0, beep_errors = 0;
+    bool expect_on = true;
+
+    test_bank(&bank);
+    printf("bipes:");
+    for (int b = 0; b < 200; b++) {
+        double start_ms = b * block_ms, end_ms = start_ms + block_ms;
+        double frequency[2] = { 4000, 1000 }, amplitude[2] = { fmod(start_ms, 500) < 200 ? 200 : 0, 150 };
+
+        test_block_samples(codes, (long)b * test_block, frequency, amplitude, 2, 20);
+        if (!(goertzel_bank_process(&bank, codes, test_block) & (1u << test_beep_detector))) {
+            continue;
+        }
+
+        const goertzel_detector_t *detector = &bank.detectors[test_beep_detector];
+        double edge_ms = floor(start_ms / 500) * 500 + (detector->active ? 0 : 200);
+        double delay_ms = end_ms - edge_ms;
+        int windows = detector->active ? detector->on_windows : detector->off_windows;
+
+        printf(" %s@%.0fms", detector->active ? "liga" : "desliga", end_ms);
+        beep_events++;
+        beep_errors += detector->active != expect_on || delay_ms < windows * block_ms ||
+                       delay_ms > (windows + 1) * block_ms;
+        expect_on = !detector->active;
+    }
+    printf("\n  %d eventos, %d fora de ordem ou do atraso esperado\n", beep_events, beep_errors);
+    ok = ok && beep_errors == 0 && beep_events == 13; // 7 bipes em 3,2 s; o último ainda ligado
+
+    // Precisão: razão do detector de 4 kHz contra o Goertzel em precisão dupla, com o nível DC já estimado
+    double worst = 0;
+    srand(3);
+    for (int trial = 0; trial < 300; trial++) {
+        double frequency = 4000 + test_noise() * 60, amplitude = 20 + fabs(test_noise()) * 1500;
+        double coefficient = 2 * cos(2 * test_pi * 4000.0 / test_rate), s1 = 0, s2 = 0, energy = 0;
+
+        test_bank(&bank);
+        bank.primed = true;
+        bank.dc_q8 = test_dc << 8;
+        test_block_samples(codes, test_block, &frequency, &amplitude, 1, 5);
+        goertzel_bank_process(&bank, codes, test_block);
+
+        for (int i = 0; i < test_block; i++) {
+            double x = codes[i] - (double)test_dc, s0 = x + coefficient * s1 - s2;
+
+            s2 = s1;
+            s1 = s0;
+            energy += x * x;
+        }
+
+        double power = s1 * s1 + s2 * s2 - coefficient * s1 * s2;
+        worst = fmax(worst, fabs(bank.detectors[test_beep_detector].ratio_q8 / 256.0 - 2 * power / (test_block * energy)));
+    }
+    printf("razao em ponto fixo contra precisao dupla: erro max %.4f (limite %.4f)\n", worst, 2.0 / 256);
+    ok = ok && worst <= 2.0 / 256;
+
+    // Medida: o banco de 4 detectores contra o espectro de 512 pontos, no mesmo bloco
+    static spectrum_t spectrum;
+    double frequency = 1000, amplitude = 500;
+    volatile uint32_t sink = 0;
+
+    spectrum_init(&spectrum, test_rate, 512, 100, test_block, 20);
+    test_bank(&bank);
+    test_block_samples(codes, 0, &frequency, &amplitude, 1, 3);
+
+    double start = now_seconds();
+    for (uint32_t i = 0; i < iterations; i++) {
+        sink += goertzel_bank_process(&bank, codes, test_block);
+    }
+    double bank_ns = (now_seconds() - start) * 1e9 / iterations;
+
+    start = now_seconds();
+    for (uint32_t i = 0; i < iterations; i++) {
+        spectrum_process(&spectrum, codes, test_block);
+    }
+    double spectrum_ns = (now_seconds() - start) * 1e9 / iterations;
+
+    printf("por bloco de %d: banco de %d detectores %.0f ns, espectro de 512 pontos %.0f ns (%.0f%%)\n",
+           test_block, bank.count, bank_ns, spectrum_ns, 100 * bank_ns / spectrum_ns);
+    printf("%s (%u)\n", ok ? "OK" : "FALHOU", sink & 1);
+
+    return ok ? 0 : 1;
+}
@@ -0,0 +1,126 @@
+#include <stdio.h>
+#include <string.h>
+#include <assert.h>
+#ifdef NEOPIXEL_HOST
+// No computador (neopixel_test.c): só os buffers e o encadeamento dos quadros, sem PIO, DMA nem alarme
+#define save_and_disable_interrupts() 0u
+#define restore_interrupts(status) ((void)(status))
+#else
+#include "pico/stdlib.h"
+#include "hardware/pio.h"
+#include "hardware/dma.h"
+#include "hardware/timer.h"
+#include "hardware/sync.h"
+#include "ws2812.pio.h"
+#endif
+#include "neopixel.h"
+
+static uint32_t neopixel_buffers[2][neopixel_max_leds];
+static uint32_t *volatile neopixel_colors = neopixel_buffers[0]; // Buffer de trás
+static int neopixel_count;
+static uint32_t neopixel_period_us;              // Quadro + folga + reset
+static volatile bool neopixel_busy = false;     // Quadro saindo ou reset ainda não cumprido
+static volatile bool neopixel_pending = false;  // neoPixel_show() chamado durante um quadro
+
+#ifndef NEOPIXEL_HOST
+static PIO neopixel_pio = pio0;
+static int neopixel_dma_chan; // Canal de DMA para a FIFO de transmissão do PIO
+static int neopixel_alarm;    // Alarme do timer que marca o fim do quadro e do reset
+#endif
+
+// Troca os buffers e envia o quadro preparado; o de trás recebe uma cópia dele. Chamada com o envio
+// parado (neopixel_busy falso)
+static void neopixel_start_frame(void) {
+    uint32_t *front = neopixel_colors;
+    uint32_t *back = front == neopixel_buffers[0] ? neopixel_buffers[1] : neopixel_buffers[0];
+
+    memcpy(back, front, neopixel_count * sizeof(uint32_t));
+    neopixel_colors = back;
+    neopixel_busy = true;
+    neopixel_pending = false;
+
+    // O PIO transmite a uma taxa fixa: o quadro termina em neopixel_period_us - neopixel_reset_us, e o
+    // reset conta a partir daí
+#ifdef NEOPIXEL_HOST
+    neopixel_host_transfer(front, neopixel_count);
+    if (neopixel_host_set_alarm(neopixel_period_us)) {
+        neoPixel_frame_done(0);
+    }
+#else
+    dma_channel_transfer_from_buffer_now(neopixel_dma_chan, front, neopixel_count);
+    if (hardware_alarm_set_target(neopixel_alarm, make_timeout_time_us(neopixel_period_us))) {
+        neoPixel_frame_done(neopixel_alarm); // Alvo já passou (interrupção longa): libera agora
+    }
+#endif
+}
+
+void neoPixel_frame_done(unsigned int alarm_num) {
+    (void)alarm_num;
+    neopixel_busy = false;
+    if (neopixel_pending) {
+        neopixel_start_frame();
+    }
+}
+
+void neoPixel_init(uint32_t pin, int count) {
+    assert(count > 0 && count <= neopixel_max_leds);
+
+    memset(neopixel_buffers, 0, sizeof(neopixel_buffers));
+    neopixel_colors = neopixel_buffers[0];
+    neopixel_count = count;
+    neopixel_busy = false;
+    neopixel_pending = false;
+    neopixel_period_us = (uint32_t)(((uint64_t)count * 24 * 1000000 + neopixel_freq_hz - 1) / neopixel_freq_hz) +
+                         neopixel_margin_us + neopixel_reset_us;
+
+#ifdef NEOPIXEL_HOST
+    (void)pin;
+#else
+    uint offset = pio_add_program(neopixel_pio, &ws2812_program);
+    if (offset == (uint)-1) {
+        printf("Erro: não foi possível adicionar o programa PIO\n");
+        return;
+    }
+    uint sm = pio_claim_unused_sm(neopixel_pio, true);
+    if (sm == (uint)-1) {
+        printf("Erro: não foi possível alocar state machine\n");
+        return;
+    }
+    ws2812_program_init(neopixel_pio, sm, offset, pin, neopixel_freq_hz, false);
+
+    // DMA de 32 bits do buffer da frente para a FIFO, no ritmo pedido pela máquina (DREQ)
+    neopixel_dma_chan = dma_claim_unused_channel(true);
+    dma_channel_config config = dma_channel_get_default_config(neopixel_dma_chan);
+    channel_config_set_transfer_data_size(&config, DMA_SIZE_32);
+    channel_config_set_read_increment(&config, true);
+    channel_config_set_write_increment(&config, false);
+    channel_config_set_dreq(&config, pio_get_dreq(neopixel_pio, sm, true));
+    dma_channel_configure(neopixel_dma_chan, &config, &neopixel_pio->txf[sm], NULL, count, false);
+
+    neopixel_alarm = hardware_alarm_claim_unused(true);
+    hardware_alarm_set_callback(neopixel_alarm, neoPixel_frame_done);
+    printf("PIO inicializado: offset=%u, sm=%u, dma=%d\n", offset, sm, neopixel_dma_chan);
+#endif
+}
+
+void neoPixel_set_pixel_color(int index, uint8_t r, uint8_t g, uint8_t b) {
+    assert(index >= 0 && index < neopixel_count);
+
+    // WS2812 usa ordem GRB
+    neopixel_colors[index] = (((uint32_t)g << 16) | ((uint32_t)r << 8) | b) << 8u;
+}
+
+// Verifica e inicia com as interrupções desligadas: o alarme não pode disputar o envio
+void neoPixel_show(void) {
+    uint32_t status = save_and_disable_interrupts();
+    if (neopixel_busy) {
+        neopixel_pending = true;
+    } else {
+        neopixel_start_frame();
+    }
+    restore_interrupts(status);
+}
+
+uint32_t neoPixel_frame_period_us(void) {
+    return neopixel_period_us;
+}
@@ -0,0 +1,41 @@
+#include <stdint.h>
+#include <stdbool.h>
+
+#ifndef neopixel_inc_h
+#define neopixel_inc_h
+
+// Saída para LEDs WS2812 (NeoPixel) sem esperar: as cores ficam em dois buffers (já deslocadas para o PIO,
+// GRB nos 24 bits altos); o DMA envia o da frente para a FIFO de transmissão do PIO enquanto o de trás
+// recebe o próximo quadro. O PIO transmite a uma taxa fixa, então o fim do quadro é conhecido: um alarme
+// do timer marca o fim do quadro mais o reset (latch), no lugar de um sleep_us().
+// neoPixel_show() durante um quadro não espera: o quadro mais recente sai ao fim do reset
+
+#define neopixel_max_leds 64
+#define neopixel_freq_hz 800000 // Bits por segundo do WS2812 (24 por LED)
+#define neopixel_reset_us 80    // Linha em nível baixo que faz os LEDs aplicarem o quadro (latch)
+#define neopixel_margin_us 10   // Folga sobre a duração calculada do quadro
+
+// Inicializa o PIO (pio0), o canal de DMA e o alarme para count LEDs no pino pin, todos apagados
+extern void neoPixel_init(uint32_t pin, int count);
+
+// Atualiza o buffer de trás na posição index com cor RGB
+extern void neoPixel_set_pixel_color(int index, uint8_t r, uint8_t g, uint8_t b);
+
+// Envia o quadro preparado sem esperar. O buffer de trás recebe uma cópia dele, para que quem só muda
+// alguns LEDs continue a partir do quadro enviado
+extern void neoPixel_show(void);
+
+// Alarme no fim do quadro mais o reset (interrupção do timer)
+extern void neoPixel_frame_done(unsigned int alarm_num);
+
+// Duração de um quadro mais o reset: intervalo mínimo entre dois envios
+extern uint32_t neoPixel_frame_period_us(void);
+
+#ifdef NEOPIXEL_HOST
+// No computador (neopixel_test.c): o teste recebe os quadros no lugar do DMA e faz o papel do alarme,
+// chamando neoPixel_frame_done(); neopixel_host_set_alarm() devolve true se o alvo já passou
+extern void neopixel_host_transfer(const uint32_t *frame, int count);
+extern bool neopixel_host_set_alarm(uint32_t delay_us);
+#endif
+
+#endif
@@ -0,0 +1,126 @@
+// Confere o envio dos LEDs WS2812 (neopixel.c) no computador, sem PIO, DMA nem alarme: o teste recebe os
+// quadros no lugar do DMA e dispara o alarme quando quer.
+//   - Período: quadro de 24 bits por LED a 800 kHz, mais folga e reset, para 1, 8 e 64 LEDs.
+//   - Ocioso: neoPixel_show() envia na hora, com as cores em GRB deslocadas para o PIO.
+//   - Ocupado: mudanças e neoPixel_show() durante o quadro não tocam o buffer que está saindo e viram um
+//     só envio no alarme, com todas as mudanças; alarme sem nada pendente não envia.
+//   - Continuidade: o buffer de trás começa com o quadro enviado (mudar um LED mantém os outros).
+//   - Alarme já vencido ao ser armado: o envio é liberado na hora.
+// Falha (código de saída 1) se alguma conferência não passar.
+//
+// Compilação: gcc -std=c11 -O2 -DNEOPIXEL_HOST -o neopixel_test neopixel_test.c neopixel.c
+// Uso:        neopixel_test
+
+#include <stdio.h>
+#include <string.h>
+#include <stdbool.h>
+#include "neopixel.h"
+
+#define test_leds 8
+
+static const uint32_t *test_front;  // Buffer entregue ao "DMA" no último envio
+static uint32_t test_sent[neopixel_max_leds]; // Cópia do quadro no momento do envio
+static int test_transfers;
+static uint32_t test_alarm_us;
+static bool test_alarm_passed;      // Próximo alarme armado já vencido
+
+void neopixel_host_transfer(const uint32_t *frame, int count) {
+    test_front = frame;
+    memcpy(test_sent, frame, count * sizeof(uint32_t));
+    test_transfers++;
+}
+
+bool neopixel_host_set_alarm(uint32_t delay_us) {
+    test_alarm_us = delay_us;
+    return test_alarm_passed;
+}
+
+static uint32_t test_color(uint8_t r, uint8_t g, uint8_t b) {
+    return (((uint32_t)g << 16) | ((uint32_t)r << 8) | b) << 8u;
+}
+
+// Confere o último quadro enviado contra as cores esperadas
+static bool check_sent(const uint32_t *expected, const char *label) {
+    bool ok = memcmp(test_sent, expected, test_leds * sizeof(uint32_t)) == 0;
+
+    if (!ok) {
+        printf("  %s: quadro enviado diferente do esperado\n", label);
+    }
+    return ok;
+}
+
+static bool check(bool condition, const char *label) {
+    printf("%-62s %s\n", label, condition ? "ok" : "ERRO");
+    return condition;
+}
+
+int main(void) {
+    uint32_t expected[test_leds] = { 0 };
+    bool ok = true;
+
+    // Período: 24 bits a 800 kHz = 30 us por LED, mais 10 us de folga e 80 us de reset
+    const int counts[] = { 1, test_leds, neopixel_max_leds };
+    const uint32_t periods[] = { 120, 330, 2010 };
+    bool periods_ok = true;
+    for (int i = 0; i < 3; i++) {
+        neoPixel_init(7, counts[i]);
+        periods_ok = periods_ok && neoPixel_frame_period_us() == periods[i];
+    }
+    ok = check(periods_ok, "periodo de 1, 8 e 64 LEDs: 120, 330 e 2010 us") && ok;
+
+    // Ocioso: envia na hora
+    neoPixel_init(7, test_leds);
+    test_transfers = 0;
+    for (int i = 0; i < test_leds; i++) {
+        neoPixel_set_pixel_color(i, (uint8_t)(10 * i), (uint8_t)(255 - i), (uint8_t)(i + 1));
+        expected[i] = test_color((uint8_t)(10 * i), (uint8_t)(255 - i), (uint8_t)(i + 1));
+    }
+    neoPixel_show();
+    ok = check(test_transfers == 1 && check_sent(expected, "ocioso") && test_alarm_us == 330,
+               "ocioso: envio imediato em GRB, alarme em 330 us") && ok;
+
+    // Ocupado: duas mudanças e dois show() durante o quadro
+    const uint32_t *sending = test_front;
+    uint32_t snapshot[test_leds];
+    memcpy(snapshot, sending, sizeof(snapshot));
+
+    neoPixel_set_pixel_color(2, 1, 2, 3);
+    neoPixel_show();
+    neoPixel_set_pixel_color(5, 4, 5, 6);
+    neoPixel_show();
+    expected[2] = test_color(1, 2, 3);
+    expected[5] = test_color(4, 5, 6);
+    ok = check(test_transfers == 1 && memcmp(snapshot, sending, sizeof(snapshot)) == 0,
+               "ocupado: nenhum envio e o buffer da frente intacto") && ok;
+
+    neoPixel_frame_done(0);
+    ok = check(test_transfers == 2 && check_sent(expected, "ocupado") && test_front != sending,
+               "alarme: um so envio com as duas mudancas, no outro buffer") && ok;
+
+    // Alarme sem nada pendente, depois show() ocioso de novo
+    neoPixel_frame_done(0);
+    ok = check(test_transfers == 2, "alarme sem pendencia: nenhum envio") && ok;
+
+    // Continuidade: muda só um LED, os outros seguem o quadro anterior
+    neoPixel_set_pixel_color(0, 0, 0, 40);
+    expected[0] = test_color(0, 0, 40);
+    neoPixel_show();
+    ok = check(test_transfers == 3 && check_sent(expected, "continuidade"),
+               "continuidade: um LED muda, os outros mantem o quadro anterior") && ok;
+
+    // Alarme vencido ao ser armado (interrupção longa): libera na hora, e o pendente segue
+    test_alarm_passed = true;
+    neoPixel_frame_done(0);
+    neoPixel_set_pixel_color(7, 255, 0, 0);
+    expected[7] = test_color(255, 0, 0);
+    neoPixel_show();
+    neoPixel_set_pixel_color(6, 0, 255, 0);
+    expected[6] = test_color(0, 255, 0);
+    neoPixel_show();
+    ok = check(test_transfers == 5 && check_sent(expected, "vencido"),
+               "alarme vencido: cada show() envia na hora") && ok;
+
+    printf("%s\n", ok ? "OK" : "FALHOU");
+
+    return ok ? 0 : 1;
+}
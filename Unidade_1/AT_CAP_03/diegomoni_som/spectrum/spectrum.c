@@ -0,0 +1,180 @@
+#include <assert.h>
+#include <math.h>
+#include <string.h>
+#include "spectrum.h"
+
+#define spectrum_input_shift 4 // Código de 12 bits -> Q15
+#define spectrum_pi 3.14159265358979323846
+
+static int16_t spectrum_saturate(int32_t value) {
+    return value > INT16_MAX ? INT16_MAX : value < -INT16_MAX ? -INT16_MAX : (int16_t)value;
+}
+
+int32_t spectrum_log2_q8(uint64_t value) {
+    int msb = 63 - __builtin_clzll(value);
+
+    // Fração de 16 bits da mantissa e correção de log2(1 + f) ~ f + 0,3466 f (1 - f)
+    uint32_t fraction = msb >= 16 ? (uint32_t)(value >> (msb - 16)) & 0xFFFF : (uint32_t)(value << (16 - msb)) & 0xFFFF;
+    uint32_t log_fraction = fraction + ((((fraction * (65536 - fraction)) >> 16) * 22713) >> 16);
+
+    return (msb << 8) + (int32_t)((log_fraction + 128) >> 8);
+}
+
+// Potência em dB (Q8): 10 log10(p) = log2(p) * 3,0103
+static int32_t spectrum_db_q8(uint64_t power) {
+    return (int32_t)(((int64_t)spectrum_log2_q8(power) * 49321) >> 14);
+}
+
+void spectrum_init(spectrum_t *spec, uint32_t sample_rate, uint32_t points, uint32_t low_hz,
+                   uint32_t block_size, uint32_t decay_db_per_s) {
+    assert(points >= 2 * spectrum_bands && points <= spectrum_max_points && (points & (points - 1)) == 0);
+    assert(block_size > 0 && block_size <= points && low_hz > 0 && low_hz < sample_rate / 2);
+
+    memset(spec, 0, sizeof(*spec));
+    spec->sample_rate = sample_rate;
+    spec->points = (uint16_t)points;
+    while ((1u << spec->log2_points) < points) {
+        spec->log2_points++;
+    }
+
+    // Fatores de giro e janela de Hann periódica: w[n] = (1 - cos(2πn/N)) / 2, simétrica em torno de N/2
+    for (uint32_t k = 0; k < points / 2; k++) {
+        double angle = 2.0 * spectrum_pi * k / points;
+        int32_t cos_q15 = (int32_t)lround(cos(angle) * INT16_MAX);
+
+        spec->twiddle[2 * k] = (int16_t)cos_q15;
+        spec->twiddle[2 * k + 1] = (int16_t)lround(-sin(angle) * INT16_MAX);
+        spec->window[k] = spectrum_saturate((INT16_MAX - cos_q15 + 1) >> 1);
+        if (k > 0) {
+            spec->window[points - k] = spec->window[k];
+        }
+    }
+    spec->window[points / 2] = INT16_MAX;
+
+    // Faixas em escala logarítmica de low_hz a sample_rate / 2, com pelo menos uma raia cada
+    double low_bin = (double)low_hz * points / sample_rate;
+    double ratio = (points / 2) / low_bin;
+
+    for (int band = 0; band <= spectrum_bands; band++) {
+        uint32_t start = (uint32_t)lround(low_bin * pow(ratio, (double)band / spectrum_bands));
+
+        if (start < 1) {
+            start = 1;
+        }
+        if (band > 0 && start <= spec->band_start[band - 1]) {
+            start = spec->band_start[band - 1] + 1;
+        }
+        spec->band_start[band] = (uint16_t)start;
+    }
+    assert(spec->band_start[spectrum_bands] <= points / 2);
+    spec->band_start[spectrum_bands] = (uint16_t)(points / 2);
+
+    // Referência: senoide de amplitude A (fundo de escala) com Hann e escala 1/N soma 3 A² / 32 nas raias positivas
+    uint64_t amplitude = 2047 << spectrum_input_shift;
+    spec->reference_q8 = spectrum_db_q8(3 * amplitude * amplitude / 32);
+    spec->decay_q8 = (int32_t)(((uint64_t)decay_db_per_s * block_size << spectrum_db_frac_bits) / sample_rate);
+
+    for (int band = 0; band < spectrum_bands; band++) {
+        spec->level_q8[band] = spectrum_floor_db_q8;
+        spec->hold_q8[band] = spectrum_floor_db_q8;
+    }
+}
+
+void spectrum_fft(int16_t *data, uint32_t log2_points, const int16_t *twiddle, uint32_t twiddle_stride) {
+    uint32_t points = 1u << log2_points;
+
+    // Reordena as amostras pela ordem de bits invertida
+    for (uint32_t i = 1, j = 0; i < points; i++) {
+        uint32_t bit = points >> 1;
+
+        for (; j & bit; bit >>= 1) {
+            j ^= bit;
+        }
+        j |= bit;
+        if (i < j) {
+            int16_t re = data[2 * i], im = data[2 * i + 1];
+
+            data[2 * i] = data[2 * j];
+            data[2 * i + 1] = data[2 * j + 1];
+            data[2 * j] = re;
+            data[2 * j + 1] = im;
+        }
+    }
+
+    // Borboletas (decimação no tempo), com escala 1/2 por estágio: o módulo nunca passa o da entrada.
+    // O laço de fora percorre os fatores de giro, lidos uma vez por estágio
+    for (uint32_t half = 1; half < points; half <<= 1) {
+        uint32_t step = (points / (2 * half)) * twiddle_stride;
+
+        for (uint32_t k = 0; k < half; k++) {
+            const int32_t wr = twiddle[2 * k * step], wi = twiddle[2 * k * step + 1];
+
+            for (uint32_t a = k; a < points; a += 2 * half) {
+                int16_t *pa = data + 2 * a, *pb = data + 2 * (a + half);
+                int32_t tr = (pb[0] * wr - pb[1] * wi + (1 << (spectrum_frac_bits - 1))) >> spectrum_frac_bits;
+                int32_t ti = (pb[0] * wi + pb[1] * wr + (1 << (spectrum_frac_bits - 1))) >> spectrum_frac_bits;
+                int32_t ar = pa[0], ai = pa[1];
+
+                pa[0] = (int16_t)((ar + tr) >> 1);
+                pa[1] = (int16_t)((ai + ti) >> 1);
+                pb[0] = (int16_t)((ar - tr) >> 1);
+                pb[1] = (int16_t)((ai - ti) >> 1);
+            }
+        }
+    }
+}
+
+void spectrum_process(spectrum_t *spec, const uint16_t *samples, uint32_t count) {
+    const uint32_t points = spec->points;
+
+    assert(count <= points);
+    if (count == 0) {
+        return;
+    }
+
+    // Janela deslizante dos últimos N códigos (começa preenchida com o primeiro, sem degrau)
+    if (!spec->primed) {
+        for (uint32_t i = 0; i < points; i++) {
+            spec->history[i] = samples[0];
+        }
+        spec->primed = true;
+    }
+    memmove(spec->history, spec->history + count, (points - count) * sizeof(spec->history[0]));
+    memcpy(spec->history + points - count, samples, count * sizeof(samples[0]));
+
+    // Remove o nível DC do trecho, converte para Q15 e aplica a janela
+    uint32_t sum = 0;
+    for (uint32_t i = 0; i < points; i++) {
+        sum += spec->history[i];
+    }
+    int32_t mean = (int32_t)((sum + points / 2) >> spec->log2_points);
+
+    for (uint32_t i = 0; i < points; i++) {
+        int32_t x = spectrum_saturate((spec->history[i] - mean) * (1 << spectrum_input_shift));
+
+        spec->data[2 * i] = (int16_t)((x * spec->window[i]) >> spectrum_frac_bits);
+        spec->data[2 * i + 1] = 0;
+    }
+
+    spectrum_fft(spec->data, spec->log2_points, spec->twiddle, 1);
+
+    // Potência de cada faixa, nível em dB e pico retido com queda constante
+    for (int band = 0; band < spectrum_bands; band++) {
+        uint64_t power = 0;
+
+        for (uint32_t k = spec->band_start[band]; k < spec->band_start[band + 1]; k++) {
+            int32_t re = spec->data[2 * k], im = spec->data[2 * k + 1];
+
+            power += (uint32_t)(re * re) + (uint32_t)(im * im);
+        }
+
+        int32_t level = power ? spectrum_db_q8(power) - spec->reference_q8 : spectrum_floor_db_q8;
+        if (level < spectrum_floor_db_q8) {
+            level = spectrum_floor_db_q8;
+        }
+        spec->level_q8[band] = level;
+
+        int32_t hold = spec->hold_q8[band] - spec->decay_q8;
+        spec->hold_q8[band] = level > hold ? level : hold < spectrum_floor_db_q8 ? spectrum_floor_db_q8 : hold;
+    }
+}
@@ -0,0 +1,62 @@
+#include <stdint.h>
+#include <stdbool.h>
+
+#ifndef spectrum_inc_h
+#define spectrum_inc_h
+
+// Analisador de espectro do microfone em ponto fixo: FFT radix-2 complexa em Q15 (256 ou 512 pontos),
+// com janela de Hann e escala 1/2 em cada estágio (a saída é X[k] / N, sem estouro).
+// A cada bloco de amostras do ADC, a FFT cobre os últimos N códigos (com N maior que o bloco, as janelas
+// se sobrepõem), o nível DC do trecho é removido e as raias de 1 a N/2 são somadas em spectrum_bands
+// faixas espaçadas em escala logarítmica, uma por LED. O nível de cada faixa vai em dB (Q8) em relação a
+// uma senoide de fundo de escala, e um pico retido cai a decay dB por segundo.
+// Só somas, deslocamentos e multiplicações de 32 bits por amostra; as tabelas (janela e fatores de giro)
+// são calculadas na inicialização. Compila também no computador (spectrum_bench.c mede e confere a FFT)
+
+#define spectrum_max_log2_points 9
+#define spectrum_max_points (1 << spectrum_max_log2_points)
+#define spectrum_bands 8
+#define spectrum_frac_bits 15
+#define spectrum_db_frac_bits 8  // Níveis em dB com 8 bits de fração
+#define spectrum_floor_db_q8 (-120 * (1 << spectrum_db_frac_bits)) // Nível de uma faixa sem energia
+
+typedef struct {
+    uint32_t sample_rate;
+    uint16_t points;
+    uint8_t log2_points;
+    bool primed;            // Janela já preenchida pela primeira amostra
+    uint16_t band_start[spectrum_bands + 1];  // Primeira raia de cada faixa (a última entrada é N/2)
+    int32_t reference_q8;   // Potência de uma senoide de fundo de escala, em dB (Q8)
+    int32_t decay_q8;       // Queda do pico retido por bloco, em dB (Q8)
+
+    int16_t window[spectrum_max_points];          // Hann (Q15)
+    int16_t twiddle[spectrum_max_points];         // cos e -sen de 2πk/N, intercalados, k < N/2 (Q15)
+    uint16_t history[spectrum_max_points];        // Últimos N códigos do ADC
+    int16_t data[2 * spectrum_max_points];        // Área de trabalho da FFT (real e imaginária intercaladas)
+
+    // Saídas do último bloco: nível e pico retido de cada faixa, em dB (Q8, 0 = fundo de escala)
+    int32_t level_q8[spectrum_bands];
+    int32_t hold_q8[spectrum_bands];
+} spectrum_t;
+
+// points: 256 ou 512 (potência de 2 até spectrum_max_points); low_hz: início da primeira faixa (as faixas
+// vão até sample_rate / 2); block_size: amostras entregues por chamada de spectrum_process
+void spectrum_init(spectrum_t *spec, uint32_t sample_rate, uint32_t points, uint32_t low_hz,
+                   uint32_t block_size, uint32_t decay_db_per_s);
+
+// Acrescenta um bloco de códigos do ADC (12 bits, count até N), calcula a FFT e atualiza as faixas
+void spectrum_process(spectrum_t *spec, const uint16_t *samples, uint32_t count);
+
+// FFT complexa no lugar, em Q15 com escala 1/N: data tem N pares (real, imaginária); twiddle é a tabela de
+// spectrum_t (stride 1 para N igual ao usado na inicialização)
+void spectrum_fft(int16_t *data, uint32_t log2_points, const int16_t *twiddle, uint32_t twiddle_stride);
+
+// Logaritmo de base 2 em Q8 (erro menor que 0,01); value > 0
+int32_t spectrum_log2_q8(uint64_t value);
+
+// Frequência inicial da faixa band (band = spectrum_bands dá o fim da última), em Hz
+static inline uint32_t spectrum_band_hz(const spectrum_t *spec, int band) {
+    return (uint32_t)((uint64_t)spec->band_start[band] * spec->sample_rate / spec->points);
+}
+
+#endif
@@ -0,0 +1,252 @@
+// Confere e mede o analisador de espectro (spectrum.c) no computador.
+// Conferência: a FFT em Q15 é comparada com uma DFT em precisão dupla das mesmas entradas (ruído e
+// senoides em vários níveis), e os níveis das faixas com os de um cálculo em precisão dupla do mesmo
+// trecho (janela, FFT e faixas sem quantização). Falha (código de saída 1) se os erros passarem dos limites.
+// Medida: tempo da FFT e do processamento completo de um bloco, em ns e, em x86, em ciclos do contador
+// de tempo (TSC); na placa o custo em ciclos vai na telemetria (ciclos_bloco).
+//
+// Compilação: gcc -std=c11 -O2 -o spectrum_bench spectrum_bench.c spectrum.c -lm
+// Uso:        spectrum_bench [-n pontos] [-b bloco] [-f taxa_hz] [-i repeticoes]
+
+#define _POSIX_C_SOURCE 199309L
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include <time.h>
+#include "spectrum.h"
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <x86intrin.h>
+#define bench_cycles() __rdtsc()
+#else
+#define bench_cycles() 0ULL
+#endif
+
+#define bench_pi 3.14159265358979323846
+#define bench_max_error_lsb 6.0  // Erro máximo aceito numa raia da FFT (LSB de Q15)
+#define bench_max_rms_error_lsb 1.5 // Erro rms aceito nas raias da FFT (a escala 1/2 por estágio dá ~1 LSB)
+#define bench_max_level_error_db 1.0 // Erro máximo aceito no nível de uma faixa (até 50 dB abaixo do fundo de escala)
+
+static double now_seconds(void) {
+    struct timespec time;
+
+    clock_gettime(CLOCK_MONOTONIC, &time);
+    return time.tv_sec + time.tv_nsec * 1e-9;
+}
+
+// DFT direta em precisão dupla, com a mesma escala 1/N da FFT
+static void dft_reference(const int16_t *input, uint32_t points, double *re, double *im) {
+    for (uint32_t k = 0; k < points; k++) {
+        double sum_re = 0, sum_im = 0;
+
+        for (uint32_t n = 0; n < points; n++) {
+            double angle = -2.0 * bench_pi * (double)((uint64_t)k * n % points) / points;
+
+            sum_re += input[2 * n] * cos(angle) - input[2 * n + 1] * sin(angle);
+            sum_im += input[2 * n] * sin(angle) + input[2 * n + 1] * cos(angle);
+        }
+        re[k] = sum_re / points;
+        im[k] = sum_im / points;
+    }
+}
+
+// Compara a FFT em Q15 com a referência; devolve o erro máximo e o erro rms, em LSB
+static void check_fft(const spectrum_t *spec, const int16_t *input, const char *name, double *max_error, double *rms_error) {
+    uint32_t points = spec->points;
+    int16_t data[2 * spectrum_max_points];
+    double *re = malloc(points * sizeof(double)), *im = malloc(points * sizeof(double));
+    double signal = 0, noise = 0;
+
+    memcpy(data, input, 2 * points * sizeof(int16_t));
+    spectrum_fft(data, spec->log2_points, spec->twiddle, 1);
+    dft_reference(input, points, re, im);
+
+    *max_error = 0;
+    for (uint32_t k = 0; k < points; k++) {
+        double error_re = data[2 * k] - re[k], error_im = data[2 * k + 1] - im[k];
+        double error = sqrt(error_re * error_re + error_im * error_im);
+
+        if (error > *max_error) {
+            *max_error = error;
+        }
+        signal += re[k] * re[k] + im[k] * im[k];
+        noise += error_re * error_re + error_im * error_im;
+    }
+    *rms_error = sqrt(noise / points);
+    printf("  fft %-26s erro max %.2f LSB, rms %.3f LSB, sinal/erro %.1f dB\n",
+           name, *max_error, *rms_error, noise > 0 ? 10 * log10(signal / noise) : 999.0);
+    free(re);
+    free(im);
+}
+
+// Códigos do ADC de uma senoide (amplitude em LSB) sobre a polarização, a partir da amostra start
+static void make_tone(uint16_t *codes, uint32_t count, uint32_t start, double rate, double hz, double amplitude, double bias) {
+    for (uint32_t i = 0; i < count; i++) {
+        double value = bias + amplitude * sin(2 * bench_pi * hz * (start + i) / rate);
+
+        codes[i] = (uint16_t)(value < 0 ? 0 : value > 4095 ? 4095 : lround(value));
+    }
+}
+
+// Níveis das faixas (dB em relação ao fundo de escala) dos últimos N códigos, em precisão dupla
+static void reference_levels(const spectrum_t *spec, const uint16_t *codes, double *levels) {
+    uint32_t points = spec->points;
+    double *re = malloc(points * sizeof(double)), *im = malloc(points * sizeof(double));
+    double mean = 0, full_scale = 2047.0 * 2047.0 * 3 / 32;
+
+    for (uint32_t n = 0; n < points; n++) {
+        mean += codes[n];
+    }
+    mean /= points;
+    for (uint32_t k = spec->band_start[0]; k < points / 2; k++) {
+        double sum_re = 0, sum_im = 0;
+
+        for (uint32_t n = 0; n < points; n++) {
+            double window = 0.5 * (1 - cos(2 * bench_pi * n / points));
+            double angle = -2.0 * bench_pi * (double)((uint64_t)k * n % points) / points;
+
+            sum_re += (codes[n] - mean) * window * cos(angle);
+            sum_im += (codes[n] - mean) * window * sin(angle);
+        }
+        re[k] = sum_re / points;
+        im[k] = sum_im / points;
+    }
+    for (int band = 0; band < spectrum_bands; band++) {
+        double power = 0;
+
+        for (uint32_t k = spec->band_start[band]; k < spec->band_start[band + 1]; k++) {
+            power += re[k] * re[k] + im[k] * im[k];
+        }
+        levels[band] = power > 0 ? 10 * log10(power / full_scale) : -999;
+    }
+    free(re);
+    free(im);
+}
+
+int main(int argc, char **argv) {
+    uint32_t points = 512, block_size = 256, rate = 16000, iterations = 20000;
+    bool ok = true;
+
+    for (int i = 1; i + 1 < argc; i += 2) {
+        uint32_t value = (uint32_t)strtoul(argv[i + 1], NULL, 10);
+
+        switch (argv[i][1]) {
+        case 'n': points = value; break;
+        case 'b': block_size = value; break;
+        case 'f': rate = value; break;
+        case 'i': iterations = value; break;
+        default:
+            fprintf(stderr, "uso: %s [-n pontos] [-b bloco] [-f taxa_hz] [-i repeticoes]\n", argv[0]);
+            return 2;
+        }
+    }
+    if (points < 2 * spectrum_bands || points > spectrum_max_points || (points & (points - 1)) || !block_size || block_size > points) {
+        fprintf(stderr, "pontos: potencia de 2 de %d a %d; bloco: de 1 a pontos\n", 2 * spectrum_bands, spectrum_max_points);
+        return 2;
+    }
+
+    static spectrum_t spec;
+    spectrum_init(&spec, rate, points, 100, block_size, 20);
+    printf("FFT de %u pontos a %u Hz, blocos de %u amostras; faixas (Hz):", points, rate, block_size);
+    for (int band = 0; band <= spectrum_bands; band++) {
+        printf(" %u", spectrum_band_hz(&spec, band));
+    }
+    printf("\n");
+
+    // FFT contra a DFT em precisão dupla
+    int16_t input[2 * spectrum_max_points];
+    double max_error, rms_error;
+
+    srand(1);
+    for (uint32_t n = 0; n < points; n++) {
+        input[2 * n] = (int16_t)(rand() % 46341 - 23170); // Módulo até 32767
+        input[2 * n + 1] = (int16_t)(rand() % 46341 - 23170);
+    }
+    check_fft(&spec, input, "ruido complexo", &max_error, &rms_error);
+    ok = ok && max_error <= bench_max_error_lsb && rms_error <= bench_max_rms_error_lsb;
+
+    for (uint32_t n = 0; n < points; n++) {
+        input[2 * n] = (int16_t)(rand() % 65535 - 32767);
+        input[2 * n + 1] = 0;
+    }
+    check_fft(&spec, input, "ruido real", &max_error, &rms_error);
+    ok = ok && max_error <= bench_max_error_lsb && rms_error <= bench_max_rms_error_lsb;
+
+    const double tone_levels_db[] = { 0, -20, -40 };
+    for (int t = 0; t < 3; t++) {
+        char name[40];
+        double amplitude = 32767 * pow(10, tone_levels_db[t] / 20);
+
+        for (uint32_t n = 0; n < points; n++) {
+            input[2 * n] = (int16_t)lround(amplitude * cos(2 * bench_pi * 37.3 * n / points));
+            input[2 * n + 1] = 0;
+        }
+        snprintf(name, sizeof(name), "senoide %.0f dB", tone_levels_db[t]);
+        check_fft(&spec, input, name, &max_error, &rms_error);
+        ok = ok && max_error <= bench_max_error_lsb && rms_error <= bench_max_rms_error_lsb;
+    }
+
+    // Níveis das faixas: uma senoide no meio de cada faixa, em níveis de 0 a -50 dB, sobre polarização 1900
+    uint16_t codes[spectrum_max_points];
+    double worst_level_error = 0;
+
+    for (int band = 0; band < spectrum_bands; band++) {
+        double hz = sqrt((double)spectrum_band_hz(&spec, band) * spectrum_band_hz(&spec, band + 1));
+
+        for (int level_db = 0; level_db >= -50; level_db -= 10) {
+            double amplitude = 2047 * pow(10, level_db / 20.0) * 0.92;
+            double levels[spectrum_bands];
+
+            spectrum_init(&spec, rate, points, 100, block_size, 20);
+            for (uint32_t start = 0; start < points; start += block_size) {
+                make_tone(codes + start, block_size, start, rate, hz, amplitude, 1900);
+                spectrum_process(&spec, codes + start, block_size);
+            }
+            reference_levels(&spec, codes, levels);
+
+            double error = spec.level_q8[band] / 256.0 - levels[band];
+            if (fabs(error) > worst_level_error) {
+                worst_level_error = fabs(error);
+            }
+            if (level_db == 0 || level_db == -50) {
+                printf("  faixa %d, %5.0f Hz, %3d dB: nivel %7.2f dB, referencia %7.2f dB\n",
+                       band, hz, level_db, spec.level_q8[band] / 256.0, levels[band]);
+            }
+        }
+    }
+    printf("  niveis das faixas: erro max %.3f dB\n", worst_level_error);
+    ok = ok && worst_level_error <= bench_max_level_error_db;
+
+    // Medida: FFT sozinha e bloco completo (janela, FFT e faixas)
+    int16_t data[2 * spectrum_max_points];
+    uint64_t start_cycles = bench_cycles();
+    double start = now_seconds();
+    int32_t sink = 0;
+
+    for (uint32_t i = 0; i < iterations; i++) {
+        memcpy(data, input, 2 * points * sizeof(int16_t));
+        spectrum_fft(data, spec.log2_points, spec.twiddle, 1);
+        sink += data[2 * (i % points)];
+    }
+    double fft_ns = (now_seconds() - start) * 1e9 / iterations;
+    uint64_t fft_cycles = (bench_cycles() - start_cycles) / iterations;
+
+    make_tone(codes, block_size, 0, rate, 1000, 500, 1900);
+    start_cycles = bench_cycles();
+    start = now_seconds();
+    for (uint32_t i = 0; i < iterations; i++) {
+        spectrum_process(&spec, codes, block_size);
+        sink += spec.level_q8[i % spectrum_bands];
+    }
+    double block_ns = (now_seconds() - start) * 1e9 / iterations;
+    uint64_t block_cycles = (bench_cycles() - start_cycles) / iterations;
+    double period_ns = 1e9 * block_size / rate;
+
+    printf("FFT: %.0f ns (%llu ciclos TSC) por bloco; bloco completo: %.0f ns (%llu ciclos TSC), %.3f%% do periodo de %.0f us\n",
+           fft_ns, (unsigned long long)fft_cycles, block_ns, (unsigned long long)block_cycles,
+           100 * block_ns / period_ns, period_ns / 1000);
+    printf("%s (%d)\n", ok ? "OK" : "FALHOU", (int)(sink & 1));
+
+    return ok ? 0 : 1;
+}
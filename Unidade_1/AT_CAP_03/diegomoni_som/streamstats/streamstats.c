@@ -0,0 +1,350 @@
+#include <string.h>
+#include <assert.h>
+#include "streamstats.h"
+
+#define streamstats_chunk 1024 // Amostras por bloco somado (mantém as somas de 12 bits longe do estouro)
+
+static const uint16_t streamstats_permille[streamstats_quantiles] = streamstats_quantile_permille;
+
+// Raiz quadrada inteira (arredondada para baixo), bit a bit
+static uint32_t streamstats_isqrt(uint64_t value) {
+    uint64_t root = 0;
+    uint64_t bit = 1ULL << 62;
+
+    while (bit > value) {
+        bit >>= 2;
+    }
+    while (bit) {
+        if (value >= root + bit) {
+            value -= root + bit;
+            root = (root >> 1) + bit;
+        }
+        else {
+            root >>= 1;
+        }
+        bit >>= 2;
+    }
+
+    return (uint32_t)root;
+}
+
+// Divisão arredondada (o truncamento acumularia um viés na média ao longo de muitas amostras)
+static int64_t streamstats_div_round(int64_t num, int64_t den) {
+    return (num >= 0 ? num + den / 2 : num - den / 2) / den;
+}
+
+// Estimador P² vazio para o quantil permille / 1000
+static void streamstats_p2_init(streamstats_p2_t *p2, uint16_t permille) {
+    int32_t p = (int32_t)(((uint32_t)permille << 16) / 1000);
+
+    memset(p2, 0, sizeof(*p2));
+    p2->desired_q16[0] = 1 << 16;
+    p2->desired_q16[1] = (1 << 16) + 2 * p;
+    p2->desired_q16[2] = (1 << 16) + 4 * p;
+    p2->desired_q16[3] = (3 << 16) + 2 * p;
+    p2->desired_q16[4] = 5 << 16;
+    p2->increment_q16[0] = 0;
+    p2->increment_q16[1] = p / 2;
+    p2->increment_q16[2] = p;
+    p2->increment_q16[3] = ((1 << 16) + p) / 2;
+    p2->increment_q16[4] = 1 << 16;
+}
+
+// Ajuste parabólico (fórmula P²) da altura do marcador i, deslocado de ds (±1) posição
+static int32_t streamstats_p2_parabolic(const streamstats_p2_t *p2, int i, int ds) {
+    int64_t left = p2->position[i] - p2->position[i - 1];
+    int64_t right = p2->position[i + 1] - p2->position[i];
+    int64_t a = (left + ds) * (p2->height[i + 1] - p2->height[i]) / right;
+    int64_t b = (right - ds) * (p2->height[i] - p2->height[i - 1]) / left;
+
+    return (int32_t)(p2->height[i] + ds * (a + b) / (left + right));
+}
+
+static int32_t streamstats_p2_linear(const streamstats_p2_t *p2, int i, int ds) {
+    return p2->height[i] + ds * (p2->height[i + ds] - p2->height[i]) / (p2->position[i + ds] - p2->position[i]);
+}
+
+static void streamstats_p2_add(streamstats_p2_t *p2, int32_t value) {
+    int32_t height = value << streamstats_frac_bits;
+    int k;
+
+    // As 5 primeiras amostras ficam ordenadas e viram os marcadores
+    if (p2->initial < 5) {
+        int i = p2->initial++;
+
+        while (i > 0 && p2->height[i - 1] > height) {
+            p2->height[i] = p2->height[i - 1];
+            i--;
+        }
+        p2->height[i] = height;
+        if (p2->initial == 5) {
+            for (i = 0; i < 5; i++) {
+                p2->position[i] = i + 1;
+            }
+        }
+        return;
+    }
+
+    // Célula da amostra (estendendo os extremos se preciso)
+    if (height < p2->height[0]) {
+        p2->height[0] = height;
+        k = 0;
+    }
+    else if (height >= p2->height[4]) {
+        p2->height[4] = height;
+        k = 3;
+    }
+    else {
+        k = 0;
+        while (height >= p2->height[k + 1]) {
+            k++;
+        }
+    }
+
+    for (int i = k + 1; i < 5; i++) {
+        p2->position[i]++;
+    }
+    for (int i = 0; i < 5; i++) {
+        p2->desired_q16[i] += p2->increment_q16[i];
+    }
+
+    // Marcadores centrais afastados da posição desejada andam uma posição
+    for (int i = 1; i < 4; i++) {
+        int64_t d = p2->desired_q16[i] - ((int64_t)p2->position[i] << 16);
+
+        if ((d >= (1 << 16) && p2->position[i + 1] - p2->position[i] > 1) ||
+            (d <= -(1 << 16) && p2->position[i - 1] - p2->position[i] < -1)) {
+            int ds = d > 0 ? 1 : -1;
+            int32_t candidate = streamstats_p2_parabolic(p2, i, ds);
+
+            if (p2->height[i - 1] < candidate && candidate < p2->height[i + 1]) {
+                p2->height[i] = candidate;
+            }
+            else {
+                p2->height[i] = streamstats_p2_linear(p2, i, ds);
+            }
+            p2->position[i] += ds;
+        }
+    }
+}
+
+// Estimativa atual (Q8); com menos de 5 amostras, o valor de posição mais próxima entre as ordenadas
+static int32_t streamstats_p2_estimate(const streamstats_p2_t *p2, uint16_t permille) {
+    if (p2->initial == 0) {
+        return 0;
+    }
+    if (p2->initial < 5) {
+        return p2->height[((p2->initial - 1) * permille + 500) / 1000];
+    }
+
+    return p2->height[2];
+}
+
+// Combina os momentos de b em a (fórmula de Chan para a variância de dois conjuntos)
+static void streamstats_merge(streamstats_moments_t *a, const streamstats_moments_t *b) {
+    if (!b->count) {
+        return;
+    }
+    if (!a->count) {
+        *a = *b;
+        return;
+    }
+
+    uint32_t count = a->count + b->count;
+    int64_t delta = b->mean_q16 - a->mean_q16;
+    int64_t delta_q8 = delta / 256;
+    int64_t delta_sq = delta_q8 * delta_q8; // Quadrado do desvio * 65536
+
+    a->mean_q16 += streamstats_div_round(delta * b->count, count);
+    a->m2_q16 += b->m2_q16 + delta_sq * b->count / count * a->count;
+    a->count = count;
+    if (b->min < a->min) {
+        a->min = b->min;
+    }
+    if (b->max > a->max) {
+        a->max = b->max;
+    }
+}
+
+// Fecha o painel atual: guarda o resumo na história e recomeça
+static void streamstats_close_pane(streamstats_t *stats) {
+    streamstats_summary_t *summary = &stats->history[stats->head];
+
+    summary->moments = stats->current;
+    for (int q = 0; q < streamstats_quantiles; q++) {
+        summary->quantile_q8[q] = streamstats_p2_estimate(&stats->p2[q], streamstats_permille[q]);
+        streamstats_p2_init(&stats->p2[q], streamstats_permille[q]);
+    }
+    memset(&stats->current, 0, sizeof(stats->current));
+
+    stats->head = (stats->head + 1) % stats->panes;
+    if (stats->filled < stats->panes) {
+        stats->filled++;
+    }
+    stats->completed++;
+}
+
+// Painéis de pane_size amostras; janela deslizante de panes painéis (1 a streamstats_max_panes)
+void streamstats_init(streamstats_t *stats, uint32_t pane_size, uint8_t panes, uint8_t p2_stride) {
+    assert(pane_size >= 1 && pane_size < (1u << 24));
+    assert(panes >= 1 && panes <= streamstats_max_panes);
+    assert(p2_stride >= 1);
+
+    memset(stats, 0, sizeof(*stats));
+    stats->pane_size = pane_size;
+    stats->panes = panes;
+    stats->p2_stride = p2_stride;
+    for (int q = 0; q < streamstats_quantiles; q++) {
+        streamstats_p2_init(&stats->p2[q], streamstats_permille[q]);
+    }
+}
+
+// Uma amostra (Welford); retorna true se completou um painel
+bool streamstats_add(streamstats_t *stats, int32_t value) {
+    streamstats_moments_t *m = &stats->current;
+    int64_t x_q16 = (int64_t)value << 16;
+
+    if (m->count == 0) {
+        m->min = m->max = value;
+    }
+    else if (value < m->min) {
+        m->min = value;
+    }
+    else if (value > m->max) {
+        m->max = value;
+    }
+
+    int64_t delta = x_q16 - m->mean_q16;
+    m->count++;
+    m->mean_q16 += streamstats_div_round(delta, m->count);
+    m->m2_q16 += (delta / 256) * ((x_q16 - m->mean_q16) / 256);
+
+    if (stats->stride_phase == 0) {
+        for (int q = 0; q < streamstats_quantiles; q++) {
+            streamstats_p2_add(&stats->p2[q], value);
+        }
+    }
+    stats->stride_phase = (stats->stride_phase + 1) % stats->p2_stride;
+
+    if (m->count == stats->pane_size) {
+        streamstats_close_pane(stats);
+        return true;
+    }
+
+    return false;
+}
+
+// Momentos de um bloco de até streamstats_chunk amostras de 12 bits, somados em torno da primeira
+static void streamstats_block_moments(const uint16_t *samples, uint32_t count, streamstats_moments_t *m) {
+    int32_t ref = samples[0];
+    int32_t sum = 0;
+    uint64_t sum_sq = 0;
+    int32_t min = ref, max = ref;
+
+    for (uint32_t i = 0; i < count; i++) {
+        int32_t x = samples[i];
+        int32_t d = x - ref;
+
+        sum += d;
+        sum_sq += (uint32_t)(d * d);
+        if (x < min) {
+            min = x;
+        }
+        if (x > max) {
+            max = x;
+        }
+    }
+
+    m->count = count;
+    m->min = min;
+    m->max = max;
+    m->mean_q16 = ((int64_t)ref << 16) + streamstats_div_round((int64_t)sum << 16, count);
+    m->m2_q16 = (int64_t)(sum_sq << 16) - (((int64_t)sum * sum) << 16) / (int32_t)count;
+}
+
+// Bloco de amostras do ADC (12 bits); retorna true se completou algum painel
+bool streamstats_add_block(streamstats_t *stats, const uint16_t *samples, uint32_t count) {
+    bool closed = false;
+
+    while (count > 0) {
+        uint32_t run = stats->pane_size - stats->current.count;
+
+        if (run > count) {
+            run = count;
+        }
+        if (run > streamstats_chunk) {
+            run = streamstats_chunk;
+        }
+
+        streamstats_moments_t block;
+        streamstats_block_moments(samples, run, &block);
+        streamstats_merge(&stats->current, &block);
+
+        // P²: uma amostra a cada p2_stride, continuando a fase entre blocos
+        uint32_t i = stats->stride_phase ? stats->p2_stride - stats->stride_phase : 0;
+        for (; i < run; i += stats->p2_stride) {
+            for (int q = 0; q < streamstats_quantiles; q++) {
+                streamstats_p2_add(&stats->p2[q], samples[i]);
+            }
+        }
+        stats->stride_phase = (uint8_t)((stats->stride_phase + run) % stats->p2_stride);
+
+        samples += run;
+        count -= run;
+
+        if (stats->current.count == stats->pane_size) {
+            streamstats_close_pane(stats);
+            closed = true;
+        }
+    }
+
+    return closed;
+}
+
+// Janela fixa: o último painel completo; false se ainda não há nenhum
+bool streamstats_tumbling(const streamstats_t *stats, streamstats_summary_t *summary) {
+    if (!stats->filled) {
+        return false;
+    }
+
+    *summary = stats->history[(stats->head + stats->panes - 1) % stats->panes];
+
+    return true;
+}
+
+// Janela deslizante: os painéis completos da história combinados
+bool streamstats_sliding(const streamstats_t *stats, streamstats_summary_t *summary) {
+    int64_t weighted[streamstats_quantiles] = { 0 };
+
+    memset(summary, 0, sizeof(*summary));
+    for (int i = 0; i < stats->filled; i++) {
+        const streamstats_summary_t *pane = &stats->history[i];
+
+        streamstats_merge(&summary->moments, &pane->moments);
+        for (int q = 0; q < streamstats_quantiles; q++) {
+            weighted[q] += (int64_t)pane->quantile_q8[q] * pane->moments.count;
+        }
+    }
+    if (!summary->moments.count) {
+        return false;
+    }
+
+    for (int q = 0; q < streamstats_quantiles; q++) {
+        summary->quantile_q8[q] = (int32_t)(weighted[q] / (int64_t)summary->moments.count);
+    }
+
+    return true;
+}
+
+int32_t streamstats_mean_q8(const streamstats_summary_t *summary) {
+    return (int32_t)((summary->moments.mean_q16 + 128) >> 8);
+}
+
+// Desvio padrão amostral (divisão por n - 1)
+uint32_t streamstats_stddev_q8(const streamstats_summary_t *summary) {
+    if (summary->moments.count < 2 || summary->moments.m2_q16 <= 0) {
+        return 0;
+    }
+
+    return streamstats_isqrt((uint64_t)summary->moments.m2_q16 / (summary->moments.count - 1));
+}
@@ -0,0 +1,47 @@
+#include <stdint.h>
+#include <stddef.h>
+#include <stdbool.h>
+
+#ifndef telemetry_inc_h
+#define telemetry_inc_h
+
+// Telemetria binária pela USB (CDC), comum aos projetos: troca as linhas de printf por quadros compactos,
+// decodificados no computador por telemetry_decode.cpp (que gera CSV).
+//
+// Quadro, antes do enquadramento: tipo (1 byte), instante em µs (4 bytes, little-endian), conteúdo e
+// CRC-16/CCITT-FALSE (2 bytes, little-endian) do tipo ao conteúdo.
+// Enquadramento COBS: o quadro codificado não tem bytes 0x00 e vai entre dois 0x00, de modo que textos
+// impressos com printf entre quadros são descartados pelo decodificador sem perder o quadro seguinte.
+//   tipo 0 (telemetry_descriptor): descreve um tipo de registro: tipo descrito (1 byte), nome e campos
+//     (textos terminados em 0). Campos separados por vírgula; "nome:n" indica n casas decimais
+//     (o valor inteiro é dividido por 10^n)
+//   tipos 1 a telemetry_max_types: registros de dados, um varint zigzag por campo
+// As descrições são reenviadas a cada telemetry_describe_interval_us, para quem abrir a porta depois
+
+#define telemetry_descriptor 0
+#define telemetry_max_types 8
+#define telemetry_max_fields 24
+#define telemetry_max_frame 250          // Quadro sem enquadramento (um único bloco COBS)
+#define telemetry_frame_overhead 7       // Tipo, instante e CRC
+#define telemetry_max_encoded (telemetry_max_frame + 3)
+#define telemetry_describe_interval_us 2000000u
+
+// Registra um tipo de registro (na inicialização) e envia a sua descrição. Recusa (false) descrições
+// que não cabem num quadro ou com mais de telemetry_max_fields campos
+extern bool telemetry_define(uint8_t type, const char *name, const char *fields);
+
+// Envia um registro de dados com count valores
+extern void telemetry_send(uint8_t type, uint32_t time_us, const int32_t *values, int count);
+
+// Partes puras da codificação (também usadas no computador)
+extern uint16_t telemetry_crc16(const uint8_t *data, size_t length);
+extern size_t telemetry_cobs_encode(const uint8_t *data, size_t length, uint8_t *out);
+extern size_t telemetry_build_frame(uint8_t type, uint32_t time_us, const uint8_t *payload, size_t length, uint8_t *out);
+
+#ifdef TELEMETRY_HOST
+// No computador (telemetry_test.c): os quadros vão para o teste, que também controla o relógio
+extern void telemetry_host_write(const uint8_t *data, size_t length);
+extern uint32_t telemetry_host_time_us;
+#endif
+
+#endif
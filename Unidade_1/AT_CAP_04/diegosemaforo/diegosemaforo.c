@@ -78,7 +78,7 @@ static volatile alarm_id_t beep_alarm_id = -1;
 static volatile int tempo_restante = 0;
 
 // Display OLED
-static uint8_t oled_buf[ssd1306_buffer_length];  // Buffer para o display
+static ssd1306_t oled;                            // Display (framebuffer, filas e canal DMA próprios)
 static struct render_area area_total = {          // Área de renderização
     .start_column = 0,
     .end_column = ssd1306_width - 1,
@@ -153,15 +153,14 @@ static void atualizar_display_tempo() {
     // Formata o tempo com 2 dígitos (ex: "05")
     snprintf(tempo_str, sizeof(tempo_str), "%02d", tempo_restante);
 
-    // Calcula posição X para centralizar (considerando 12px por dígito)
-    int num_digitos = strlen(tempo_str);
-    int pos_x = (128 - (num_digitos * 12)) / 2;
+    // Calcula posição X para centralizar (largura real dos dígitos ampliados)
+    int pos_x = (ssd1306_width - ssd1306_measure_string(tempo_str, 2)) / 2;
 
     // Limpa o buffer e atualiza o display
-    memset(oled_buf, 0, sizeof(oled_buf));
-    ssd1306_draw_string(oled_buf, 0, 0, "Tempo restante:");
-    ssd1306_draw_string_scale2(oled_buf, pos_x, 16, tempo_str);
-    render_on_display(oled_buf, &area_total);
+    ssd1306_clear(&oled);
+    ssd1306_draw_string(oled.ram_buffer, 0, 0, "Tempo restante:");
+    ssd1306_draw_string_scale2(oled.ram_buffer, pos_x, 16, tempo_str);
+    render_changes_on_display(&oled);
 }
 
 /**
@@ -203,9 +202,9 @@ static void gpio_callback(uint gpio, uint32_t events) {
                 printf("Botão de Pedestres acionado\n");
                 
                 // Atualiza display
-                memset(oled_buf, 0, sizeof(oled_buf));
-                ssd1306_draw_string(oled_buf, 0, 0, "Pedido recebido");
-                render_on_display(oled_buf, &area_total);
+                ssd1306_clear(&oled);
+                ssd1306_draw_string(oled.ram_buffer, 0, 0, "Pedido recebido");
+                render_changes_on_display(&oled);
             }
         }
     }
@@ -246,10 +245,10 @@ static void atualizar_semaforo(EstadoSemaforo estado) {
     printf("Sinal: %s\n", cor);
     
     // Atualiza display OLED
-    memset(oled_buf, 0, sizeof(oled_buf));
-    ssd1306_draw_string(oled_buf, 0, 0, "Sinal:");
-    ssd1306_draw_string(oled_buf, 48, 0, (char *)cor);
-    render_on_display(oled_buf, &area_total);
+    ssd1306_clear(&oled);
+    ssd1306_draw_string(oled.ram_buffer, 0, 0, "Sinal:");
+    ssd1306_draw_string(oled.ram_buffer, 48, 0, (char *)cor);
+    render_changes_on_display(&oled);
 }
 
 /**
@@ -285,10 +284,10 @@ int main() {
     gpio_set_function(15, GPIO_FUNC_I2C);  // SCL
     gpio_pull_up(14);  // Pull-up no SDA
     gpio_pull_up(15);  // Pull-up no SCL
-    ssd1306_init();  // Inicializa display
+    ssd1306_init(&oled, i2c1, ssd1306_i2c_address);  // Inicializa display
     calculate_render_area_buffer_length(&area_total);  // Calcula buffer
-    memset(oled_buf, 0, sizeof(oled_buf));  // Limpa buffer
-    render_on_display(oled_buf, &area_total);  // Atualiza display
+    ssd1306_clear(&oled);  // Limpa buffer
+    render_on_display(&oled, &area_total);  // Atualiza display
 
     /*** Configuração dos LEDs ***/
     gpio_init(PIN_LED_RED);
@@ -1,54 +1,128 @@
+// Fonte 8x8 organizada em colunas (bit 0 no topo), com todo o ASCII imprimível (0x20 a 0x7E) e o símbolo de grau.
+// O glifo 0 é vazio e usado para caracteres sem representação
+static const uint8_t font[] = {
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, // 0: caractere sem glifo
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, // 1: ' ' (espaço)
+    0x00, 0x00, 0x7d, 0x00, 0x00, 0x00, 0x00, 0x00, // 2: '!' (exclamação)
+    0x00, 0x07, 0x00, 0x07, 0x00, 0x00, 0x00, 0x00, // 3: '"' (aspas)
+    0x14, 0x14, 0x7f, 0x14, 0x7f, 0x14, 0x14, 0x00, // 4: '#' (jogo da velha)
+    0x08, 0x3e, 0x49, 0x3e, 0x49, 0x3e, 0x08, 0x00, // 5: '$' (cifrão)
+    0x23, 0x13, 0x08, 0x64, 0x62, 0x00, 0x00, 0x00, // 6: '%' (porcento)
+    0x36, 0x49, 0x55, 0x22, 0x50, 0x00, 0x00, 0x00, // 7: '&' (e comercial)
+    0x00, 0x05, 0x03, 0x00, 0x00, 0x00, 0x00, 0x00, // 8: ''' (apóstrofo)
+    0x00, 0x1c, 0x22, 0x41, 0x00, 0x00, 0x00, 0x00, // 9: (
+    0x00, 0x41, 0x22, 0x1c, 0x00, 0x00, 0x00, 0x00, // 10: )
+    0x22, 0x14, 0x7f, 0x14, 0x22, 0x00, 0x00, 0x00, // 11: '*' (asterisco)
+    0x08, 0x08, 0x3e, 0x08, 0x08, 0x00, 0x00, 0x00, // 12: '+' (mais)
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x18, 0x10, // 13: ',' (vírgula)
+    0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x00, // 14: '-' (hífen)
+    0x00, 0x60, 0x60, 0x00, 0x00, 0x00, 0x00, 0x00, // 15: '.' (ponto)
+    0x40, 0x30, 0x0c, 0x03, 0x00, 0x00, 0x00, 0x00, // 16: '/' (barra)
+    0x3e, 0x41, 0x41, 0x49, 0x41, 0x41, 0x3e, 0x00, // 17: 0
+    0x00, 0x00, 0x42, 0x7f, 0x40, 0x00, 0x00, 0x00, // 18: 1
+    0x30, 0x49, 0x49, 0x49, 0x49, 0x46, 0x00, 0x00, // 19: 2
+    0x49, 0x49, 0x49, 0x49, 0x49, 0x49, 0x36, 0x00, // 20: 3
+    0x3f, 0x20, 0x20, 0x78, 0x20, 0x20, 0x00, 0x00, // 21: 4
+    0x4f, 0x49, 0x49, 0x49, 0x49, 0x30, 0x00, 0x00, // 22: 5
+    0x3f, 0x48, 0x48, 0x48, 0x48, 0x48, 0x30, 0x00, // 23: 6
+    0x01, 0x01, 0x01, 0x61, 0x31, 0x0d, 0x03, 0x00, // 24: 7
+    0x36, 0x49, 0x49, 0x49, 0x49, 0x49, 0x36, 0x00, // 25: 8
+    0x06, 0x09, 0x09, 0x09, 0x09, 0x09, 0x7f, 0x00, // 26: 9
+    0x00, 0x36, 0x36, 0x00, 0x00, 0x00, 0x00, 0x00, // 27: ':' (dois pontos)
+    0x00, 0x56, 0x36, 0x00, 0x00, 0x00, 0x00, 0x00, // 28: ';' (ponto e vírgula)
+    0x00, 0x08, 0x14, 0x22, 0x41, 0x00, 0x00, 0x00, // 29: '<' (menor)
+    0x14, 0x14, 0x14, 0x14, 0x14, 0x00, 0x00, 0x00, // 30: '=' (igual)
+    0x00, 0x41, 0x22, 0x14, 0x08, 0x00, 0x00, 0x00, // 31: '>' (maior)
+    0x02, 0x01, 0x59, 0x09, 0x06, 0x00, 0x00, 0x00, // 32: '?' (interrogação)
+    0x3e, 0x41, 0x5d, 0x55, 0x5d, 0x01, 0x3e, 0x00, // 33: '@' (arroba)
+    0x78, 0x14, 0x12, 0x11, 0x12, 0x14, 0x78, 0x00, // 34: A
+    0x7f, 0x49, 0x49, 0x49, 0x49, 0x49, 0x7f, 0x00, // 35: B
+    0x7e, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x00, // 36: C
+    0x7f, 0x41, 0x41, 0x41, 0x41, 0x41, 0x7e, 0x00, // 37: D
+    0x7f, 0x49, 0x49, 0x49, 0x49, 0x49, 0x49, 0x00, // 38: E
+    0x7f, 0x09, 0x09, 0x09, 0x09, 0x01, 0x01, 0x00, // 39: F
+    0x7f, 0x41, 0x41, 0x41, 0x51, 0x51, 0x73, 0x00, // 40: G
+    0x7f, 0x08, 0x08, 0x08, 0x08, 0x08, 0x7f, 0x00, // 41: H
+    0x00, 0x00, 0x00, 0x7f, 0x00, 0x00, 0x00, 0x00, // 42: I
+    0x21, 0x41, 0x41, 0x3f, 0x01, 0x01, 0x01, 0x00, // 43: J
+    0x00, 0x7f, 0x08, 0x08, 0x14, 0x22, 0x41, 0x00, // 44: K
+    0x7f, 0x40, 0x40, 0x40, 0x40, 0x40, 0x40, 0x00, // 45: L
+    0x7f, 0x02, 0x04, 0x08, 0x04, 0x02, 0x7f, 0x00, // 46: M
+    0x7f, 0x02, 0x04, 0x08, 0x10, 0x20, 0x7f, 0x00, // 47: N
+    0x3e, 0x41, 0x41, 0x41, 0x41, 0x41, 0x3e, 0x00, // 48: O
+    0x7f, 0x11, 0x11, 0x11, 0x11, 0x11, 0x0e, 0x00, // 49: P
+    0x3e, 0x41, 0x41, 0x49, 0x51, 0x61, 0x7e, 0x00, // 50: Q
+    0x7f, 0x11, 0x11, 0x11, 0x31, 0x51, 0x0e, 0x00, // 51: R
+    0x46, 0x49, 0x49, 0x49, 0x49, 0x30, 0x00, 0x00, // 52: S
+    0x01, 0x01, 0x01, 0x7f, 0x01, 0x01, 0x01, 0x00, // 53: T
+    0x3f, 0x40, 0x40, 0x40, 0x40, 0x40, 0x3f, 0x00, // 54: U
+    0x0f, 0x10, 0x20, 0x40, 0x20, 0x10, 0x0f, 0x00, // 55: V
+    0x7f, 0x20, 0x10, 0x08, 0x10, 0x20, 0x7f, 0x00, // 56: W
+    0x00, 0x41, 0x22, 0x14, 0x14, 0x22, 0x41, 0x00, // 57: X
+    0x01, 0x02, 0x04, 0x78, 0x04, 0x02, 0x01, 0x00, // 58: Y
+    0x41, 0x61, 0x59, 0x45, 0x43, 0x41, 0x00, 0x00, // 59: Z
+    0x00, 0x7f, 0x41, 0x41, 0x00, 0x00, 0x00, 0x00, // 60: '[' (colchete)
+    0x02, 0x04, 0x08, 0x10, 0x20, 0x00, 0x00, 0x00, // 61: '\' (barra invertida)
+    0x00, 0x41, 0x41, 0x7f, 0x00, 0x00, 0x00, 0x00, // 62: ']' (colchete)
+    0x04, 0x02, 0x01, 0x02, 0x04, 0x00, 0x00, 0x00, // 63: '^' (circunflexo)
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0xff, 0x00, // 64: '_' (sublinhado)
+    0x00, 0x01, 0x02, 0x04, 0x00, 0x00, 0x00, 0x00, // 65: '`' (crase)
+    0x20, 0x54, 0x54, 0x54, 0x78, 0x00, 0x00, 0x00, // 66: a
+    0x7f, 0x48, 0x44, 0x44, 0x38, 0x00, 0x00, 0x00, // 67: b
+    0x38, 0x44, 0x44, 0x44, 0x20, 0x00, 0x00, 0x00, // 68: c
+    0x38, 0x44, 0x44, 0x48, 0x7f, 0x00, 0x00, 0x00, // 69: d
+    0x38, 0x54, 0x54, 0x54, 0x18, 0x00, 0x00, 0x00, // 70: e
+    0x08, 0x7e, 0x09, 0x01, 0x02, 0x00, 0x00, 0x00, // 71: f
+    0x0c, 0x52, 0x52, 0x52, 0x3e, 0x00, 0x00, 0x00, // 72: g
+    0x7f, 0x08, 0x04, 0x04, 0x78, 0x00, 0x00, 0x00, // 73: h
+    0x00, 0x44, 0x7d, 0x40, 0x00, 0x00, 0x00, 0x00, // 74: i
+    0x20, 0x40, 0x44, 0x3d, 0x00, 0x00, 0x00, 0x00, // 75: j
+    0x7f, 0x10, 0x28, 0x44, 0x00, 0x00, 0x00, 0x00, // 76: k
+    0x00, 0x41, 0x7f, 0x40, 0x00, 0x00, 0x00, 0x00, // 77: l
+    0x7c, 0x04, 0x18, 0x04, 0x78, 0x00, 0x00, 0x00, // 78: m
+    0x7c, 0x08, 0x04, 0x04, 0x78, 0x00, 0x00, 0x00, // 79: n
+    0x38, 0x44, 0x44, 0x44, 0x38, 0x00, 0x00, 0x00, // 80: o
+    0x7c, 0x14, 0x14, 0x14, 0x08, 0x00, 0x00, 0x00, // 81: p
+    0x08, 0x14, 0x14, 0x18, 0x7c, 0x00, 0x00, 0x00, // 82: q
+    0x7c, 0x08, 0x04, 0x04, 0x08, 0x00, 0x00, 0x00, // 83: r
+    0x48, 0x54, 0x54, 0x54, 0x20, 0x00, 0x00, 0x00, // 84: s
+    0x04, 0x3f, 0x44, 0x40, 0x20, 0x00, 0x00, 0x00, // 85: t
+    0x3c, 0x40, 0x40, 0x20, 0x7c, 0x00, 0x00, 0x00, // 86: u
+    0x1c, 0x20, 0x40, 0x20, 0x1c, 0x00, 0x00, 0x00, // 87: v
+    0x3c, 0x40, 0x30, 0x40, 0x3c, 0x00, 0x00, 0x00, // 88: w
+    0x44, 0x28, 0x10, 0x28, 0x44, 0x00, 0x00, 0x00, // 89: x
+    0x0c, 0x50, 0x50, 0x50, 0x3c, 0x00, 0x00, 0x00, // 90: y
+    0x44, 0x64, 0x54, 0x4c, 0x44, 0x00, 0x00, 0x00, // 91: z
+    0x00, 0x08, 0x36, 0x41, 0x00, 0x00, 0x00, 0x00, // 92: '{' (chave)
+    0x00, 0x00, 0x7f, 0x00, 0x00, 0x00, 0x00, 0x00, // 93: '|' (barra vertical)
+    0x00, 0x41, 0x36, 0x08, 0x00, 0x00, 0x00, 0x00, // 94: '}' (chave)
+    0x08, 0x04, 0x08, 0x10, 0x08, 0x00, 0x00, 0x00, // 95: '~' (til)
+    0x0e, 0x11, 0x11, 0x0e, 0x00, 0x00, 0x00, 0x00, // 96: '°' (grau, 0xF8)
+};
 
-static uint8_t font[] = {
-    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, // Nothing
-    0x78, 0x14, 0x12, 0x11, 0x12, 0x14, 0x78, 0x00, // A
-    0x7f, 0x49, 0x49, 0x49, 0x49, 0x49, 0x7f, 0x00, // B
-    0x7e, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x00, // C
-    0x7f, 0x41, 0x41, 0x41, 0x41, 0x41, 0x7e, 0x00, // D
-    0x7f, 0x49, 0x49, 0x49, 0x49, 0x49, 0x49, 0x00, // E
-    0x7f, 0x09, 0x09, 0x09, 0x09, 0x01, 0x01, 0x00, // F
-    0x7f, 0x41, 0x41, 0x41, 0x51, 0x51, 0x73, 0x00, // G
-    0x7f, 0x08, 0x08, 0x08, 0x08, 0x08, 0x7f, 0x00, // H
-    0x00, 0x00, 0x00, 0x7f, 0x00, 0x00, 0x00, 0x00, // I
-    0x21, 0x41, 0x41, 0x3f, 0x01, 0x01, 0x01, 0x00, // J
-    0x00, 0x7f, 0x08, 0x08, 0x14, 0x22, 0x41, 0x00, // K
-    0x7f, 0x40, 0x40, 0x40, 0x40, 0x40, 0x40, 0x00, // L
-    0x7f, 0x02, 0x04, 0x08, 0x04, 0x02, 0x7f, 0x00, // M
-    0x7f, 0x02, 0x04, 0x08, 0x10, 0x20, 0x7f, 0x00, // N
-    0x3e, 0x41, 0x41, 0x41, 0x41, 0x41, 0x3e, 0x00, // O
-    0x7f, 0x11, 0x11, 0x11, 0x11, 0x11, 0x0e, 0x00, // P
-    0x3e, 0x41, 0x41, 0x49, 0x51, 0x61, 0x7e, 0x00, // Q
-    0x7f, 0x11, 0x11, 0x11, 0x31, 0x51, 0x0e, 0x00, // R
-    0x46, 0x49, 0x49, 0x49, 0x49, 0x30, 0x00, 0x00, // S
-    0x01, 0x01, 0x01, 0x7f, 0x01, 0x01, 0x01, 0x00, // T
-    0x3f, 0x40, 0x40, 0x40, 0x40, 0x40, 0x3f, 0x00, // U
-    0x0f, 0x10, 0x20, 0x40, 0x20, 0x10, 0x0f, 0x00, // V
-    0x7f, 0x20, 0x10, 0x08, 0x10, 0x20, 0x7f, 0x00, // W
-    0x00, 0x41, 0x22, 0x14, 0x14, 0x22, 0x41, 0x00, // X
-    0x01, 0x02, 0x04, 0x78, 0x04, 0x02, 0x01, 0x00, // Y
-    0x41, 0x61, 0x59, 0x45, 0x43, 0x41, 0x00, 0x00, // Z
-    0x3e, 0x41, 0x41, 0x49, 0x41, 0x41, 0x3e, 0x00, // 0
-    0x00, 0x00, 0x42, 0x7f, 0x40, 0x00, 0x00, 0x00, // 1
-    0x30, 0x49, 0x49, 0x49, 0x49, 0x46, 0x00, 0x00, // 2
-    0x49, 0x49, 0x49, 0x49, 0x49, 0x49, 0x36, 0x00, // 3
-    0x3f, 0x20, 0x20, 0x78, 0x20, 0x20, 0x00, 0x00, // 4
-    0x4f, 0x49, 0x49, 0x49, 0x49, 0x30, 0x00, 0x00, // 5
-    0x3f, 0x48, 0x48, 0x48, 0x48, 0x48, 0x30, 0x00, // 6
-    0x01, 0x01, 0x01, 0x61, 0x31, 0x0d, 0x03, 0x00, // 7
-    0x36, 0x49, 0x49, 0x49, 0x49, 0x49, 0x36, 0x00, // 8
-    0x06, 0x09, 0x09, 0x09, 0x09, 0x09, 0x7f, 0x00, // 9
-    0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x00,// posição 37: '-' (hífen)
-    0x08, 0x08, 0x3E, 0x08, 0x08, 0x00, 0x00, 0x00,// posição 38: '+' (mais)
-    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0xFF, 0x00,// posição 39: '_' (sublinhado)
-    0x22, 0x14, 0x7F, 0x14, 0x22, 0x00, 0x00, 0x00,// posição 40: '*' (asterisco)
-    0x08, 0x3E, 0x49, 0x3E, 0x49, 0x3E, 0x08, 0x00,// posição 41: '$' (cifrão)
-    0x14, 0x14, 0x7F, 0x14, 0x7F, 0x14, 0x14, 0x00,// posição 42: '#' (jogo da velha)
-    0x00, 0x41, 0x22, 0x14, 0x08, 0x00, 0x00, 0x00,// posição 43: '>' (maior)
-    0x00, 0x08, 0x14, 0x22, 0x41, 0x00, 0x00, 0x00,// posição 44: '<' (menor)
-    0x00, 0x1C, 0x22, 0x41, 0x00, 0x00, 0x00, 0x00,// posição 45: '('
-    0x00, 0x41, 0x22, 0x1C, 0x00, 0x00, 0x00, 0x00,// posição 46: ')'
-    0x00, 0x00, 0x7D, 0x00, 0x00, 0x00, 0x00, 0x00,// posição 47: '!' (exclamação)
-    0x3E, 0x41, 0x5D, 0x55, 0x5D, 0x01, 0x3E, 0x00,// posição 48: '@' (arroba)
-    0x02, 0x01, 0x59, 0x09, 0x06, 0x00, 0x00, 0x00,// posição 49: '?' (interrogação)
-    0x40, 0x30, 0x0C, 0x03, 0x00, 0x00, 0x00, 0x00,// posição 50: '/' (barra)
-};
\ No newline at end of file
+// Geração de tabelas de 256 entradas pelo pré-processador (em tempo de compilação, ficam em flash)
+#define font_table_4(f, n) f(n), f((n) + 1), f((n) + 2), f((n) + 3)
+#define font_table_16(f, n) font_table_4(f, n), font_table_4(f, (n) + 4), font_table_4(f, (n) + 8), font_table_4(f, (n) + 12)
+#define font_table_64(f, n) font_table_16(f, n), font_table_16(f, (n) + 16), font_table_16(f, (n) + 32), font_table_16(f, (n) + 48)
+#define font_table_256(f) font_table_64(f, 0), font_table_64(f, 64), font_table_64(f, 128), font_table_64(f, 192)
+
+// Índice do glifo de cada código de caractere (0 = sem glifo)
+#define font_index_of(c) ((c) >= 0x20 && (c) <= 0x7E ? (c) - 0x20 + 1 : (c) == 0xF8 ? 96 : 0)
+
+static const uint8_t font_index[256] = { font_table_256(font_index_of) };
+
+// Tabelas de ampliação vertical: cada bit de uma coluna da fonte vira 2 (ou 3) bits consecutivos
+#define font_scale2_bits(b) ( \
+    (((b) & 0x01) ? 0x0003u : 0) | (((b) & 0x02) ? 0x000Cu : 0) | \
+    (((b) & 0x04) ? 0x0030u : 0) | (((b) & 0x08) ? 0x00C0u : 0) | \
+    (((b) & 0x10) ? 0x0300u : 0) | (((b) & 0x20) ? 0x0C00u : 0) | \
+    (((b) & 0x40) ? 0x3000u : 0) | (((b) & 0x80) ? 0xC000u : 0))
+
+#define font_scale3_bits(b) ( \
+    (((b) & 0x01) ? 0x000007u : 0) | (((b) & 0x02) ? 0x000038u : 0) | \
+    (((b) & 0x04) ? 0x0001C0u : 0) | (((b) & 0x08) ? 0x000E00u : 0) | \
+    (((b) & 0x10) ? 0x007000u : 0) | (((b) & 0x20) ? 0x038000u : 0) | \
+    (((b) & 0x40) ? 0x1C0000u : 0) | (((b) & 0x80) ? 0xE00000u : 0))
+
+static const uint16_t font_scale2[256] = { font_table_256(font_scale2_bits) };
+static const uint32_t font_scale3[256] = { font_table_256(font_scale3_bits) };
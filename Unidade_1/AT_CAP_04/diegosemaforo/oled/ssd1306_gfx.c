@@ -0,0 +1,383 @@
+#include <string.h>
+#include <stdlib.h>
+#include <assert.h>
+#include "ssd1306_gfx.h"
+#include "font.h"
+
+// Calcular quanto do buffer será destinado à área de renderização
+void calculate_render_area_buffer_length(struct render_area *area) {
+    area->buffer_length = (area->end_column - area->start_column + 1) * (area->end_page - area->start_page + 1);
+}
+
+// Compara o buffer da tela inteira com shadow (o conteúdo atual do display) e preenche windows com as janelas
+// que precisam ser reenviadas: em cada página, o intervalo de colunas alteradas. Páginas vizinhas são unidas
+// numa só janela quando isso custa menos bytes que abrir outra (window_overhead, em bytes no barramento).
+// windows deve ter espaço para ssd1306_n_pages janelas; retorna quantas foram preenchidas
+int ssd1306_find_changed_windows(const uint8_t *ssd, const uint8_t *shadow, int window_overhead, struct render_area *windows) {
+    struct render_area *window = NULL;
+    int count = 0;
+
+    for (int page = 0; page < ssd1306_n_pages; page++) {
+        const uint8_t *row = ssd + page * ssd1306_width;
+        const uint8_t *old = shadow + page * ssd1306_width;
+        int first = 0;
+        int last = ssd1306_width - 1;
+
+        while (first <= last && row[first] == old[first]) {
+            first++;
+        }
+        while (last >= first && row[last] == old[last]) {
+            last--;
+        }
+
+        if (first > last) {
+            window = NULL; // Página sem alterações encerra a janela pendente
+            continue;
+        }
+
+        if (window) {
+            int pages = window->end_page - window->start_page + 1;
+            int merged_first = first < window->start_column ? first : window->start_column;
+            int merged_last = last > window->end_column ? last : window->end_column;
+            int merged_cost = (merged_last - merged_first + 1) * (pages + 1);
+            int split_cost = (window->end_column - window->start_column + 1) * pages
+                           + window_overhead + (last - first + 1);
+
+            if (merged_cost <= split_cost) {
+                window->start_column = merged_first;
+                window->end_column = merged_last;
+                window->end_page = page;
+                calculate_render_area_buffer_length(window);
+                continue;
+            }
+        }
+
+        window = &windows[count++];
+        window->start_column = first;
+        window->end_column = last;
+        window->start_page = page;
+        window->end_page = page;
+        calculate_render_area_buffer_length(window);
+    }
+
+    return count;
+}
+
+// Determina o pixel a ser aceso (no display) de acordo com a coordenada fornecida
+void ssd1306_set_pixel(uint8_t *ssd, int x, int y, bool set) {
+    assert(x >= 0 && x < ssd1306_width && y >= 0 && y < ssd1306_height);
+
+    const int bytes_per_row = ssd1306_width;
+
+    int byte_idx = (y / 8) * bytes_per_row + x;
+    uint8_t byte = ssd[byte_idx];
+
+    if (set) {
+        byte |= 1 << (y % 8);
+    }
+    else {
+        byte &= ~(1 << (y % 8));
+    }
+
+    ssd[byte_idx] = byte;
+}
+
+// Máscara dos bits da página cobertos pelas linhas y_0..y_1 (inclusive)
+static inline uint8_t ssd1306_page_span_mask(int page, int y_0, int y_1) {
+    int top = y_0 - page * 8;
+    int bottom = y_1 - page * 8;
+    uint8_t mask = 0xFF;
+
+    if (top > 0) {
+        mask &= (uint8_t)(0xFF << top);
+    }
+    if (bottom < 7) {
+        mask &= (uint8_t)(0xFF >> (7 - bottom));
+    }
+
+    return mask;
+}
+
+// Acende ou apaga os bits de mask em count bytes consecutivos de uma página
+static inline void ssd1306_mask_columns(uint8_t *row, int count, uint8_t mask, bool set) {
+    if (mask == 0xFF) {
+        memset(row, set ? 0xFF : 0x00, count);
+    }
+    else if (set) {
+        for (int i = 0; i < count; i++) {
+            row[i] |= mask;
+        }
+    }
+    else {
+        for (int i = 0; i < count; i++) {
+            row[i] &= ~mask;
+        }
+    }
+}
+
+// Preenche (ou apaga) o retângulo w x h em (x, y), com recorte nas bordas:
+// uma máscara por página, aplicada a bytes inteiros em vez de pixel a pixel
+void ssd1306_fill_rect(uint8_t *ssd, int x, int y, int w, int h, bool set) {
+    int x_0 = x < 0 ? 0 : x;
+    int x_1 = x + w > ssd1306_width ? ssd1306_width : x + w;
+    int y_0 = y < 0 ? 0 : y;
+    int y_1 = (y + h > ssd1306_height ? ssd1306_height : y + h) - 1;
+
+    if (x_0 >= x_1 || y_0 > y_1) {
+        return;
+    }
+
+    for (int page = y_0 / 8; page <= y_1 / 8; page++) {
+        ssd1306_mask_columns(ssd + page * ssd1306_width + x_0, x_1 - x_0, ssd1306_page_span_mask(page, y_0, y_1), set);
+    }
+}
+
+// Contorno de 1 pixel do retângulo w x h em (x, y)
+void ssd1306_draw_rect(uint8_t *ssd, int x, int y, int w, int h, bool set) {
+    if (w <= 0 || h <= 0) {
+        return;
+    }
+
+    ssd1306_fill_rect(ssd, x, y, w, 1, set);
+    ssd1306_fill_rect(ssd, x, y + h - 1, w, 1, set);
+    ssd1306_fill_rect(ssd, x, y, 1, h, set);
+    ssd1306_fill_rect(ssd, x + w - 1, y, 1, h, set);
+}
+
+// Linha horizontal de x_0 a x_1 (inclusive): a mesma máscara em bytes consecutivos
+void ssd1306_draw_hline(uint8_t *ssd, int x_0, int x_1, int y, bool set) {
+    if (x_0 > x_1) {
+        int swap = x_0;
+        x_0 = x_1;
+        x_1 = swap;
+    }
+
+    ssd1306_fill_rect(ssd, x_0, y, x_1 - x_0 + 1, 1, set);
+}
+
+// Linha vertical de y_0 a y_1 (inclusive): um byte por página
+void ssd1306_draw_vline(uint8_t *ssd, int x, int y_0, int y_1, bool set) {
+    if (y_0 > y_1) {
+        int swap = y_0;
+        y_0 = y_1;
+        y_1 = swap;
+    }
+
+    ssd1306_fill_rect(ssd, x, y_0, 1, y_1 - y_0 + 1, set);
+}
+
+// Algoritmo de Bresenham básico (linhas horizontais e verticais usam as rotinas por byte)
+void ssd1306_draw_line(uint8_t *ssd, int x_0, int y_0, int x_1, int y_1, bool set) {
+    if (y_0 == y_1) {
+        ssd1306_draw_hline(ssd, x_0, x_1, y_0, set);
+        return;
+    }
+    if (x_0 == x_1) {
+        ssd1306_draw_vline(ssd, x_0, y_0, y_1, set);
+        return;
+    }
+
+    int dx = abs(x_1 - x_0); // Deslocamentos
+    int dy = -abs(y_1 - y_0);
+    int sx = x_0 < x_1 ? 1 : -1; // Direção de avanço
+    int sy = y_0 < y_1 ? 1 : -1;
+    int error = dx + dy; // Erro acumulado
+    int error_2;
+
+    while (true) {
+        ssd1306_set_pixel(ssd, x_0, y_0, set); // Acende pixel no ponto atual
+        if (x_0 == x_1 && y_0 == y_1) {
+            break; // Verifica se o ponto final foi alcançado
+        }
+
+        error_2 = 2 * error; // Ajusta o erro acumulado
+
+        if (error_2 >= dy) {
+            error += dy;
+            x_0 += sx; // Avança na direção x
+        }
+        if (error_2 <= dx) {
+            error += dx;
+            y_0 += sy; // Avança na direção y
+        }
+    }
+}
+
+// Combina um byte de origem com o byte do buffer, apenas nos bits de mask
+static inline uint8_t ssd1306_blit_byte(uint8_t dst, uint8_t src, uint8_t mask, ssd1306_blit_mode_t mode) {
+    switch (mode) {
+        case ssd1306_blit_or: return dst | (src & mask);
+        case ssd1306_blit_clear: return dst & ~(src & mask);
+        case ssd1306_blit_xor: return dst ^ (src & mask);
+        default: return (dst & ~mask) | (src & mask);
+    }
+}
+
+// Copia um bitmap (w x h pixels, organizado em páginas como o buffer do display: bitmap[pagina * w + coluna],
+// bit 0 no topo) para a posição (x, y) de ssd, com qualquer deslocamento em pixels.
+// Cada byte de origem é dividido entre duas páginas de destino com deslocamento/máscara, com recorte nas bordas
+void ssd1306_blit_bitmap(uint8_t *ssd, int x, int y, const uint8_t *bitmap, int w, int h, ssd1306_blit_mode_t mode) {
+    int src_pages = (h + 7) / 8;
+    int dst_page = y < 0 ? (y - 7) / 8 : y / 8;
+    int shift = y - dst_page * 8;
+    int col_first = x < 0 ? -x : 0;
+    int col_last = x + w > ssd1306_width ? ssd1306_width - x : w;
+
+    for (int page = 0; page < src_pages; page++) {
+        // Linhas válidas da página de origem (a última pode estar incompleta)
+        uint8_t rows = (page == src_pages - 1 && (h & 7)) ? (uint8_t)((1u << (h & 7)) - 1) : 0xFF;
+        int upper = dst_page + page;
+        int lower = upper + 1;
+        uint8_t upper_mask = (uint8_t)(rows << shift);
+        uint8_t lower_mask = shift ? (uint8_t)(rows >> (8 - shift)) : 0;
+        bool upper_visible = upper >= 0 && upper < ssd1306_n_pages && upper_mask;
+        bool lower_visible = lower >= 0 && lower < ssd1306_n_pages && lower_mask;
+
+        if (!upper_visible && !lower_visible) {
+            continue;
+        }
+
+        const uint8_t *src = bitmap + page * w;
+        uint8_t *dst_upper = upper_visible ? ssd + upper * ssd1306_width + x : NULL;
+        uint8_t *dst_lower = lower_visible ? ssd + lower * ssd1306_width + x : NULL;
+
+        for (int col = col_first; col < col_last; col++) {
+            uint8_t bits = src[col];
+
+            if (upper_visible) {
+                dst_upper[col] = ssd1306_blit_byte(dst_upper[col], (uint8_t)(bits << shift), upper_mask, mode);
+            }
+            if (lower_visible) {
+                dst_lower[col] = ssd1306_blit_byte(dst_lower[col], (uint8_t)(bits >> (8 - shift)), lower_mask, mode);
+            }
+        }
+    }
+}
+
+// Adquire o glifo de um caractere (tabela de índices de font.h, sem conversão de maiúsculas)
+static inline int ssd1306_get_font(uint8_t character) {
+    return font_index[character];
+}
+
+// Largura, em pixels, de uma string desenhada com a escala indicada (todos os glifos avançam 8 * scale)
+int ssd1306_measure_string(const char *string, int scale) {
+    return (int)strlen(string) * ssd1306_char_advance * scale;
+}
+
+// Desenha um único caractere no display, em qualquer linha y (não apenas em múltiplos de 8).
+// A célula 8x8 é substituída, como na versão alinhada a páginas, e recortada nas bordas
+void ssd1306_draw_char(uint8_t *ssd, int16_t x, int16_t y, uint8_t character) {
+    int idx = ssd1306_get_font(character);
+
+    ssd1306_blit_bitmap(ssd, x, y, &font[idx * 8], 8, 8, ssd1306_blit_copy);
+}
+
+// Desenha um caractere ampliado (escala 1 a 3) sobre o conteúdo do buffer.
+// Cada coluna da fonte é expandida pelas tabelas font_scale2/font_scale3 (geradas em compilação a partir de font.h)
+// e repetida scale vezes, formando o glifo ampliado que é copiado de uma vez com ssd1306_blit_bitmap
+void ssd1306_draw_char_scaled(uint8_t *ssd, int16_t x, int16_t y, uint8_t character, int scale) {
+    uint8_t glyph[3 * 8 * 3]; // Até 24 colunas x 3 páginas
+    int width = 8 * scale;
+
+    if (scale < 1 || scale > 3) {
+        return;
+    }
+
+    int idx = ssd1306_get_font(character);
+
+    for (int col = 0; col < 8; col++) {
+        uint8_t bits = font[idx * 8 + col];
+        uint32_t column = scale == 3 ? font_scale3[bits] : scale == 2 ? font_scale2[bits] : bits;
+
+        for (int page = 0; page < scale; page++) {
+            uint8_t *dst = glyph + page * width + col * scale;
+
+            for (int i = 0; i < scale; i++) {
+                dst[i] = (uint8_t)(column >> (page * 8));
+            }
+        }
+    }
+
+    ssd1306_blit_bitmap(ssd, x, y, glyph, width, 8 * scale, ssd1306_blit_or);
+}
+
+//Escala2x
+void ssd1306_draw_char_scale2(uint8_t *ssd, int16_t x, int16_t y, uint8_t character) {
+    // Ajuste especial para vírgula e ponto - descer 1 pixel
+    bool is_comma = (character == 0x2C);
+    int y_offset = is_comma ? 6 : 0;
+
+    ssd1306_draw_char_scaled(ssd, x, y + y_offset, character, 2);
+}
+
+void ssd1306_draw_string_scale2(uint8_t *ssd, int16_t x, int16_t y, const char *string) {
+    while (*string) {
+        ssd1306_draw_char_scale2(ssd, x, y, *string++);
+        x += 2 * ssd1306_char_advance;  // avança a largura do caractere ampliado
+    }
+}
+
+// Desenha uma string ampliada (escala 1 a 3)
+void ssd1306_draw_string_scaled(uint8_t *ssd, int16_t x, int16_t y, const char *string, int scale) {
+    while (*string) {
+        ssd1306_draw_char_scaled(ssd, x, y, *string++, scale);
+        x += ssd1306_char_advance * scale;
+    }
+}
+
+// Desenha uma string, chamando a função de desenhar caractere várias vezes
+void ssd1306_draw_string(uint8_t *ssd, int16_t x, int16_t y, const char *string) {
+    while (*string && x < ssd1306_width) {
+        ssd1306_draw_char(ssd, x, y, *string++);
+        x += ssd1306_char_advance;
+    }
+}
+
+// Converte value (limitado a min..max) para 0..range pixels
+static int ssd1306_scale_value(int value, int min, int max, int range) {
+    if (max <= min || value <= min) {
+        return 0;
+    }
+    if (value >= max) {
+        return range;
+    }
+
+    return (value - min) * range / (max - min);
+}
+
+// Gráfico de barras na área w x h em (x, y): apaga a área e desenha count barras (valores de min a max),
+// com 1 pixel de espaço entre elas quando couber
+void ssd1306_draw_bar_graph(uint8_t *ssd, int x, int y, int w, int h, const int16_t *values, int count, int min, int max) {
+    ssd1306_fill_rect(ssd, x, y, w, h, false);
+
+    for (int i = 0; i < count; i++) {
+        int left = x + i * w / count;
+        int width = x + (i + 1) * w / count - left;
+        int height = ssd1306_scale_value(values[i], min, max, h);
+
+        if (width > 2) {
+            width--;
+        }
+        ssd1306_fill_rect(ssd, left, y + h - height, width, height, true);
+    }
+}
+
+// Sparkline na área w x h em (x, y): apaga a área e liga as amostras (valores de min a max), uma por coluna,
+// com segmentos verticais; com mais de w amostras mostra as w mais recentes
+void ssd1306_draw_sparkline(uint8_t *ssd, int x, int y, int w, int h, const int16_t *values, int count, int min, int max) {
+    ssd1306_fill_rect(ssd, x, y, w, h, false);
+
+    if (count > w) {
+        values += count - w;
+        count = w;
+    }
+
+    int previous = -1;
+
+    for (int i = 0; i < count; i++) {
+        int row = y + h - 1 - ssd1306_scale_value(values[i], min, max, h - 1);
+
+        ssd1306_draw_vline(ssd, x + i, previous < 0 ? row : previous, row, true);
+        previous = row;
+    }
+}
@@ -0,0 +1,54 @@
+#include <stdint.h>
+#include <stdbool.h>
+
+#ifndef ssd1306_gfx_inc_h
+#define ssd1306_gfx_inc_h
+
+// Desenho no buffer do display (organizado em páginas de 8 linhas), sem dependência do transporte:
+// compila tanto no RP2040 quanto no computador (ver ssd1306_host.h)
+
+#define ssd1306_height 64 // Define a altura do display (32 pixels)
+#define ssd1306_width 128 // Define a largura do display (128 pixels)
+
+#define ssd1306_page_height 8
+#define ssd1306_char_advance 8 // Avanço horizontal de cada glifo da fonte, em pixels
+#define ssd1306_n_pages (ssd1306_height / ssd1306_page_height)
+#define ssd1306_buffer_length (ssd1306_n_pages * ssd1306_width)
+
+struct render_area {
+    uint8_t start_column;
+    uint8_t end_column;
+    uint8_t start_page;
+    uint8_t end_page;
+
+    int buffer_length;
+};
+
+// Forma de combinar um bitmap com o conteúdo do buffer
+typedef enum {
+    ssd1306_blit_copy,  // Substitui os pixels do retângulo
+    ssd1306_blit_or,    // Acende os pixels acesos do bitmap
+    ssd1306_blit_clear, // Apaga os pixels acesos do bitmap
+    ssd1306_blit_xor    // Inverte os pixels acesos do bitmap
+} ssd1306_blit_mode_t;
+
+extern void calculate_render_area_buffer_length(struct render_area *area);
+extern int ssd1306_find_changed_windows(const uint8_t *ssd, const uint8_t *shadow, int window_overhead, struct render_area *windows);
+extern void ssd1306_set_pixel(uint8_t *ssd, int x, int y, bool set);
+extern void ssd1306_draw_line(uint8_t *ssd, int x_0, int y_0, int x_1, int y_1, bool set);
+extern void ssd1306_draw_hline(uint8_t *ssd, int x_0, int x_1, int y, bool set);
+extern void ssd1306_draw_vline(uint8_t *ssd, int x, int y_0, int y_1, bool set);
+extern void ssd1306_fill_rect(uint8_t *ssd, int x, int y, int w, int h, bool set);
+extern void ssd1306_draw_rect(uint8_t *ssd, int x, int y, int w, int h, bool set);
+extern void ssd1306_blit_bitmap(uint8_t *ssd, int x, int y, const uint8_t *bitmap, int w, int h, ssd1306_blit_mode_t mode);
+extern int ssd1306_measure_string(const char *string, int scale);
+extern void ssd1306_draw_char(uint8_t *ssd, int16_t x, int16_t y, uint8_t character);
+extern void ssd1306_draw_string(uint8_t *ssd, int16_t x, int16_t y, const char *string);
+extern void ssd1306_draw_char_scale2(uint8_t *ssd, int16_t x, int16_t y, uint8_t character);
+extern void ssd1306_draw_string_scale2(uint8_t *ssd, int16_t x, int16_t y, const char *string);
+extern void ssd1306_draw_char_scaled(uint8_t *ssd, int16_t x, int16_t y, uint8_t character, int scale);
+extern void ssd1306_draw_string_scaled(uint8_t *ssd, int16_t x, int16_t y, const char *string, int scale);
+extern void ssd1306_draw_bar_graph(uint8_t *ssd, int x, int y, int w, int h, const int16_t *values, int count, int min, int max);
+extern void ssd1306_draw_sparkline(uint8_t *ssd, int x, int y, int w, int h, const int16_t *values, int count, int min, int max);
+
+#endif
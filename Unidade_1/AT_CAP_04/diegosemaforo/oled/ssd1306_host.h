@@ -0,0 +1,60 @@
+#include <stdio.h>
+#include "ssd1306_gfx.h"
+
+#ifndef ssd1306_host_inc_h
+#define ssd1306_host_inc_h
+
+// Backend de computador para o display: substitui ssd1306_i2c.c (mesmas funções de renderização),
+// guardando a imagem do painel em memória e gravando-a em arquivos PBM.
+// Permite executar e comparar o código de desenho numa máquina Linux comum, sem a placa.
+// A contagem de bytes segue o enquadramento de ssd1306_i2c.c, transação por transação:
+//   I2C (bloco ou PIO): endereço + byte de controle (0x00 comandos, 0x40 dados) + bytes
+//   SPI por PIO: só os bytes (o controle vira o nível de D/C)
+// Uma janela é uma transação com os 6 comandos de endereço seguida da transação dos dados
+
+#define ssd1306_host_i2c_framing 2  // Endereço e byte de controle de cada transação I2C
+#define ssd1306_host_window_commands 6
+#define ssd1306_host_max_command_list 32 // Comandos por transação, como ssd1306_max_command_list
+
+// Transporte simulado (só muda o enquadramento contado)
+typedef enum {
+    ssd1306_host_i2c,
+    ssd1306_host_spi
+} ssd1306_host_transport_t;
+
+// Instância de um display simulado, com a mesma parte pública de ssd1306_t do transporte I2C
+typedef struct ssd1306 {
+  uint8_t width, height, pages;
+  uint8_t *ram_buffer;
+  size_t bufsize;
+
+  uint8_t framebuffer[ssd1306_buffer_length];
+
+  // Conteúdo atual do painel simulado e contagem do que o transporte teria colocado no barramento
+  ssd1306_host_transport_t transport;
+  uint8_t panel[ssd1306_buffer_length];
+  bool panel_valid;
+  uint32_t bytes_sent;
+  uint32_t transactions;
+} ssd1306_t;
+
+// Inicializa e envia a configuração (ssd1306_config), como ssd1306_init do transporte I2C
+extern void ssd1306_init(ssd1306_t *ssd);
+extern void ssd1306_host_set_transport(ssd1306_t *ssd, ssd1306_host_transport_t transport);
+extern int ssd1306_host_window_overhead(const ssd1306_t *ssd);
+extern void ssd1306_send_command_list(ssd1306_t *ssd, const uint8_t *commands, int number);
+extern void ssd1306_command(ssd1306_t *ssd, uint8_t command);
+extern void ssd1306_config(ssd1306_t *ssd);
+extern void ssd1306_scroll(ssd1306_t *ssd, bool set);
+extern void ssd1306_clear(ssd1306_t *ssd);
+extern void render_on_display(ssd1306_t *ssd, struct render_area *area);
+extern void ssd1306_send_data(ssd1306_t *ssd);
+extern void render_changes_on_display(ssd1306_t *ssd);
+extern uint32_t ssd1306_get_bytes_sent(ssd1306_t *ssd);
+extern void ssd1306_reset_bytes_sent(ssd1306_t *ssd);
+extern const uint8_t *ssd1306_host_panel(ssd1306_t *ssd);
+extern bool ssd1306_write_pbm(const uint8_t *ssd, FILE *file);
+extern bool ssd1306_save_pbm(const uint8_t *ssd, const char *path);
+extern bool ssd1306_load_pbm(uint8_t *ssd, const char *path);
+
+#endif
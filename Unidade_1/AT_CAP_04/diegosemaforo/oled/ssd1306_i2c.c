@@ -1,288 +1,440 @@
 #include <stdio.h>
 #include <string.h>
 #include <stdlib.h>
-#include <ctype.h>
+#include <assert.h>
 #include "pico/stdlib.h"
 #include "pico/binary_info.h"
 #include "hardware/i2c.h"
-#include "font.h"
+#include "hardware/dma.h"
+#include "hardware/irq.h"
+#include "hardware/pio.h"
 #include "ssd1306_i2c.h"
+#include "ssd1306.pio.h"
 
-// Calcular quanto do buffer será destinado à área de renderização
-void calculate_render_area_buffer_length(struct render_area *area) {
-    area->buffer_length = (area->end_column - area->start_column + 1) * (area->end_page - area->start_page + 1);
+// Display dono de cada canal DMA, para o handler (compartilhado) da interrupção encontrar a instância
+static ssd1306_t *ssd1306_dma_owner[NUM_DMA_CHANNELS];
+static bool ssd1306_irq_installed = false;
+
+// Endereço de cada programa (I2C, SPI) já carregado em cada bloco PIO, compartilhado entre displays
+static uint ssd1306_pio_offsets[NUM_PIOS][2];
+static bool ssd1306_pio_loaded[NUM_PIOS][2];
+
+uint32_t ssd1306_get_bytes_sent(ssd1306_t *ssd) {
+    return ssd->bytes_sent;
 }
 
-// Processo de escrita do i2c espera um byte de controle, seguido por dados
-void ssd1306_send_command(uint8_t command) {
-    uint8_t buffer[2] = {0x80, command};
-    i2c_write_blocking(i2c1, ssd1306_i2c_address, buffer, 2, false);
+void ssd1306_reset_bytes_sent(ssd1306_t *ssd) {
+    ssd->bytes_sent = 0;
 }
 
-// Envia uma lista de comandos ao hardware
-void ssd1306_send_command_list(uint8_t *ssd, int number) {
-    for (int i = 0; i < number; i++) {
-        ssd1306_send_command(ssd[i]);
+// Interrupção do DMA: o último byte da fila de algum display entrou no FIFO do I2C
+static void ssd1306_dma_irq_handler() {
+    for (uint chan = 0; chan < NUM_DMA_CHANNELS; chan++) {
+        ssd1306_t *ssd = ssd1306_dma_owner[chan];
+
+        if (!ssd || !dma_channel_get_irq0_status(chan)) {
+            continue; // Canal de outro uso (o handler é compartilhado)
+        }
+        dma_channel_acknowledge_irq0(chan);
+
+        if (ssd->frame_done_cb) {
+            ssd->frame_done_cb(ssd, ssd->frame_done_user_data);
+        }
     }
 }
 
-// Copia buffer de referência num novo buffer, a fim de adicionar o byte de controle desde o início
-void ssd1306_send_buffer(uint8_t ssd[], int buffer_length) {
-    uint8_t *temp_buffer = malloc(buffer_length + 1);
+// Reserva o canal DMA que alimenta o FIFO de transmissão (I2C ou state machine PIO) deste display
+static void ssd1306_dma_init(ssd1306_t *ssd, uint dreq, volatile void *fifo) {
+    ssd->dma_chan = dma_claim_unused_channel(true);
+    ssd1306_dma_owner[ssd->dma_chan] = ssd;
 
-    temp_buffer[0] = 0x40;
-    memcpy(temp_buffer + 1, ssd, buffer_length);
+    dma_channel_config config = dma_channel_get_default_config(ssd->dma_chan);
+    channel_config_set_transfer_data_size(&config, DMA_SIZE_16);
+    channel_config_set_read_increment(&config, true);
+    channel_config_set_write_increment(&config, false);
+    channel_config_set_dreq(&config, dreq);
 
-    i2c_write_blocking(i2c1, ssd1306_i2c_address, temp_buffer, buffer_length + 1, false);
+    dma_channel_configure(ssd->dma_chan, &config, fifo, NULL, 0, false);
 
-    free(temp_buffer);
+    dma_channel_set_irq0_enabled(ssd->dma_chan, true);
+    if (!ssd1306_irq_installed) {
+        irq_add_shared_handler(DMA_IRQ_0, ssd1306_dma_irq_handler, PICO_SHARED_IRQ_HANDLER_DEFAULT_ORDER_PRIORITY);
+        irq_set_enabled(DMA_IRQ_0, true);
+        ssd1306_irq_installed = true;
+    }
 }
 
-// Cria a lista de comandos (com base nos endereços definidos em ssd1306_i2c.h) para a inicialização do display
-void ssd1306_init() {
-    uint8_t commands[] = {
-        ssd1306_set_display, ssd1306_set_memory_mode, 0x00,
-        ssd1306_set_display_start_line, ssd1306_set_segment_remap | 0x01, 
-        ssd1306_set_mux_ratio, ssd1306_height - 1,
-        ssd1306_set_common_output_direction | 0x08, ssd1306_set_display_offset,
-        0x00, ssd1306_set_common_pin_configuration,
-    
-#if ((ssd1306_width == 128) && (ssd1306_height == 32))
-    0x02,
-#elif ((ssd1306_width == 128) && (ssd1306_height == 64))
-    0x12,
-#else
-    0x02,
-#endif
-        ssd1306_set_display_clock_divide_ratio, 0x80, ssd1306_set_precharge,
-        0xF1, ssd1306_set_vcomh_deselect_level, 0x30, ssd1306_set_contrast,
-        0xFF, ssd1306_set_entire_on, ssd1306_set_normal_display,
-        ssd1306_set_charge_pump, 0x14, ssd1306_set_scroll | 0x00,
-        ssd1306_set_display | 0x01,
-    };
-
-    ssd1306_send_command_list(commands, count_of(commands));
+// Registra uma função chamada (em contexto de interrupção) quando o DMA termina de entregar uma fila
+void ssd1306_set_frame_done_callback(ssd1306_t *ssd, ssd1306_frame_done_callback_t callback, void *user_data) {
+    ssd->frame_done_user_data = user_data;
+    ssd->frame_done_cb = callback;
 }
 
-// Cria a lista de comandos para configurar o scrolling
-void ssd1306_scroll(bool set) {
-    uint8_t commands[] = {
-        ssd1306_set_horizontal_scroll | 0x00, 0x00, 0x00, 0x00, 0x03,
-        0x00, 0xFF, ssd1306_set_scroll | (set ? 0x01 : 0)
-    };
-
-    ssd1306_send_command_list(commands, count_of(commands));
-}
+// Indica se ainda há uma fila sendo enviada ao display
+bool ssd1306_frame_busy(ssd1306_t *ssd) {
+    if (dma_channel_is_busy(ssd->dma_chan)) {
+        return true;
+    }
 
-// Atualiza uma parte do display com uma área de renderização
-void render_on_display(uint8_t *ssd, struct render_area *area) {
-    uint8_t commands[] = {
-        ssd1306_set_column_address, area->start_column, area->end_column,
-        ssd1306_set_page_address, area->start_page, area->end_page
-    };
+    if (ssd->transport != ssd1306_transport_i2c) {
+        // Ocioso: FIFO vazio e o programa parado na primeira instrução, esperando a próxima palavra
+        return !pio_sm_is_tx_fifo_empty(ssd->pio, ssd->sm) || pio_sm_get_pc(ssd->pio, ssd->sm) != ssd->pio_offset;
+    }
 
-    ssd1306_send_command_list(commands, count_of(commands));
-    ssd1306_send_buffer(ssd, area->buffer_length);
+    return i2c_get_hw(ssd->i2c_port)->status & I2C_IC_STATUS_ACTIVITY_BITS;
 }
 
-// Determina o pixel a ser aceso (no display) de acordo com a coordenada fornecida
-void ssd1306_set_pixel(uint8_t *ssd, int x, int y, bool set) {
-    assert(x >= 0 && x < ssd1306_width && y >= 0 && y < ssd1306_height);
-
-    const int bytes_per_row = ssd1306_width;
+// Espera o DMA esvaziar e o transporte terminar a última palavra da fila anterior, liberando o barramento deste display
+void ssd1306_wait_frame(ssd1306_t *ssd) {
+    dma_channel_wait_for_finish_blocking(ssd->dma_chan);
 
-    int byte_idx = (y / 8) * bytes_per_row + x;
-    uint8_t byte = ssd[byte_idx];
+    if (ssd->transport != ssd1306_transport_i2c) {
+        // TXSTALL volta a ser marcado assim que a state machine para por falta de palavras no FIFO
+        uint32_t stall = 1u << (PIO_FDEBUG_TXSTALL_LSB + ssd->sm);
 
-    if (set) {
-        byte |= 1 << (y % 8);
+        ssd->pio->fdebug = stall;
+        while (!(ssd->pio->fdebug & stall)) {
+            tight_loop_contents();
+        }
+        return;
     }
-    else {
-        byte &= ~(1 << (y % 8));
+
+    i2c_hw_t *hw = i2c_get_hw(ssd->i2c_port);
+
+    while (hw->status & I2C_IC_STATUS_ACTIVITY_BITS) {
+        tight_loop_contents();
     }
 
-    ssd[byte_idx] = byte;
+    (void)hw->clr_stop_det;
+    (void)hw->clr_tx_abrt;
 }
 
-// Algoritmo de Bresenham básico
-void ssd1306_draw_line(uint8_t *ssd, int x_0, int y_0, int x_1, int y_1, bool set) {
-    int dx = abs(x_1 - x_0); // Deslocamentos
-    int dy = -abs(y_1 - y_0);
-    int sx = x_0 < x_1 ? 1 : -1; // Direção de avanço
-    int sy = y_0 < y_1 ? 1 : -1;
-    int error = dx + dy; // Erro acumulado
-    int error_2;
-
-    while (true) {
-        ssd1306_set_pixel(ssd, x_0, y_0, set); // Acende pixel no ponto atual
-        if (x_0 == x_1 && y_0 == y_1) {
-            break; // Verifica se o ponto final foi alcançado
-        }
+// Devolve a fila livre, vazia, para montar a próxima transmissão (sem alocação)
+ssd1306_queue_t *ssd1306_queue_begin(ssd1306_t *ssd) {
+    ssd1306_queue_t *queue = &ssd->queues[ssd->back_queue];
 
-        error_2 = 2 * error; // Ajusta o erro acumulado
+    queue->length = 0;
+    queue->transactions = 0;
+    queue->transport = ssd->transport;
+    queue->address = ssd->address;
 
-        if (error_2 >= dy) {
-            error += dy;
-            x_0 += sx; // Avança na direção x
-        }
-        if (error_2 <= dx) {
-            error += dx;
-            y_0 += sy; // Avança na direção y
-        }
-    }
+    return queue;
 }
 
-// Adquire os pixels para um caractere (de acordo com ssd1306_font.h)
-inline int ssd1306_get_font(uint8_t character)
-{
-  if (character >= 'A' && character <= 'Z') {
-    return character - 'A' + 1;
-  }
-  else if (character >= '0' && character <= '9') {
-    return character - '0' + 27;
-  } else if (character == ':') {
-        return 0; // ou crie um índice específico para ':' se quiser
-} else{
-    switch (character) {
-      case '-': return 37;
-      case '+': return 38;
-      case '_': return 39;
-      case '*': return 40;
-      case '$': return 41;
-      case '#': return 42;
-      case '>': return 43;
-      case '<': return 44;
-      case '(': return 45;
-      case ')': return 46;
-      case '!': return 47;
-      case '@': return 48;
-      case '?': return 49;
-      case '/': return 50;
-      default: return 0;
+// Abre uma transação com o byte de controle indicado e define como os bytes dela viram palavras
+// ((byte << shift) | flags); o STOP é marcado ao fechá-la.
+// No I2C por PIO o START e o byte de endereço vão na fila; no SPI o byte de controle vira o nível de D/C
+static uint16_t *ssd1306_queue_open(ssd1306_queue_t *queue, uint8_t control, int length) {
+    uint16_t *words = queue->words + queue->length;
+    int header = 0;
+
+    switch (queue->transport) {
+    case ssd1306_transport_i2c:
+        queue->shift = 0;
+        queue->flags = 0;
+        words[header++] = control;
+        break;
+    case ssd1306_transport_pio_i2c:
+        queue->shift = ssd1306_pio_i2c_shift;
+        queue->flags = 0;
+        words[header++] = ssd1306_pio_i2c_start | ((queue->address << 1) << ssd1306_pio_i2c_shift);
+        words[header++] = control << ssd1306_pio_i2c_shift;
+        break;
+    case ssd1306_transport_pio_spi:
+        queue->shift = ssd1306_pio_spi_shift;
+        queue->flags = (control & 0x40) ? ssd1306_pio_spi_data : 0;
+        break;
     }
-  }   
+
+    assert(queue->length + header + length <= ssd1306_queue_length);
+    queue->length += header + length;
+    queue->transactions++;
+
+    return words + header;
 }
 
-// Desenha um único caractere no display
-void ssd1306_draw_char(uint8_t *ssd, int16_t x, int16_t y, uint8_t character) {
-    if (x > ssd1306_width - 8 || y > ssd1306_height - 8) {
-        return;
+static void ssd1306_queue_close(ssd1306_queue_t *queue) {
+    switch (queue->transport) {
+    case ssd1306_transport_i2c:
+        queue->words[queue->length - 1] |= I2C_IC_DATA_CMD_STOP_BITS;
+        break;
+    case ssd1306_transport_pio_i2c:
+        queue->words[queue->length - 1] |= ssd1306_pio_i2c_stop;
+        break;
+    case ssd1306_transport_pio_spi:
+        break;
     }
+}
 
-    y = y / 8;
+// Acrescenta uma lista de comandos numa única transação (Co = 0, byte de controle 0x00)
+void ssd1306_queue_commands(ssd1306_queue_t *queue, const uint8_t *commands, int number) {
+    uint16_t *words = ssd1306_queue_open(queue, 0x00, number);
 
-    character = toupper(character);
-    int idx = ssd1306_get_font(character);
-    int fb_idx = y * 128 + x;
+    for (int i = 0; i < number; i++) {
+        words[i] = (commands[i] << queue->shift) | queue->flags;
+    }
+    ssd1306_queue_close(queue);
+}
 
-    for (int i = 0; i < 8; i++) {
-        ssd[fb_idx++] = font[idx * 8 + i];
+// Acrescenta uma transação de dados (byte de controle 0x40)
+void ssd1306_queue_data(ssd1306_queue_t *queue, const uint8_t *data, int length) {
+    uint16_t *words = ssd1306_queue_open(queue, 0x40, length);
+
+    for (int i = 0; i < length; i++) {
+        words[i] = (data[i] << queue->shift) | queue->flags;
     }
+    ssd1306_queue_close(queue);
 }
-//Escala2x
-void ssd1306_draw_char_scale2(uint8_t *ssd, int16_t x, int16_t y, uint8_t character) {
-    character = toupper(character);
-    int idx = ssd1306_get_font(character);
-
-    for (int col = 0; col < 8; col++) {
-        uint8_t original = font[idx * 8 + col];
-        for (int row = 0; row < 8; row++) {
-            bool pixel_on = original & (1 << row);
-            if (pixel_on) {
-                // Duplica cada pixel verticalmente (2x)
-                ssd1306_set_pixel(ssd, x + col, y + (row * 2), true);
-                ssd1306_set_pixel(ssd, x + col, y + (row * 2 + 1), true);
-            }
+
+// Acrescenta os comandos de endereço de uma janela do framebuffer do display seguidos dos seus dados
+void ssd1306_queue_window(ssd1306_t *ssd, ssd1306_queue_t *queue, struct render_area *area) {
+    uint8_t commands[] = {
+        ssd1306_set_column_address, area->start_column, area->end_column,
+        ssd1306_set_page_address, area->start_page, area->end_page
+    };
+    int columns = area->end_column - area->start_column + 1;
+
+    ssd1306_queue_commands(queue, commands, count_of(commands));
+
+    uint16_t *words = ssd1306_queue_open(queue, 0x40, area->buffer_length);
+
+    for (int page = area->start_page; page <= area->end_page; page++) {
+        const uint8_t *row = ssd->ram_buffer + page * ssd->width + area->start_column;
+
+        for (int col = 0; col < columns; col++) {
+            *words++ = (row[col] << queue->shift) | queue->flags;
         }
+        memcpy(ssd->shadow + page * ssd->width + area->start_column, row, columns);
     }
+    ssd1306_queue_close(queue);
 }
-void ssd1306_draw_string_scale2(uint8_t *ssd, int16_t x, int16_t y, char *string) {
-    while (*string) {
-        ssd1306_draw_char_scale2(ssd, x, y, *string++);
-        x += 8;  // avança normalmente em largura
+
+// Espera o barramento do display ficar livre, dispara o DMA da fila e troca a fila de montagem
+void ssd1306_queue_submit(ssd1306_t *ssd, ssd1306_queue_t *queue) {
+    if (queue->length == 0) {
+        return;
     }
-}
 
+    ssd1306_wait_frame(ssd);
 
+    if (ssd->transport == ssd1306_transport_i2c) {
+        i2c_hw_t *hw = i2c_get_hw(ssd->i2c_port);
 
-// Desenha uma string, chamando a função de desenhar caractere várias vezes
-void ssd1306_draw_string(uint8_t *ssd, int16_t x, int16_t y, char *string) {
-    if (x > ssd1306_width - 8 || y > ssd1306_height - 8) {
-        return;
+        hw->enable = 0;
+        hw->tar = ssd->address;
+        hw->enable = 1;
     }
 
-    while (*string) {
-        ssd1306_draw_char(ssd, x, y, *string++);
-        x += 8;
+    // Cada STOP na fila encerra uma transação; a palavra seguinte gera um novo START
+    dma_channel_transfer_from_buffer_now(ssd->dma_chan, queue->words, queue->length);
+    ssd->back_queue ^= 1;
+
+    // No bloco I2C o byte de endereço de cada transação não está na fila
+    ssd->bytes_sent += queue->length;
+    if (ssd->transport == ssd1306_transport_i2c) {
+        ssd->bytes_sent += queue->transactions;
+    }
+}
+
+// Envia uma lista de comandos ao hardware em transações de até ssd1306_max_command_list comandos
+// (byte de controle 0x00), pela fila de DMA do transporte do display
+void ssd1306_send_command_list(ssd1306_t *ssd, const uint8_t *commands, int number) {
+    ssd1306_queue_t *queue = ssd1306_queue_begin(ssd);
+
+    while (number > 0) {
+        int chunk = number < ssd1306_max_command_list ? number : ssd1306_max_command_list;
+
+        ssd1306_queue_commands(queue, commands, chunk);
+        commands += chunk;
+        number -= chunk;
     }
+
+    ssd1306_queue_submit(ssd, queue);
 }
 
 // Comando de configuração com base na estrutura ssd1306_t
 void ssd1306_command(ssd1306_t *ssd, uint8_t command) {
-  ssd->port_buffer[1] = command;
-  i2c_write_blocking(
-	ssd->i2c_port, ssd->address, ssd->port_buffer, 2, false );
+    ssd1306_send_command_list(ssd, &command, 1);
+}
+
+// Envia bytes de dados na posição de escrita atual do display, via DMA, e retorna sem esperar o fim
+void ssd1306_send_buffer(ssd1306_t *ssd, const uint8_t *data, int buffer_length) {
+    ssd1306_queue_t *queue = ssd1306_queue_begin(ssd);
+
+    ssd1306_queue_data(queue, data, buffer_length);
+    ssd1306_queue_submit(ssd, queue);
+    ssd->shadow_valid = false; // A posição de escrita no display não é conhecida aqui
 }
 
-// Função de configuração do display para o caso do bitmap
+// Função de configuração do display: toda a lista de inicialização numa única transação
 void ssd1306_config(ssd1306_t *ssd) {
-    ssd1306_command(ssd, ssd1306_set_display | 0x00);
-    ssd1306_command(ssd, ssd1306_set_memory_mode);
-    ssd1306_command(ssd, 0x01);
-    ssd1306_command(ssd, ssd1306_set_display_start_line | 0x00);
-    ssd1306_command(ssd, ssd1306_set_segment_remap | 0x01);
-    ssd1306_command(ssd, ssd1306_set_mux_ratio);
-    ssd1306_command(ssd, ssd1306_height - 1);
-    ssd1306_command(ssd, ssd1306_set_common_output_direction | 0x08);
-    ssd1306_command(ssd, ssd1306_set_display_offset);
-    ssd1306_command(ssd, 0x00);
-    ssd1306_command(ssd, ssd1306_set_common_pin_configuration);
-    ssd1306_command(ssd, 0x12);
-    ssd1306_command(ssd, ssd1306_set_display_clock_divide_ratio);
-    ssd1306_command(ssd, 0x80);
-    ssd1306_command(ssd, ssd1306_set_precharge);
-    ssd1306_command(ssd, 0xF1);
-    ssd1306_command(ssd, ssd1306_set_vcomh_deselect_level);
-    ssd1306_command(ssd, 0x30);
-    ssd1306_command(ssd, ssd1306_set_contrast);
-    ssd1306_command(ssd, 0xFF);
-    ssd1306_command(ssd, ssd1306_set_entire_on);
-    ssd1306_command(ssd, ssd1306_set_normal_display);
-    ssd1306_command(ssd, ssd1306_set_charge_pump);
-    ssd1306_command(ssd, 0x14);
-    ssd1306_command(ssd, ssd1306_set_display | 0x01);
+    uint8_t commands[] = {
+        ssd1306_set_display | 0x00,
+        ssd1306_set_memory_mode, 0x00, // Endereçamento horizontal: o framebuffer é organizado em páginas
+        ssd1306_set_display_start_line | 0x00,
+        ssd1306_set_segment_remap | 0x01,
+        ssd1306_set_mux_ratio, ssd->height - 1,
+        ssd1306_set_common_output_direction | 0x08,
+        ssd1306_set_display_offset, 0x00,
+        ssd1306_set_common_pin_configuration, (ssd->width == 128 && ssd->height == 32) ? 0x02 : 0x12,
+        ssd1306_set_display_clock_divide_ratio, 0x80,
+        ssd1306_set_precharge, ssd->external_vcc ? 0x22 : 0xF1,
+        ssd1306_set_vcomh_deselect_level, 0x30,
+        ssd1306_set_contrast, 0xFF,
+        ssd1306_set_entire_on,
+        ssd1306_set_normal_display,
+        ssd1306_set_charge_pump, ssd->external_vcc ? 0x10 : 0x14,
+        ssd1306_set_scroll | 0x00,
+        ssd1306_set_display | 0x01,
+    };
+
+    ssd1306_send_command_list(ssd, commands, count_of(commands));
+    ssd->shadow_valid = false;
 }
 
-// Inicializa o display para o caso de exibição de bitmap
-void ssd1306_init_bm(ssd1306_t *ssd, uint8_t width, uint8_t height, bool external_vcc, uint8_t address, i2c_inst_t *i2c) {
+// Preenche a instância: framebuffer e filas próprios.
+// A largura deve ser ssd1306_width e a altura no máximo ssd1306_height (o framebuffer é estático)
+static void ssd1306_instance_init(ssd1306_t *ssd, uint8_t width, uint8_t height, bool external_vcc, ssd1306_transport_t transport) {
+    assert(width == ssd1306_width && height <= ssd1306_height);
+
+    memset(ssd, 0, sizeof(*ssd));
     ssd->width = width;
     ssd->height = height;
     ssd->pages = height / 8U;
+    ssd->external_vcc = external_vcc;
+    ssd->ram_buffer = ssd->framebuffer;
+    ssd->bufsize = ssd->pages * ssd->width;
+    ssd->transport = transport;
+}
+
+// Carrega o programa no bloco PIO (uma vez por bloco) e reserva uma state machine para o display
+static void ssd1306_pio_claim(ssd1306_t *ssd, PIO pio, const pio_program_t *program, int index) {
+    uint pio_index = pio_get_index(pio);
+
+    if (!ssd1306_pio_loaded[pio_index][index]) {
+        ssd1306_pio_offsets[pio_index][index] = pio_add_program(pio, program);
+        ssd1306_pio_loaded[pio_index][index] = true;
+    }
+
+    ssd->pio = pio;
+    ssd->sm = pio_claim_unused_sm(pio, true);
+    ssd->pio_offset = ssd1306_pio_offsets[pio_index][index];
+}
+
+// Inicializa a instância do display no bloco I2C: porta, endereço e canal DMA exclusivos
+void ssd1306_init_bm(ssd1306_t *ssd, uint8_t width, uint8_t height, bool external_vcc, uint8_t address, i2c_inst_t *i2c) {
+    ssd1306_instance_init(ssd, width, height, external_vcc, ssd1306_transport_i2c);
     ssd->address = address;
     ssd->i2c_port = i2c;
-    ssd->bufsize = ssd->pages * ssd->width + 1;
-    ssd->ram_buffer = calloc(ssd->bufsize, sizeof(uint8_t));
-    ssd->ram_buffer[0] = 0x40;
-    ssd->port_buffer[0] = 0x80;
+
+    ssd1306_dma_init(ssd, i2c_get_dreq(i2c, true), &i2c_get_hw(i2c)->data_cmd);
+}
+
+// Inicializa a instância para um display 128x64 e envia a configuração
+void ssd1306_init(ssd1306_t *ssd, i2c_inst_t *i2c, uint8_t address) {
+    ssd1306_init_bm(ssd, ssd1306_width, ssd1306_height, false, address, i2c);
+    ssd1306_config(ssd);
 }
 
-// Envia os dados ao display
+// Inicializa um display 128x64 no I2C por PIO (fast-mode plus; os pull-ups da placa limitam o clock real)
+void ssd1306_init_pio_i2c(ssd1306_t *ssd, PIO pio, uint sda, uint scl, uint8_t address) {
+    ssd1306_instance_init(ssd, ssd1306_width, ssd1306_height, false, ssd1306_transport_pio_i2c);
+    ssd->address = address;
+
+    ssd1306_pio_claim(ssd, pio, &ssd1306_i2c_program, 0);
+    ssd1306_i2c_program_init(pio, ssd->sm, ssd->pio_offset, sda, scl, ssd1306_pio_i2c_clock * 1000.0f);
+    ssd1306_dma_init(ssd, pio_get_dreq(pio, ssd->sm, true), &pio->txf[ssd->sm]);
+
+    ssd1306_config(ssd);
+}
+
+// Inicializa um display 128x64 SPI de 4 fios por PIO; CS fica sempre selecionado e RES recebe um pulso
+void ssd1306_init_pio_spi(ssd1306_t *ssd, PIO pio, uint sck, uint mosi, uint dc, uint cs, uint reset) {
+    ssd1306_instance_init(ssd, ssd1306_width, ssd1306_height, false, ssd1306_transport_pio_spi);
+
+    gpio_init(cs);
+    gpio_set_dir(cs, GPIO_OUT);
+    gpio_put(cs, 0);
+
+    gpio_init(reset);
+    gpio_set_dir(reset, GPIO_OUT);
+    gpio_put(reset, 0);
+    sleep_us(10);
+    gpio_put(reset, 1);
+    sleep_us(10);
+
+    ssd1306_pio_claim(ssd, pio, &ssd1306_spi_program, 1);
+    ssd1306_spi_program_init(pio, ssd->sm, ssd->pio_offset, sck, mosi, dc, ssd1306_pio_spi_clock * 1000.0f);
+    ssd1306_dma_init(ssd, pio_get_dreq(pio, ssd->sm, true), &pio->txf[ssd->sm]);
+
+    ssd1306_config(ssd);
+}
+
+// Cria a lista de comandos para configurar o scrolling
+void ssd1306_scroll(ssd1306_t *ssd, bool set) {
+    uint8_t commands[] = {
+        ssd1306_set_horizontal_scroll | 0x00, 0x00, 0x00, 0x00, ssd->pages - 1,
+        0x00, 0xFF, ssd1306_set_scroll | (set ? 0x01 : 0)
+    };
+
+    ssd1306_send_command_list(ssd, commands, count_of(commands));
+    ssd->shadow_valid = false; // A RAM do display precisa ser reescrita após o scroll
+}
+
+// Limpa o framebuffer do display (não envia nada)
+void ssd1306_clear(ssd1306_t *ssd) {
+    memset(ssd->ram_buffer, 0, ssd->bufsize);
+}
+
+// Atualiza uma parte do display com uma área do framebuffer (comandos e dados numa única fila de DMA)
+void render_on_display(ssd1306_t *ssd, struct render_area *area) {
+    ssd1306_queue_t *queue = ssd1306_queue_begin(ssd);
+
+    ssd1306_queue_window(ssd, queue, area);
+    ssd1306_queue_submit(ssd, queue);
+
+    if (area->buffer_length == ssd->bufsize) {
+        ssd->shadow_valid = true;
+    }
+}
+
+// Envia o framebuffer inteiro ao display
 void ssd1306_send_data(ssd1306_t *ssd) {
-    ssd1306_command(ssd, ssd1306_set_column_address);
-    ssd1306_command(ssd, 0);
-    ssd1306_command(ssd, ssd->width - 1);
-    ssd1306_command(ssd, ssd1306_set_page_address);
-    ssd1306_command(ssd, 0);
-    ssd1306_command(ssd, ssd->pages - 1);
-    i2c_write_blocking(
-    ssd->i2c_port, ssd->address, ssd->ram_buffer, ssd->bufsize, false );
+    struct render_area area = {
+        .start_column = 0,
+        .end_column = ssd->width - 1,
+        .start_page = 0,
+        .end_page = ssd->pages - 1
+    };
+
+    calculate_render_area_buffer_length(&area);
+    render_on_display(ssd, &area);
 }
 
-// Desenha o bitmap (a ser fornecido em display_oled.c) no display
-void ssd1306_draw_bitmap(ssd1306_t *ssd, const uint8_t *bitmap) {
-    for (int i = 0; i < ssd->bufsize - 1; i++) {
-        ssd->ram_buffer[i + 1] = bitmap[i];
+// Compara o framebuffer com a cópia do display e envia apenas as janelas alteradas
+// (ssd1306_find_changed_windows), todas encadeadas numa única transferência de DMA
+void render_changes_on_display(ssd1306_t *ssd) {
+    struct render_area windows[ssd1306_n_pages];
 
+    if (!ssd->shadow_valid) {
         ssd1306_send_data(ssd);
+        return;
+    }
+
+    int overhead = ssd->transport == ssd1306_transport_pio_spi ? ssd1306_spi_window_overhead : ssd1306_window_overhead;
+    int count = ssd1306_find_changed_windows(ssd->ram_buffer, ssd->shadow, overhead, windows);
+    ssd1306_queue_t *queue = ssd1306_queue_begin(ssd);
+
+    for (int i = 0; i < count; i++) {
+        ssd1306_queue_window(ssd, queue, &windows[i]);
     }
-}
\ No newline at end of file
+
+    ssd1306_queue_submit(ssd, queue);
+}
+
+// Desenha o bitmap (a ser fornecido em display_oled.c, organizado em páginas) no display:
+// uma cópia para o framebuffer e um único envio
+void ssd1306_draw_bitmap(ssd1306_t *ssd, const uint8_t *bitmap) {
+    memcpy(ssd->ram_buffer, bitmap, ssd->bufsize);
+    ssd1306_send_data(ssd);
+}
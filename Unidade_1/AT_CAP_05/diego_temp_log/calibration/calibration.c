@@ -0,0 +1,47 @@
+#include <stdint.h>
+#include "calibration.h"
+#include "temperature_lut.h"
+
+// Quociente arredondado com as metades para longe do zero, pelo sinal do resultado (den != 0)
+static int64_t calibration_divide_round(int64_t num, int64_t den) {
+    uint64_t magnitude_num = num < 0 ? -(uint64_t)num : (uint64_t)num;
+    uint64_t magnitude_den = den < 0 ? -(uint64_t)den : (uint64_t)den;
+    int64_t quotient = (int64_t)((magnitude_num + magnitude_den / 2) / magnitude_den);
+
+    return (num < 0) != (den < 0) ? -quotient : quotient;
+}
+
+bool calibration_line(const calibration_t *cal, int64_t *offset_q16, int64_t *slope_q16) {
+    int64_t span_q8 = (int64_t)cal->code_q8[1] - cal->code_q8[0];
+
+    if (span_q8 < 0 ? -span_q8 < calibration_min_span_q8 : span_q8 < calibration_min_span_q8) {
+        return false;
+    }
+
+    // Inclinação em centésimos por LSB (Q16); o código dos pontos tem 8 bits de fração
+    int64_t rise_q24 = ((int64_t)cal->centi[1] - cal->centi[0]) * (1 << 24);
+    int64_t slope = calibration_divide_round(rise_q24, span_q8);
+
+    if (slope < calibration_min_slope_q16 || slope > calibration_max_slope_q16) {
+        return false;
+    }
+
+    // Reta pelo primeiro ponto: T(0) = T0 - inclinação * código0
+    int64_t run_q24 = slope * cal->code_q8[0];
+
+    *offset_q16 = (int64_t)cal->centi[0] * 65536 - calibration_divide_round(run_q24, 256);
+    *slope_q16 = slope;
+
+    return true;
+}
+
+void calibration_apply(const calibration_t *cal) {
+    int64_t offset_q16, slope_q16;
+
+    if (cal && calibration_line(cal, &offset_q16, &slope_q16)) {
+        temperature_lut_build(offset_q16, slope_q16);
+    }
+    else {
+        temperature_lut_build_default();
+    }
+}
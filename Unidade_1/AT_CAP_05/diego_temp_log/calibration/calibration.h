@@ -0,0 +1,41 @@
+#ifndef calibration_inc_h
+#define calibration_inc_h
+
+#include <stdbool.h>
+#include <stdint.h>
+
+// Calibração de dois pontos do sensor de temperatura interno, guardada em um setor do flash
+// (logo abaixo da região do registro, templog/templog.h).
+// Cada ponto liga o código médio do ADC (Q8, saída do decimador) à temperatura de referência
+// medida por um termômetro externo; a reta pelos dois pontos substitui a do datasheet na tabela
+// de conversão (temperature_lut.h), montada uma vez: a conversão de cada leitura não muda
+// A reta e a tabela ficam em calibration.c (compila também no computador, ver calibration_test.c);
+// a leitura e a gravação no flash, em calibration_flash.c
+
+#define calibration_magic 0x4C414354u      // "TCAL"
+#define calibration_min_span_q8 (16 << 8)  // Distância mínima entre os códigos dos pontos (16 LSB)
+#define calibration_min_slope_q16 -6553600 // Faixa aceita para a inclinação, em centésimos de grau por LSB (Q16):
+#define calibration_max_slope_q16 -1310720 // de -100 a -20 (datasheet: -46,8)
+
+typedef struct {
+    uint32_t magic;
+    int32_t code_q8[2]; // Código médio do ADC em cada ponto
+    int32_t centi[2];   // Temperatura de referência de cada ponto (°C * 100)
+    uint32_t check;     // FNV-1a dos campos anteriores
+} calibration_t;
+
+// Reta da calibração em Q16: temperatura no código 0 e variação por código; false se os pontos não servem
+bool calibration_line(const calibration_t *cal, int64_t *offset_q16, int64_t *slope_q16);
+
+// Lê a calibração do flash; false se não houver uma válida
+bool calibration_load(calibration_t *cal);
+
+// Monta a tabela de conversão com a calibração (ou a reta do datasheet, se cal for NULL ou inválida)
+void calibration_apply(const calibration_t *cal);
+
+// Grava a calibração no flash (NULL apaga) e remonta a tabela com o outro núcleo fora da conversão,
+// para ela nunca ver uma tabela pela metade. Retorna false se a calibração for rejeitada ou se
+// o flash não pôde ser gravado (outro núcleo não liberou a tempo): nesse caso o flash e a tabela não mudam
+bool calibration_store(const calibration_t *cal);
+
+#endif
@@ -0,0 +1,76 @@
+#include <assert.h>
+#include <stddef.h>
+#include <string.h>
+#include "pico/stdlib.h"
+#include "pico/flash.h"
+#include "hardware/flash.h"
+#include "calibration.h"
+#include "temperature_lut.h"
+#include "templog/templog.h"
+
+#define calibration_flash_offset (PICO_FLASH_SIZE_BYTES - templog_region_size - FLASH_SECTOR_SIZE)
+#define calibration_flash_timeout_ms 1000 // Espera máxima pelo outro núcleo
+
+static_assert(sizeof(calibration_t) <= FLASH_PAGE_SIZE, "calibração em uma página");
+
+typedef struct {
+    const calibration_t *cal; // NULL: só apaga
+    int64_t offset_q16;
+    int64_t slope_q16;
+} calibration_flash_op_t;
+
+static uint32_t calibration_check(const calibration_t *cal) {
+    const uint8_t *bytes = (const uint8_t *)cal;
+    uint32_t hash = 2166136261u;
+
+    for (size_t i = 0; i < offsetof(calibration_t, check); i++) {
+        hash = (hash ^ bytes[i]) * 16777619u;
+    }
+
+    return hash;
+}
+
+bool calibration_load(calibration_t *cal) {
+    memcpy(cal, (const void *)(XIP_BASE + calibration_flash_offset), sizeof(*cal));
+
+    int64_t offset_q16, slope_q16;
+    return cal->magic == calibration_magic && cal->check == calibration_check(cal) &&
+           calibration_line(cal, &offset_q16, &slope_q16);
+}
+
+// Executada com interrupções desligadas e o outro núcleo fora do flash (só guardando blocos); remontar a tabela aqui (~4096 somas)
+// evita que a conversão do outro núcleo interpole entre entradas antigas e novas
+static void calibration_flash_run(void *param) {
+    const calibration_flash_op_t *op = param;
+
+    flash_range_erase(calibration_flash_offset, FLASH_SECTOR_SIZE);
+    if (op->cal) {
+        uint8_t page[FLASH_PAGE_SIZE];
+
+        memset(page, 0xFF, sizeof(page));
+        memcpy(page, op->cal, sizeof(*op->cal));
+        flash_range_program(calibration_flash_offset, page, FLASH_PAGE_SIZE);
+        temperature_lut_build(op->offset_q16, op->slope_q16);
+    }
+    else {
+        temperature_lut_build_default();
+    }
+}
+
+// O outro núcleo é afastado do flash pelo ajudante do aplicativo (get_flash_safety_helper())
+bool calibration_store(const calibration_t *cal) {
+    calibration_flash_op_t op = { NULL };
+    calibration_t stored;
+
+    if (cal) {
+        if (!calibration_line(cal, &op.offset_q16, &op.slope_q16)) {
+            return false;
+        }
+        stored = *cal;
+        stored.magic = calibration_magic;
+        stored.check = calibration_check(&stored);
+        op.cal = &stored;
+    }
+
+    return flash_safe_execute(calibration_flash_run, &op, calibration_flash_timeout_ms) == PICO_OK;
+}
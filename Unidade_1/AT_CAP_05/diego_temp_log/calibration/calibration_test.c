@@ -0,0 +1,175 @@
+// Confere a calibração de dois pontos (calibration.c) e a tabela montada com ela, no computador.
+//   - Inclinação: para pontos variados (inclusive em ordem inversa e com frações de código), a inclinação em
+//     Q16 é o quociente exato arredondado com as metades para longe do zero, e trocar os pontos não a muda;
+//     o deslocamento é a reta pelo primeiro ponto, arredondada do mesmo jeito.
+//   - Tabela: para sensores simulados com inclinações e códigos a 27 °C variados, os dois pontos medidos dão
+//     uma tabela que segue a reta verdadeira nos 4096 códigos (erro limitado pela quantização dos pontos).
+//   - Rejeição: pontos próximos demais ou inclinações fora da faixa mantêm a reta do datasheet.
+// Falha (código de saída 1) se alguma conferência não passar.
+//
+// Compilação: gcc -std=c11 -O2 -I.. -o calibration_test calibration_test.c calibration.c ../temperature_lut.c -lm
+// Uso:        calibration_test
+
+#include <stdio.h>
+#include <stdbool.h>
+#include <math.h>
+#include "calibration.h"
+#include "temperature_lut.h"
+
+// Inclinação esperada: quociente exato em Q16, metades para longe do zero
+static int64_t expected_slope_q16(const calibration_t *cal) {
+    long double quotient = (long double)((int64_t)cal->centi[1] - cal->centi[0]) * (1 << 24) /
+                           ((int64_t)cal->code_q8[1] - cal->code_q8[0]);
+
+    return (int64_t)roundl(quotient);
+}
+
+// Deslocamento esperado: reta pelo primeiro ponto com a inclinação já arredondada, metades para longe do zero
+static int64_t expected_offset_q16(const calibration_t *cal, int64_t slope_q16) {
+    return (int64_t)cal->centi[0] * 65536 - (int64_t)roundl((long double)slope_q16 * cal->code_q8[0] / 256);
+}
+
+static bool check_slope(int32_t code0_q8, int32_t centi0, int32_t code1_q8, int32_t centi1) {
+    calibration_t cal = { .code_q8 = { code0_q8, code1_q8 }, .centi = { centi0, centi1 } };
+    calibration_t swapped = { .code_q8 = { code1_q8, code0_q8 }, .centi = { centi1, centi0 } };
+    int64_t offset, slope, swapped_offset, swapped_slope;
+
+    if (!calibration_line(&cal, &offset, &slope) || !calibration_line(&swapped, &swapped_offset, &swapped_slope)) {
+        printf("  pontos (%d, %d) (%d, %d) rejeitados\n", code0_q8, centi0, code1_q8, centi1);
+        return false;
+    }
+    if (slope != expected_slope_q16(&cal) || swapped_slope != slope) {
+        printf("  pontos (%d, %d) (%d, %d): inclinacao %lld, trocados %lld, esperada %lld\n", code0_q8, centi0,
+               code1_q8, centi1, (long long)slope, (long long)swapped_slope, (long long)expected_slope_q16(&cal));
+        return false;
+    }
+    if (offset != expected_offset_q16(&cal, slope) || swapped_offset != expected_offset_q16(&swapped, slope)) {
+        printf("  pontos (%d, %d) (%d, %d): deslocamento %lld, esperado %lld\n", code0_q8, centi0, code1_q8, centi1,
+               (long long)offset, (long long)expected_offset_q16(&cal, slope));
+        return false;
+    }
+
+    return true;
+}
+
+// Sensor simulado: T(código) = offset + slope * código; pontos medidos a t0 e t1 (centésimos), com o
+// código médio em Q8 como o decimador entrega. Devolve o erro máximo da tabela nos 4096 códigos
+static double check_table(double offset_centi, double slope_centi, int32_t t0, int32_t t1, double *bound) {
+    calibration_t cal = {
+        .code_q8 = { (int32_t)lround((t0 - offset_centi) / slope_centi * 256),
+                     (int32_t)lround((t1 - offset_centi) / slope_centi * 256) },
+        .centi = { t0, t1 }
+    };
+
+    calibration_apply(&cal);
+
+    // Quantização dos códigos dos pontos (1/512 LSB cada) propagada pela reta, mais o arredondamento da tabela
+    double span = fabs((double)cal.code_q8[1] - cal.code_q8[0]) / 256.0;
+    double worst = 0;
+
+    *bound = 0;
+    for (int code = 0; code < temperature_adc_codes; code++) {
+        double exact = offset_centi + slope_centi * code;
+        double error = fabs(temperature_centi_from_adc((uint16_t)code) - exact);
+        double distance = fmax(fabs(code - cal.code_q8[0] / 256.0), fabs(code - cal.code_q8[1] / 256.0));
+        double limit = 0.5 + fabs(slope_centi) / 512 * (1 + 2 * distance / span) + temperature_adc_codes * 0.5 / 65536;
+
+        worst = fmax(worst, error);
+        *bound = fmax(*bound, limit);
+        if (error > limit) {
+            return INFINITY;
+        }
+    }
+
+    return worst;
+}
+
+int main(void) {
+    bool ok = true;
+    int slope_failures = 0, slope_cases = 0;
+
+    // Inclinação: combinações de sinais, frações e meios exatos
+    const int32_t codes[] = { 1000 * 256, 1234 * 256 + 77, 1600 * 256 + 128, 2000 * 256 + 1, 3000 * 256 + 255 };
+    const int32_t temps[] = { -1500, 0, 2513, 4999, 7777 };
+
+    for (int a = 0; a < 5; a++) {
+        for (int b = 0; b < 5; b++) {
+            for (int c = 0; c < 5; c++) {
+                for (int d = 0; d < 5; d++) {
+                    calibration_t cal = { .code_q8 = { codes[a], codes[b] }, .centi = { temps[c], temps[d] } };
+                    int64_t offset, slope;
+
+                    if (!calibration_line(&cal, &offset, &slope)) {
+                        continue; // Fora da faixa de inclinação: conferido abaixo
+                    }
+                    slope_cases++;
+                    slope_failures += !check_slope(codes[a], temps[c], codes[b], temps[d]);
+                }
+            }
+        }
+    }
+
+    // Metade exata: a inclinação só teria fração 0,5 com pontos a 2^25 em Q8 (fora do ADC), mas o deslocamento
+    // tem: inclinação ímpar (-3067085, de -46800 em 1000 LSB) vezes meio código dá x,5 em Q16, nos dois sentidos
+    slope_cases += 2;
+    slope_failures += !check_slope(128, 0, 128 + 1000 * 256, -46800);
+    slope_failures += !check_slope(128 + 1000 * 256, -46800, 128, 0);
+    printf("inclinacao: %d casos, %d com arredondamento errado ou dependente da ordem\n", slope_cases, slope_failures);
+    ok = ok && slope_failures == 0 && slope_cases > 2;
+
+    // Tabelas calibradas: sensores com inclinações de -25 a -90 centésimos por LSB e o código a 27 °C de
+    // 600 a 1200, calibrados em pares de pontos a pelo menos 16 LSB um do outro
+    const int32_t points[][2] = { { 0, 5000 }, { 2000, 3800 }, { 8000, -1000 }, { 4100, 2500 } };
+    double worst = 0, worst_bound = 0;
+    int table_failures = 0, tables = 0;
+
+    for (double slope = -25.3; slope >= -90; slope -= 7.9) {
+        for (double code_27 = 600; code_27 <= 1200; code_27 += 97.3) {
+            double offset = 2700 - slope * code_27;
+
+            for (int p = 0; p < 4; p++) {
+                double bound;
+                double error = check_table(offset, slope, points[p][0], points[p][1], &bound);
+
+                tables++;
+                if (isinf(error)) {
+                    table_failures++;
+                    printf("  sensor %.1f + %.1f * codigo, pontos %d e %d: erro acima do limite\n",
+                           offset, slope, points[p][0], points[p][1]);
+                    continue;
+                }
+                worst = fmax(worst, error);
+                worst_bound = fmax(worst_bound, bound);
+            }
+        }
+    }
+    printf("tabelas calibradas: %d, erro max %.3f centesimos (limite max %.3f), %d falhas\n", tables, worst, worst_bound, table_failures);
+    ok = ok && table_failures == 0;
+
+    // Rejeição: a tabela continua a do datasheet
+    const calibration_t rejected[] = {
+        { .code_q8 = { 1000 * 256, 1010 * 256 }, .centi = { 2500, 2000 } },  // Pontos a menos de 16 LSB
+        { .code_q8 = { 1000 * 256, 1100 * 256 }, .centi = { 2500, 2600 } },  // Inclinação positiva
+        { .code_q8 = { 1000 * 256, 1100 * 256 }, .centi = { 2500, 2490 } },  // Rasa demais (-0,1 por LSB)
+        { .code_q8 = { 1000 * 256, 1100 * 256 }, .centi = { 2500, -9000 } }, // Íngreme demais (-115 por LSB)
+    };
+    int32_t default_0, default_last;
+    int accepted = 0;
+
+    temperature_lut_build_default();
+    default_0 = temperature_centi_lut[0];
+    default_last = temperature_centi_lut[temperature_adc_codes - 1];
+    for (size_t i = 0; i < sizeof(rejected) / sizeof(rejected[0]); i++) {
+        int64_t offset, slope;
+
+        accepted += calibration_line(&rejected[i], &offset, &slope);
+        calibration_apply(&rejected[i]);
+        accepted += temperature_centi_lut[0] != default_0 || temperature_centi_lut[temperature_adc_codes - 1] != default_last;
+    }
+    printf("rejeicao: %d de %zu calibracoes invalidas aceitas\n", accepted, sizeof(rejected) / sizeof(rejected[0]));
+    ok = ok && accepted == 0;
+
+    printf("%s\n", ok ? "OK" : "FALHOU");
+
+    return ok ? 0 : 1;
+}
@@ -0,0 +1,199 @@
+#include <string.h>
+#include <assert.h>
+#include "decimator.h"
+
+// Número de bits de um valor (posição do bit mais significativo + 1)
+static int decimator_bits(uint64_t value) {
+    int bits = 0;
+
+    while (value) {
+        bits++;
+        value >>= 1;
+    }
+
+    return bits;
+}
+
+// Raiz quadrada inteira (arredondada para baixo), bit a bit
+static uint32_t decimator_isqrt(uint64_t value) {
+    uint64_t root = 0;
+    uint64_t bit = 1ULL << 62;
+
+    while (bit > value) {
+        bit >>= 2;
+    }
+    while (bit) {
+        if (value >= root + bit) {
+            value -= root + bit;
+            root = (root >> 1) + bit;
+        }
+        else {
+            root >>= 1;
+        }
+        bit >>= 2;
+    }
+
+    return (uint32_t)root;
+}
+
+// Prepara o decimador: ratio amostras por saída, ordem 1 (boxcar) a decimator_max_order.
+// O ganho ratio^order é limitado pela largura dos registradores: a saída (ganho * 4095) cabe em 64 bits
+// e o resto da divisão, deslocado pela fração Q8, também (ganho < 2^56)
+void decimator_init(decimator_t *dec, uint32_t ratio, uint8_t order) {
+    assert(order >= 1 && order <= decimator_max_order);
+    assert(ratio >= 1 && ratio <= (1u << 20));
+
+    memset(dec, 0, sizeof(*dec));
+    dec->ratio = ratio;
+    dec->order = order;
+    dec->gain = 1;
+    for (int i = 0; i < order; i++) {
+        dec->gain *= ratio;
+    }
+    assert(dec->gain <= UINT64_MAX / 4095 && dec->gain < (1ULL << 56));
+    dec->warmup = order - 1;
+    dec->effective_bits = 12 + (decimator_bits(ratio) - 1) / 2;
+    dec->min = UINT16_MAX;
+}
+
+// Acumula count amostras (todas da mesma janela) nos integradores e nas estatísticas
+static void decimator_accumulate(decimator_t *dec, const uint16_t *samples, uint32_t count) {
+    uint32_t sum = 0;
+    uint64_t sum_sq = 0;
+    uint16_t min = dec->min;
+    uint16_t max = dec->max;
+
+    for (uint32_t i = 0; i < count; i++) {
+        uint32_t x = samples[i];
+
+        sum += x;
+        sum_sq += x * x;
+        if (x < min) {
+            min = x;
+        }
+        if (x > max) {
+            max = x;
+        }
+    }
+
+    dec->sum += sum;
+    dec->sum_sq += sum_sq;
+    dec->min = min;
+    dec->max = max;
+
+    // Na ordem 1 o integrador é a própria soma; nas outras, cada amostra passa pela cascata
+    if (dec->order == 1) {
+        dec->integrator[0] += sum;
+    }
+    else if (dec->order == 2) {
+        uint64_t i0 = dec->integrator[0], i1 = dec->integrator[1];
+
+        for (uint32_t i = 0; i < count; i++) {
+            i0 += samples[i];
+            i1 += i0;
+        }
+        dec->integrator[0] = i0;
+        dec->integrator[1] = i1;
+    }
+    else {
+        uint64_t i0 = dec->integrator[0], i1 = dec->integrator[1], i2 = dec->integrator[2];
+
+        for (uint32_t i = 0; i < count; i++) {
+            i0 += samples[i];
+            i1 += i0;
+            i2 += i1;
+        }
+        dec->integrator[0] = i0;
+        dec->integrator[1] = i1;
+        dec->integrator[2] = i2;
+    }
+}
+
+// Fecha uma janela: passa o último integrador pelos pentes, calcula as estatísticas e as zera.
+// Retorna false durante o transitório inicial (saída descartada)
+static bool decimator_emit(decimator_t *dec, decimator_output_t *output) {
+    uint64_t value = dec->integrator[dec->order - 1];
+
+    for (int i = 0; i < dec->order; i++) {
+        uint64_t delayed = dec->comb_delay[i];
+
+        dec->comb_delay[i] = value;
+        value -= delayed;
+    }
+
+    // Variância das amostras brutas em LSB² * 65536, centrada na parte inteira da média (E[x²] - E[x]² com a
+    // média truncada em Q8 errava até 2 * média / 256 LSB²): Σ(x - m)² / ratio - (mean_rest / ratio)²
+    uint64_t mean = dec->sum / dec->ratio, mean_rest = dec->sum % dec->ratio;
+    uint64_t centered_sq = dec->sum_sq - 2 * mean * dec->sum + mean * mean * dec->ratio;
+    uint64_t var_q16 = ((centered_sq << (2 * decimator_frac_bits)) -
+                        ((mean_rest * mean_rest) << (2 * decimator_frac_bits)) / dec->ratio) / dec->ratio;
+    uint16_t min = dec->min, max = dec->max;
+
+    dec->sum = 0;
+    dec->sum_sq = 0;
+    dec->min = UINT16_MAX;
+    dec->max = 0;
+
+    if (dec->warmup) {
+        dec->warmup--;
+        return false;
+    }
+
+    // Divide pelo ganho ratio^order mantendo 8 bits de fração
+    uint64_t whole = value / dec->gain;
+    uint64_t rest = value % dec->gain;
+    uint32_t code_q8 = (uint32_t)((whole << decimator_frac_bits) + (rest << decimator_frac_bits) / dec->gain);
+
+    // Ruído da saída: diferenças sucessivas têm o dobro da variância do ruído (branco) de cada saída
+    if (dec->have_last) {
+        int64_t diff = (int64_t)code_q8 - dec->last_q8;
+        int64_t diff_sq = diff * diff;
+
+        if (dec->diff_sq_avg == 0) {
+            dec->diff_sq_avg = diff_sq;
+        }
+        else {
+            dec->diff_sq_avg += (diff_sq - dec->diff_sq_avg) / 8;
+        }
+    }
+    dec->last_q8 = code_q8;
+    dec->have_last = true;
+
+    if (output) {
+        output->code_q8 = code_q8;
+        output->min = min;
+        output->max = max;
+        output->raw_rms_q8 = decimator_isqrt(var_q16);
+        output->output_rms_q8 = decimator_isqrt(dec->diff_sq_avg / 2);
+        output->effective_bits = dec->effective_bits;
+    }
+
+    return output != NULL;
+}
+
+// Processa um bloco de amostras; grava até max_outputs saídas e retorna quantas foram produzidas
+int decimator_process(decimator_t *dec, const uint16_t *samples, int count, decimator_output_t *outputs, int max_outputs) {
+    int produced = 0;
+
+    while (count > 0) {
+        uint32_t run = dec->ratio - dec->phase;
+
+        if (run > (uint32_t)count) {
+            run = count;
+        }
+
+        decimator_accumulate(dec, samples, run);
+        samples += run;
+        count -= run;
+        dec->phase += run;
+
+        if (dec->phase == dec->ratio) {
+            dec->phase = 0;
+            if (decimator_emit(dec, produced < max_outputs ? &outputs[produced] : NULL)) {
+                produced++;
+            }
+        }
+    }
+
+    return produced;
+}
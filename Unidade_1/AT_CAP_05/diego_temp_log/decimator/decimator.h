@@ -0,0 +1,49 @@
+#include <stdint.h>
+#include <stdbool.h>
+
+#ifndef decimator_inc_h
+#define decimator_inc_h
+
+// Decimação de amostras do ADC: filtro CIC de ordem 1 (média em bloco, "boxcar") a 3, com razão configurável.
+// Troca taxa de amostragem por resolução: cada saída é a média filtrada de ratio amostras,
+// em código do ADC com 8 bits de fração (Q8), e vem acompanhada de estatísticas de ruído.
+// Só usa inteiros (o RP2040 não tem FPU)
+
+#define decimator_max_order 3
+#define decimator_frac_bits 8 // Bits de fração das saídas (código do ADC * 256)
+
+typedef struct {
+    uint32_t code_q8;       // Média decimada (código do ADC * 256)
+    uint16_t min, max;      // Extremos das amostras brutas da janela
+    uint32_t raw_rms_q8;    // Desvio padrão das amostras brutas da janela (LSB * 256)
+    uint32_t output_rms_q8; // Ruído medido entre saídas sucessivas (LSB * 256)
+    uint8_t effective_bits; // Resolução esperada para ruído branco: 12 + log2(ratio) / 2 bits
+} decimator_output_t;
+
+typedef struct {
+    uint32_t ratio;
+    uint8_t order;
+    uint64_t gain;        // ratio ^ order
+    uint8_t warmup;       // Saídas iniciais descartadas (transitório dos pentes)
+    uint8_t effective_bits;
+
+    // Estado do CIC (aritmética modular: a largura de 64 bits cobre 12 + order * log2(ratio) bits)
+    uint64_t integrator[decimator_max_order];
+    uint64_t comb_delay[decimator_max_order];
+    uint32_t phase;       // Amostras já acumuladas na janela atual
+
+    // Estatísticas das amostras brutas da janela atual
+    uint64_t sum;
+    uint64_t sum_sq;
+    uint16_t min, max;
+
+    // Ruído das saídas: média móvel exponencial do quadrado das diferenças sucessivas (Q16)
+    uint32_t last_q8;
+    bool have_last;
+    int64_t diff_sq_avg;
+} decimator_t;
+
+extern void decimator_init(decimator_t *dec, uint32_t ratio, uint8_t order);
+extern int decimator_process(decimator_t *dec, const uint16_t *samples, int count, decimator_output_t *outputs, int max_outputs);
+
+#endif
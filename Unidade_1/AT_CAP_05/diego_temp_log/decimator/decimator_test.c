@@ -0,0 +1,169 @@
+// Confere o decimador (decimator.c) no computador.
+//   - Exatidão: para ordens 1 a 3 e várias razões, cada saída é exatamente a soma das amostras ponderada
+//     pela resposta do CIC (convolução de order janelas de ratio amostras) dividida pelo ganho ratio^order,
+//     em Q8 truncado, e entregar as amostras em pedaços de tamanhos aleatórios não muda nada.
+//   - Constante: entrada fixa dá a própria constante em Q8, sem ruído, com mínimo = máximo.
+//   - Ruído: um valor entre dois códigos (2000,37) com ruído gaussiano de 2 LSB dá a média certa com
+//     fração, o desvio padrão bruto e o ruído das saídas perto de 2 / sqrt(ratio) (ordem 1).
+// Falha (código de saída 1) se alguma conferência não passar.
+//
+// Compilação: gcc -std=c11 -O2 -o decimator_test decimator_test.c decimator.c -lm
+// Uso:        decimator_test
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include "decimator.h"
+
+#define test_max_outputs 512
+#define test_pi 3.14159265358979323846
+
+static double test_gaussian(void) {
+    double u1 = (rand() + 1.0) / (RAND_MAX + 2.0), u2 = rand() / (RAND_MAX + 1.0);
+
+    return sqrt(-2 * log(u1)) * cos(2 * test_pi * u2);
+}
+
+// Resposta ao impulso do CIC: order janelas de ratio amostras convoluídas (order * (ratio - 1) + 1 pesos)
+static int cic_response(uint32_t ratio, int order, uint64_t *weights) {
+    int length = 1;
+
+    weights[0] = 1;
+    for (int n = 0; n < order; n++) {
+        uint64_t next[3 * 64] = { 0 };
+
+        for (int i = 0; i < length; i++) {
+            for (uint32_t j = 0; j < ratio; j++) {
+                next[i + j] += weights[i];
+            }
+        }
+        length += ratio - 1;
+        memcpy(weights, next, length * sizeof(uint64_t));
+    }
+
+    return length;
+}
+
+// Saídas pela definição e pelo decimador (em pedaços aleatórios); devolve as diferentes
+static int check_exact(uint32_t ratio, int order, uint32_t windows) {
+    static uint16_t samples[64 * 300];
+    static decimator_output_t outputs[test_max_outputs];
+    uint64_t weights[3 * 64];
+    uint64_t gain = 1;
+    decimator_t dec;
+    int length = cic_response(ratio, order, weights), produced = 0, errors = 0;
+
+    for (int i = 0; i < order; i++) {
+        gain *= ratio;
+    }
+    for (uint32_t i = 0; i < ratio * windows; i++) {
+        samples[i] = (uint16_t)(rand() % 4096);
+    }
+
+    decimator_init(&dec, ratio, (uint8_t)order);
+    for (uint32_t position = 0; position < ratio * windows;) {
+        int chunk = 1 + rand() % (3 * ratio);
+
+        if (chunk > (int)(ratio * windows - position)) {
+            chunk = ratio * windows - position;
+        }
+        produced += decimator_process(&dec, samples + position, chunk, outputs + produced, test_max_outputs - produced);
+        position += chunk;
+    }
+
+    // A primeira saída entregue fecha a janela order (as order - 1 primeiras são o transitório)
+    for (int k = 0; k < produced; k++) {
+        uint32_t last = (k + order) * ratio - 1;
+        uint64_t value = 0;
+
+        for (int j = 0; j < length; j++) {
+            value += weights[j] * samples[last - j];
+        }
+        errors += outputs[k].code_q8 != (uint32_t)((value << decimator_frac_bits) / gain);
+    }
+    if (produced != (int)windows - (order - 1)) {
+        errors++;
+    }
+
+    return errors;
+}
+
+int main(void) {
+    bool ok = true;
+    int cases = 0, errors = 0;
+
+    srand(1);
+    const uint32_t ratios[] = { 1, 2, 7, 16, 64 };
+    for (int order = 1; order <= decimator_max_order; order++) {
+        for (size_t r = 0; r < sizeof(ratios) / sizeof(ratios[0]); r++) {
+            int failed = check_exact(ratios[r], order, 300);
+
+            cases++;
+            errors += failed != 0;
+            if (failed) {
+                printf("  ordem %d, razao %u: %d saidas diferentes\n", order, ratios[r], failed);
+            }
+        }
+    }
+    printf("exatidao: %d combinacoes de ordem e razao, %d com saidas diferentes da definicao\n", cases, errors);
+    ok = ok && errors == 0;
+
+    // Constante
+    int constant_errors = 0;
+    for (int order = 1; order <= decimator_max_order; order++) {
+        static uint16_t samples[1000 * 5];
+        decimator_output_t outputs[5];
+        decimator_t dec;
+
+        for (int i = 0; i < 1000 * 5; i++) {
+            samples[i] = 3000;
+        }
+        decimator_init(&dec, 1000, (uint8_t)order);
+        int produced = decimator_process(&dec, samples, 1000 * 5, outputs, 5);
+
+        for (int k = 0; k < produced; k++) {
+            constant_errors += outputs[k].code_q8 != 3000 << decimator_frac_bits || outputs[k].raw_rms_q8 != 0 ||
+                               outputs[k].min != 3000 || outputs[k].max != 3000 || outputs[k].output_rms_q8 != 0;
+        }
+        constant_errors += produced != 5 - (order - 1);
+    }
+    printf("constante: %d saidas erradas\n", constant_errors);
+    ok = ok && constant_errors == 0;
+
+    // Ruído: ordem 1, razão 4096 (12 + 6 bits efetivos), 400 saídas
+    const uint32_t ratio = 4096;
+    const double level = 2000.37, sigma = 2;
+    static uint16_t block[4096];
+    decimator_output_t output;
+    decimator_t dec;
+    double sum = 0, sum_sq = 0, raw_rms = 0, output_rms = 0;
+    int outputs = 0;
+
+    decimator_init(&dec, ratio, 1);
+    for (int w = 0; w < 400; w++) {
+        for (uint32_t i = 0; i < ratio; i++) {
+            block[i] = (uint16_t)lround(level + sigma * test_gaussian());
+        }
+        if (decimator_process(&dec, block, ratio, &output, 1)) {
+            double code = output.code_q8 / 256.0;
+
+            sum += code;
+            sum_sq += code * code;
+            raw_rms = output.raw_rms_q8 / 256.0;
+            output_rms = output.output_rms_q8 / 256.0;
+            outputs++;
+        }
+    }
+
+    double mean = sum / outputs, spread = sqrt(sum_sq / outputs - mean * mean), expected = sigma / sqrt(ratio);
+    printf("ruido: media %.4f (real %.2f), bruto %.3f LSB (real %.1f), saidas %.4f LSB medido entre elas %.4f"
+           " (esperado %.4f), %u bits efetivos\n", mean, level, raw_rms, sigma, spread, output_rms, expected,
+           output.effective_bits);
+    ok = ok && fabs(mean - level) < 0.02 && fabs(raw_rms - sigma) < 0.2 && fabs(spread - expected) < 0.3 * expected &&
+         fabs(output_rms - expected) < 0.6 * expected && output.effective_bits == 18;
+
+    printf("%s\n", ok ? "OK" : "FALHOU");
+
+    return ok ? 0 : 1;
+}
@@ -11,12 +11,24 @@
  */
 #include <stdio.h>
 #include <string.h>
-#include <math.h>
+#include <assert.h>
 #include "pico/stdlib.h"
 #include "hardware/adc.h"
 #include "hardware/dma.h"
+#include "hardware/irq.h"
+#include "hardware/sync.h"
 #include "hardware/i2c.h"
+#include "pico/multicore.h"
+#include "pico/flash.h"
 #include "oled/ssd1306.h"
+#include "temperature_lut.h"
+#include "calibration/calibration.h"
+#include "decimator/decimator.h"
+#include "streamstats/streamstats.h"
+#include "trend/trend.h"
+#include "templog/templog.h"
+#include "reading_ring.h"
+#include "telemetry/telemetry.h"
 
 /*
  * DEFINIÇÕES DE HARDWARE
@@ -29,19 +41,100 @@
 #define OLED_ADDRESS 0x3C       // Endereço I2C do display
 #define OLED_WIDTH 128          // Largura do display em pixels
 #define OLED_HEIGHT 64          // Altura do display em pixels
+#define OLED_USE_PIO 0          // 1: display pelo I2C do PIO (fast-mode plus, mesmos pinos); 0: bloco I2C
+#define OLED_FPS_FRAMES 32      // Quadros completos enviados na medição de FPS
 
-// Buffer para armazenar as leituras do ADC
-#define ADC_BUFFER_SIZE 16      // Tamanho do buffer para média móvel
-uint16_t adc_buffer[ADC_BUFFER_SIZE]; // Buffer para armazenar leituras ADC
+// Saída das leituras pela USB
+#define TELEMETRY_BINARY 1      // 1: quadros binários (telemetry/telemetry_decode.cpp gera o CSV); 0: linhas de texto
+#define TELEMETRY_TEMPERATURE 1 // Tipo do registro de leitura
+#define TELEMETRY_STATS 2       // Tipo do registro das estatísticas do último minuto
+
+// Aquisição contínua do ADC: dois canais DMA encadeados preenchem dois buffers alternadamente (ping-pong)
+#define ADC_SAMPLE_RATE 250000  // Amostras por segundo do sensor de temperatura
+#define ADC_BLOCK_SIZE 1024     // Amostras por bloco (um bloco a cada ~4,1 ms)
+#define ADC_BLOCK_RING_BITS 11  // log2 do tamanho do bloco em bytes: o endereço de escrita volta sozinho ao início
+#define ADC_HOLD_BLOCKS 16      // Blocos guardados em RAM durante uma gravação do flash (~65 ms; um setor apagado leva ~45 ms)
+#define ADC_SAMPLES_PER_US_Q16 ((uint32_t)(((uint64_t)ADC_SAMPLE_RATE << 16) / 1000000)) // Amostras por µs (Q16)
+
+// Decimação: cada leitura é o resultado filtrado de DECIMATION_RATIO amostras
+// (250000 / 125000 = 2 leituras por segundo, que também atualizam o display e o log)
+#define DECIMATION_RATIO 125000
+#define DECIMATION_ORDER 1      // 1: média em bloco (boxcar); 2 ou 3: CIC (atenua mais o ruído fora da banda)
+
+// Estatísticas dos fluxos (streamstats/streamstats.h)
+#define ADC_STATS_P2_STRIDE 64  // Quantis das amostras brutas: uma a cada 64 entra no P² (janela = uma leitura)
+#define TEMP_STATS_PANE 20      // Leituras por painel (10 s)
+#define TEMP_STATS_PANES 6      // Janela deslizante de 6 painéis (1 minuto)
+
+// Gráfico do histórico (trend/trend.h): linhas 40 a 63 do display, uma coluna por balde
+#define GRAPH_Y 40              // Primeira linha (múltiplo de 8)
+#define GRAPH_HEIGHT 24         // Altura em pixels (múltiplo de 8)
+#define TREND_BUCKET_MS 1000    // Duração de um balde do nível mais fino
+
+// Registro das leituras no flash (templog/templog.h): uma leitura a cada TEMPLOG_PERIOD_MS
+#define TEMPLOG_PERIOD_MS (DECIMATION_RATIO * 1000 / ADC_SAMPLE_RATE)
+
+// Calibração de dois pontos do sensor (calibration/calibration.h), comandada por linhas na USB
+#define CALIBRATION_READINGS 20 // Leituras promediadas em cada ponto (10 s)
+#define COMMAND_MAX_LENGTH 24   // Comprimento máximo de uma linha de comando
+
+// Buffers preenchidos alternadamente pelo DMA, alinhados ao próprio tamanho para o modo anel
+uint16_t adc_buffer[2][ADC_BLOCK_SIZE] __attribute__((aligned(ADC_BLOCK_SIZE * sizeof(uint16_t))));
+static_assert((1 << ADC_BLOCK_RING_BITS) == ADC_BLOCK_SIZE * sizeof(uint16_t), "anel do DMA do tamanho do bloco");
+
+// Blocos completados enquanto o núcleo 0 grava o flash, processados pelo núcleo 1 ao fim da gravação
+uint16_t adc_hold_buffer[ADC_HOLD_BLOCKS][ADC_BLOCK_SIZE];
 
 /*
  * VARIÁVEIS GLOBAIS
+ * Núcleo 1: aquisição (ADC, DMA, decimação, conversão); núcleo 0: apresentação (display, terminal, flash, USB).
+ * Os dois só se comunicam pela fila reading_ring
  */
-volatile float temperature_c = 0.0f;    // Armazena a temperatura atual em Celsius
-volatile uint32_t sample_count = 0;     // Contador de amostras coletadas
-uint8_t oled_buffer[OLED_WIDTH * OLED_HEIGHT / 8]; // Buffer para o display OLED
-int dma_chan;                          // Canal DMA utilizado
-dma_channel_config dma_config;         // Configuração do canal DMA
+reading_ring_t reading_ring;           // Leituras do núcleo 1 para o núcleo 0
+
+// Núcleo 0
+int32_t temperature_centi = 0;         // Temperatura atual em centésimos de grau Celsius
+ssd1306_t oled;                        // Display OLED (framebuffer, filas e canal DMA próprios)
+templog_t temp_log;                    // Registro circular das leituras no flash
+streamstats_t temp_stats;              // Estatísticas das leituras (último minuto)
+trend_t temp_trend;                    // Histórico em vários níveis (minutos a dias)
+trend_graph_t temp_graph;              // Gráfico do histórico no display
+calibration_t calibration;             // Pontos da calibração (gravados no flash ou em captura)
+bool calibrated = false;               // Tabela montada com a calibração (senão, com o datasheet)
+int calibration_point = -1;            // Ponto em captura (0 ou 1); -1: nenhum
+uint32_t calibration_captured = 0;     // Pontos capturados desde o último ajuste (bit 0 e bit 1)
+uint32_t calibration_readings = 0;     // Leituras somadas no ponto em captura
+uint64_t calibration_code_sum = 0;     // Soma dos códigos do ADC (Q8) do ponto em captura
+char command_line[COMMAND_MAX_LENGTH]; // Linha de comando em recepção pela USB
+int command_length = 0;
+
+// Núcleo 1
+int adc_dma_chan[2];                   // Canais DMA do ping-pong (cada um encadeia o outro)
+volatile bool adc_block_full[2];       // Bloco completo aguardando processamento
+int adc_next_block = 0;                // Próximo bloco a processar (mantém a ordem das amostras)
+
+// Contadores da aquisição
+volatile uint32_t adc_blocks_done = 0;    // Blocos completados pelo DMA
+volatile uint32_t adc_block_overruns = 0; // Blocos sobrescritos antes de serem processados
+volatile uint32_t adc_fifo_overruns = 0;  // Estouros do FIFO do ADC (DMA atrasado)
+volatile uint32_t adc_blocks_lost = 0;    // Blocos inteiros perdidos com as interrupções deste núcleo desligadas
+volatile uint32_t adc_hold_dropped = 0;   // Blocos que não couberam em adc_hold_buffer durante uma gravação do flash
+uint32_t adc_hold_count = 0;              // Blocos guardados na última gravação do flash
+uint32_t adc_blocks_skipped = 0;          // Blocos perdidos já descontados na contagem de amostras
+uint32_t adc_samples_processed = 0;       // Amostras desde o início da aquisição (processadas e perdidas)
+uint32_t adc_irq_us = 0;                  // Instante da última interrupção de fim de bloco
+uint32_t adc_irq_position = 0;            // Amostras do bloco em curso já escritas nesse instante
+
+decimator_t temp_decimator;                // Decimador do canal de temperatura
+streamstats_t adc_stats;                   // Estatísticas das amostras brutas, na janela de cada leitura
+uint32_t reading_sequence = 0;             // Leituras produzidas (inclusive as descartadas com a fila cheia)
+
+// Gravação do flash (flash_safe_execute()): o núcleo 0 pede e o núcleo 1 passa a executar só da RAM,
+// guardando os blocos que chegam, em vez de ser pausado com as interrupções desligadas
+volatile bool acquisition_running = false; // Núcleo 1 no laço da aquisição (atende os pedidos)
+volatile bool flash_hold_request = false;  // Escrito só pelo núcleo 0
+volatile bool flash_hold_active = false;   // Escrito só pelo núcleo 1: executando só da RAM
+uint32_t flash_hold_interrupts;            // Estado das interrupções do núcleo 0 durante a gravação
 
 /*
  * FUNÇÃO: init_adc_temp_sensor()
@@ -64,58 +157,154 @@ void init_adc_temp_sensor() {
         false    // Não reduzir amostras (usar todas as 12 bits)
     );
     
-    adc_set_clkdiv(0); // Configura o ADC para máxima velocidade (clock divisor = 0)
+    // Uma conversão a cada (1 + div) ciclos do clock de 48MHz do ADC
+    adc_set_clkdiv(48000000.0f / ADC_SAMPLE_RATE - 1);
+}
+
+/*
+ * FUNÇÃO: adc_dma_position()
+ * RETORNO: amostras já escritas no bloco em curso (canal DMA ativo)
+ * - Em RAM, como a interrupção que a usa
+ */
+uint32_t __not_in_flash_func(adc_dma_position)() {
+    for (int i = 0; i < 2; i++) {
+        if (dma_channel_is_busy(adc_dma_chan[i])) {
+            return ADC_BLOCK_SIZE - dma_channel_hw_addr(adc_dma_chan[i])->transfer_count;
+        }
+    }
+
+    return 0; // Entre o fim de um canal e o início do outro
+}
+
+/*
+ * FUNÇÃO: adc_dma_irq_handler()
+ * DESCRIÇÃO: Interrupção de fim de bloco do DMA do ADC
+ * - O canal que terminou já passou a vez ao outro (encadeamento), sem perder amostras
+ * - O endereço de escrita já voltou ao início do buffer (modo anel): nada a rearmar
+ * - Marca o bloco como completo e conta blocos não processados a tempo e estouros do FIFO
+ * - Se as interrupções deste núcleo ficarem desligadas por mais de um bloco, o DMA segue em anel
+ *   e cada canal guarda só um aviso pendente: os blocos que passaram são contados pelo tempo decorrido,
+ *   acertado pela posição do DMA no bloco em curso, para que a contagem de amostras siga o relógio
+ * - Em RAM e sem divisões (as rotinas de divisão ficam no flash): continua sendo atendida enquanto
+ *   o núcleo 0 grava o flash
+ */
+void __not_in_flash_func(adc_dma_irq_handler)() {
+    uint32_t now = time_us_32();
+    uint32_t position = adc_dma_position();
+    uint32_t flagged = 0;
+
+    for (int i = 0; i < 2; i++) {
+        if (!dma_channel_get_irq1_status(adc_dma_chan[i])) {
+            continue;
+        }
+        dma_channel_acknowledge_irq1(adc_dma_chan[i]);
+
+        if (adc_block_full[i]) {
+            adc_block_overruns++; // O conteúdo anterior deste buffer não chegou a ser processado
+        }
+        adc_block_full[i] = true;
+        adc_blocks_done++;
+        flagged++;
+    }
+
+    // Blocos terminados desde a última interrupção: amostras pelo relógio, arredondadas ao bloco pela
+    // posição exata do DMA (tolera meio bloco de atraso da interrupção). Amostras decorridas em Q16 com
+    // multiplicações de 32 bits, em duas partes (exato a uma amostra, até ~67 s sem interrupção)
+    uint32_t elapsed_us = now - adc_irq_us;
+    uint32_t elapsed_samples = ((elapsed_us >> 8) * ADC_SAMPLES_PER_US_Q16 +
+                                (((elapsed_us & 0xFF) * ADC_SAMPLES_PER_US_Q16) >> 8)) >> 8;
+    int32_t samples = (int32_t)elapsed_samples + (int32_t)adc_irq_position - (int32_t)position;
+    int32_t blocks = (samples + ADC_BLOCK_SIZE / 2) / ADC_BLOCK_SIZE;
+
+    if (flagged && blocks > (int32_t)flagged) {
+        uint32_t lost = (uint32_t)blocks - flagged; // Sobrescritos sem aviso: perdidos
+
+        adc_blocks_done += lost;
+        adc_block_overruns += lost;
+        adc_blocks_lost += lost;
+    }
+    adc_irq_us = now;
+    adc_irq_position = position;
+
+    if (adc_hw->fcs & ADC_FCS_OVER_BITS) {
+        adc_fifo_overruns++;
+        adc_hw->fcs |= ADC_FCS_OVER_BITS; // Limpa o indicador (escrever 1)
+    }
 }
 
 /*
  * FUNÇÃO: init_dma_adc_transfer()
- * DESCRIÇÃO: Configura o DMA para transferir automaticamente as leituras do ADC
- * - Reserva um canal DMA disponível
- * - Configura o canal para transferir dados de 16 bits
- * - Define o FIFO do ADC como origem e nosso buffer como destino
- * - Configura o DMA para ser acionado pelo ADC (DREQ_ADC)
+ * DESCRIÇÃO: Configura a aquisição contínua do ADC com dois canais DMA em ping-pong
+ * - Cada canal transfere um bloco do FIFO do ADC para o seu buffer e dispara o outro ao terminar
+ * - A escrita em anel mantém cada canal no seu buffer mesmo com as interrupções desligadas,
+ *   quando a interrupção não pode rearmar o endereço
+ * - A interrupção de fim de bloco (DMA_IRQ_1, só deste módulo) entrega o bloco ao processamento;
+ *   tratador exclusivo, chamado direto da tabela de vetores em RAM
+ * - A CPU nunca espera pelo ADC
  */
 void init_dma_adc_transfer() {
-    // Reserva um canal DMA não utilizado
-    dma_chan = dma_claim_unused_channel(true);
-    
-    // Obtém configuração padrão para o canal DMA
-    dma_config = dma_channel_get_default_config(dma_chan);
-    
-    // Configurações específicas:
-    channel_config_set_transfer_data_size(&dma_config, DMA_SIZE_16); // Dados de 16 bits
-    channel_config_set_read_increment(&dma_config, false); // Origem não incrementa (FIFO)
-    channel_config_set_write_increment(&dma_config, true); // Destino incrementa (buffer)
-    channel_config_set_dreq(&dma_config, DREQ_ADC); // Usar sinal do ADC para controle
-    
-    // Configura a transferência DMA:
-    dma_channel_configure(
-        dma_chan,               // Canal DMA
-        &dma_config,            // Configuração
-        adc_buffer,             // Buffer de destino (RAM)
-        &adc_hw->fifo,          // Fonte (FIFO do ADC)
-        ADC_BUFFER_SIZE,        // Número de transferências
-        false                   // Não iniciar ainda
-    );
-    
-    // Inicia as conversões contínuas do ADC
+    adc_dma_chan[0] = dma_claim_unused_channel(true);
+    adc_dma_chan[1] = dma_claim_unused_channel(true);
+
+    for (int i = 0; i < 2; i++) {
+        dma_channel_config config = dma_channel_get_default_config(adc_dma_chan[i]);
+
+        channel_config_set_transfer_data_size(&config, DMA_SIZE_16); // Dados de 16 bits
+        channel_config_set_read_increment(&config, false); // Origem não incrementa (FIFO)
+        channel_config_set_write_increment(&config, true); // Destino incrementa (buffer)
+        channel_config_set_ring(&config, true, ADC_BLOCK_RING_BITS); // ... e volta ao início a cada bloco
+        channel_config_set_dreq(&config, DREQ_ADC); // Usar sinal do ADC para controle
+        channel_config_set_chain_to(&config, adc_dma_chan[i ^ 1]); // Ao terminar, dispara o outro canal
+
+        dma_channel_configure(
+            adc_dma_chan[i],        // Canal DMA
+            &config,                // Configuração
+            adc_buffer[i],          // Buffer de destino (RAM)
+            &adc_hw->fifo,          // Fonte (FIFO do ADC)
+            ADC_BLOCK_SIZE,         // Número de transferências (recarregado a cada disparo)
+            false                   // Não iniciar ainda
+        );
+        dma_channel_set_irq1_enabled(adc_dma_chan[i], true);
+    }
+
+    irq_set_exclusive_handler(DMA_IRQ_1, adc_dma_irq_handler);
+    irq_set_enabled(DMA_IRQ_1, true);
+
+    // Começa pelo primeiro buffer e inicia as conversões contínuas do ADC
+    adc_fifo_drain();
+    dma_channel_start(adc_dma_chan[0]);
+    adc_irq_us = time_us_32();
     adc_run(true);
 }
 
 /*
  * FUNÇÃO: calculate_temperature()
  * PARÂMETROS:
- *   - adc_value: valor digital lido do ADC (12 bits)
- * RETORNO: temperatura em graus Celsius
- * DESCRIÇÃO: Converte o valor do ADC para temperatura usando a fórmula do datasheet
+ *   - code_q8: valor do ADC decimado (12 bits inteiros e 8 de fração)
+ * RETORNO: temperatura em centésimos de grau Celsius
+ * DESCRIÇÃO: Converte o valor do ADC para temperatura pela tabela de temperature_lut.h
+ * (montada na partida com a calibração ou a fórmula do datasheet, interpolada na fração), sem ponto flutuante
  */
-float calculate_temperature(uint16_t adc_value) {
-    // Converte valor ADC para tensão (referência de 3.3V, 12 bits)
-    float voltage = adc_value * 3.3f / (1 << 12);
-    
-    // Fórmula do datasheet do RP2040 para sensor de temperatura:
-    // Temperatura = 27 - (V_sensor - 0.706)/0.001721
-    return 27.0f - (voltage - 0.706f) / 0.001721f;
+int32_t calculate_temperature(uint32_t code_q8) {
+    return temperature_centi_from_adc_q8(code_q8);
+}
+
+/*
+ * FUNÇÃO: split_temperature()
+ * PARÂMETROS:
+ *   - centi: temperatura em centésimos de grau
+ *   - sign, whole, tenth: sinal ("-" ou ""), parte inteira e décimo, arredondados
+ * DESCRIÇÃO: Separa a temperatura para exibição com uma casa decimal, só com inteiros
+ */
+void split_temperature(int centi, const char **sign, int *whole, int *tenth) {
+    int deci = (centi >= 0 ? centi + 5 : centi - 5) / 10; // Arredonda para décimos
+
+    *sign = deci < 0 ? "-" : "";
+    if (deci < 0) {
+        deci = -deci;
+    }
+    *whole = deci / 10;
+    *tenth = deci % 10;
 }
 
 /*
@@ -127,8 +316,7 @@ float calculate_temperature(uint16_t adc_value) {
  * DESCRIÇÃO: Centraliza um texto horizontalmente em uma linha do display
  */
 void center_text(uint8_t *buffer, int page, const char *text) {
-    int text_length = strlen(text);
-    int x_pos = (OLED_WIDTH - (text_length * 8)) / 2; // Calcula posição central
+    int x_pos = (OLED_WIDTH - ssd1306_measure_string(text, 1)) / 2; // Calcula posição central
     if (x_pos < 0) x_pos = 0; // Garante que não seja negativo
     ssd1306_draw_string(buffer, x_pos, page * 8, text); // Desenha o texto
 }
@@ -141,6 +329,10 @@ void center_text(uint8_t *buffer, int page, const char *text) {
  * - Limpa o buffer e o display
  */
 void init_oled() {
+#if OLED_USE_PIO
+    // O programa PIO assume os pinos e configura os pull-ups
+    ssd1306_init_pio_i2c(&oled, pio0, I2C_SDA_PIN, I2C_SCL_PIN, OLED_ADDRESS);
+#else
     // Configura o hardware I2C
     i2c_init(I2C_PORT, 400 * 1000); // Inicializa I2C a 400kHz
     gpio_set_function(I2C_SDA_PIN, GPIO_FUNC_I2C); // Configura pino SDA
@@ -149,10 +341,11 @@ void init_oled() {
     gpio_pull_up(I2C_SCL_PIN); // Habilita pull-up no SCL
     
     // Inicializa o display OLED
-    ssd1306_init();
+    ssd1306_init(&oled, I2C_PORT, OLED_ADDRESS);
+#endif
     
     // Limpa o buffer do display
-    memset(oled_buffer, 0, sizeof(oled_buffer));
+    ssd1306_clear(&oled);
     
     // Define área de renderização (toda a tela)
     struct render_area area = {
@@ -164,120 +357,670 @@ void init_oled() {
     
     // Calcula tamanho do buffer e renderiza
     calculate_render_area_buffer_length(&area);
-    render_on_display(oled_buffer, &area);
+    render_on_display(&oled, &area);
+}
+
+/*
+ * FUNÇÃO: report_oled_fps()
+ * DESCRIÇÃO: Mede a taxa de quadros do transporte do display
+ * - Envia OLED_FPS_FRAMES quadros completos (pior caso, sem atualização parcial)
+ * - Imprime os quadros por segundo no terminal
+ * - Valores esperados, só ESTIMATIVAS pelo tempo de barramento (1034/1030 bytes por quadro, sem pausas
+ *   entre transações; oled/bench_oled.c), ainda não medidos na placa: I2C a 400 kHz ~43 quadros/s,
+ *   I2C por PIO a 1 MHz ~107 quadros/s, SPI por PIO a 10 MHz ~1200 quadros/s. A medida é o que esta função imprime
+ */
+void report_oled_fps() {
+    uint64_t start = time_us_64();
+
+    for (int i = 0; i < OLED_FPS_FRAMES; i++) {
+        ssd1306_send_data(&oled);
+    }
+    ssd1306_wait_frame(&oled);
+
+    uint64_t elapsed = time_us_64() - start;
+    printf("OLED (%s): %lu quadros/s\n", OLED_USE_PIO ? "I2C por PIO" : "I2C",
+           (unsigned long)(OLED_FPS_FRAMES * 1000000ULL / elapsed));
+}
+
+/*
+ * FUNÇÃO: format_span()
+ * PARÂMETROS:
+ *   - text: destino do texto
+ *   - seconds: intervalo de tempo
+ * DESCRIÇÃO: Escreve um intervalo de forma curta ("2min", "9h", "6d")
+ */
+void format_span(char *text, size_t size, uint32_t seconds) {
+    if (seconds < 2 * 3600) {
+        snprintf(text, size, "%lumin", (seconds + 30) / 60);
+    }
+    else if (seconds < 2 * 86400) {
+        snprintf(text, size, "%luh", (seconds + 1800) / 3600);
+    }
+    else {
+        snprintf(text, size, "%lud", (seconds + 43200) / 86400);
+    }
 }
 
 /*
  * FUNÇÃO: update_display()
  * PARÂMETROS:
- *   - temp: temperatura a ser exibida
- *   - count: contador de amostras
- * DESCRIÇÃO: Atualiza o display OLED com a temperatura e contador
- * - Formata a temperatura como "XX,X°C"
- * - Centraliza os textos
- * - Exibe o contador de amostras
+ *   - temp_centi: temperatura a ser exibida, em centésimos de grau
+ *   - completed: níveis do histórico que completaram um balde com esta leitura (trend_add())
+ *   - stats: estatísticas do último minuto (NULL enquanto não houver)
+ * DESCRIÇÃO: Atualiza o display OLED com a temperatura e o gráfico do histórico
+ * - Linha 1: intervalo e escala do gráfico ("Temperatura" enquanto não houver gráfico)
+ * - Formata a temperatura como "XX,X°C" e a centraliza
+ * - Linha 5: mínimo/máximo e desvio padrão do último minuto
+ * - Linhas 6 a 8: gráfico do histórico (faixa mínimo-máximo por coluna), no nível que cobre
+ *   todo o histórico, de minutos a dias
+ * - Só a parte de texto é apagada e redesenhada; o gráfico rola uma coluna por balde novo
+ * - Envia somente as regiões alteradas desde a última atualização
  */
-void update_display(float temp, uint32_t count) {
-    char temp_str[16], samples_str[24];
-    
-    // Limpa o buffer do display
-    memset(oled_buffer, 0, sizeof(oled_buffer));
+void update_display(int temp_centi, uint32_t completed, const streamstats_summary_t *stats) {
+    char temp_str[16], header_str[24], stats_str[24];
+
+    // Gráfico primeiro: a linha de cima mostra a escala que ele escolher
+    trend_graph_update(&temp_graph, &temp_trend, oled.ram_buffer, completed);
 
-    // Linha 1: Título "Temperatura" centralizado
-    center_text(oled_buffer, 0, "Temperatura");
+    // Limpa só a área de texto, acima do gráfico
+    ssd1306_fill_rect(oled.ram_buffer, 0, 0, OLED_WIDTH, GRAPH_Y, false);
+
+    // Linha 1: intervalo coberto pelo gráfico e a sua escala vertical
+    if (temp_graph.level < 0) {
+        center_text(oled.ram_buffer, 0, "Temperatura");
+    }
+    else {
+        const char *lo_sign, *hi_sign;
+        int lo_int, lo_decimal, hi_int, hi_decimal;
+        char span_str[8];
+
+        format_span(span_str, sizeof(span_str),
+                    temp_graph.w * trend_bucket_readings(&temp_trend, temp_graph.level) * TEMPLOG_PERIOD_MS / 1000);
+        split_temperature(temp_graph.lo, &lo_sign, &lo_int, &lo_decimal);
+        split_temperature(temp_graph.hi, &hi_sign, &hi_int, &hi_decimal);
+        snprintf(header_str, sizeof(header_str), "%s %s%d,%d a %s%d,%d",
+                 span_str, lo_sign, lo_int, lo_decimal, hi_sign, hi_int, hi_decimal);
+
+        // Mais largo que a tela (ex.: "34min 24,0 a 25,0", 17 caracteres): separador curto e, se
+        // ainda não couber (valores negativos, "120min"), só as partes inteiras
+        if (ssd1306_measure_string(header_str, 1) > OLED_WIDTH) {
+            snprintf(header_str, sizeof(header_str), "%s %s%d,%d-%s%d,%d",
+                     span_str, lo_sign, lo_int, lo_decimal, hi_sign, hi_int, hi_decimal);
+        }
+        if (ssd1306_measure_string(header_str, 1) > OLED_WIDTH) {
+            snprintf(header_str, sizeof(header_str), "%s %s%d a %s%d", span_str, lo_sign, lo_int, hi_sign, hi_int);
+        }
+        center_text(oled.ram_buffer, 0, header_str);
+    }
 
     // Linha 2: Formata a temperatura como "XX,X°C"
-    int temp_int = (int)temp; // Parte inteira
-    // Parte decimal (arredondada para 1 dígito)
-    int temp_decimal = (int)((fabs(temp) - fabs((float)temp_int)) * 10 + 0.5f);
+    const char *sign;
+    int temp_int, temp_decimal; // Parte inteira e decimal (arredondada para 1 dígito)
+    split_temperature(temp_centi, &sign, &temp_int, &temp_decimal);
     
     // Formata a string com vírgula (0x2C) e símbolo de grau (0xF8)
-    snprintf(temp_str, sizeof(temp_str), "%d%c%d%cC", 
-            temp_int, 0x2C, temp_decimal, 0xF8);
+    snprintf(temp_str, sizeof(temp_str), "%s%d%c%d%cC", 
+            sign, temp_int, 0x2C, temp_decimal, 0xF8);
 
-    // Centraliza o texto da temperatura (em tamanho 2x)
-    int text_width = strlen("00,0°C") * 16; // Largura fixa para centralização
+    // Centraliza o texto da temperatura (em tamanho 2x) pela largura real dos glifos
+    int text_width = ssd1306_measure_string(temp_str, 2);
     int x_pos = (OLED_WIDTH - text_width) / 2;
     
-    // Desenha cada caractere com posicionamento personalizado
+    // Desenha cada caractere com posicionamento personalizado (a vírgula termina na linha 31, acima das estatísticas)
     for (int i = 0; i < strlen(temp_str); i++) {
-        int y_pos = 20; // Posição base
+        int y_pos = 12; // Posição base
         
-        // Ajusta posição da vírgula (6px mais baixo)
+        // Ajusta posição da vírgula (4px mais baixo)
         if (temp_str[i] == 0x2C) {
-            y_pos = 26;
+            y_pos = 16;
         }
         // Ajusta posição do símbolo de grau e 'C'
         else if (temp_str[i] == 0xF8 || temp_str[i] == 'C') {
-            y_pos = 16;
+            y_pos = 8;
         }
         
         // Desenha caractere em tamanho 2x
-        ssd1306_draw_char_scale2(oled_buffer, x_pos, y_pos, temp_str[i]);
-        x_pos += 16; // Avança para próxima posição
+        ssd1306_draw_char_scale2(oled.ram_buffer, x_pos, y_pos, temp_str[i]);
+        x_pos += 2 * ssd1306_char_advance; // Avança para próxima posição
     }
 
-    // Linha inferior: Contador de amostras
-    snprintf(samples_str, sizeof(samples_str), "Amostra: %lu", count);
-    center_text(oled_buffer, (OLED_HEIGHT/8)-1, samples_str);
+    // Linha 5: "min/max dp" do último minuto, logo acima do gráfico
+    if (stats) {
+        const char *min_sign, *max_sign;
+        int min_int, min_decimal, max_int, max_decimal;
+        uint32_t sd_centi = (streamstats_stddev_q8(stats) + 128) >> 8;
 
-    // Renderiza tudo no display
-    struct render_area area = {
-        .start_column = 0,
-        .end_column = OLED_WIDTH - 1,
-        .start_page = 0,
-        .end_page = OLED_HEIGHT/8 - 1
+        split_temperature(stats->moments.min, &min_sign, &min_int, &min_decimal);
+        split_temperature(stats->moments.max, &max_sign, &max_int, &max_decimal);
+        snprintf(stats_str, sizeof(stats_str), "%s%d,%d/%s%d,%d dp%lu,%02lu", min_sign, min_int, min_decimal,
+                 max_sign, max_int, max_decimal, sd_centi / 100, sd_centi % 100);
+        center_text(oled.ram_buffer, 4, stats_str);
+    }
+
+    // Envia ao display apenas as páginas/colunas que mudaram
+    render_changes_on_display(&oled);
+}
+
+/*
+ * FUNÇÃO: print_log_reading()
+ * DESCRIÇÃO: Imprime uma leitura do registro em CSV (partida, tempo em ms, temperatura em °C)
+ */
+void print_log_reading(uint16_t boot, uint32_t time_ms, int32_t centi, void *user_data) {
+    const char *sign;
+    int whole, tenth;
+
+    split_temperature(centi, &sign, &whole, &tenth);
+    printf("%u,%lu,%s%d.%d\n", boot, time_ms, sign, whole, tenth);
+}
+
+/*
+ * FUNÇÃO: dump_log()
+ * PARÂMETROS:
+ *   - command: 'd' despeja a região do flash em binário; 'c' imprime as leituras em CSV
+ * DESCRIÇÃO: Exporta o registro pela USB
+ * - Grava antes o que está pendente em RAM
+ * - O despejo binário é a imagem da região (templog_region_size bytes, sem tradução de fim de linha),
+ *   lida no computador por templog_host_load()
+ * - A aquisição continua no núcleo 1; leituras que não couberem na fila são contadas como descartadas
+ */
+void dump_log(int command) {
+    templog_flush(&temp_log);
+
+    if (command == 'd') {
+        const uint8_t *flash = templog_flash_base();
+
+        printf("TEMPLOG %u\n", templog_region_size);
+        for (uint32_t i = 0; i < templog_region_size; i++) {
+            putchar_raw(flash[i]);
+        }
+        stdio_flush();
+    }
+    else if (command == 'c') {
+        printf("boot,tempo_ms,temperatura_c\n");
+        uint32_t count = templog_for_each(templog_flash_base(), print_log_reading, NULL);
+        printf("# %lu leituras, %lu bytes\n", count, templog_used_bytes(&temp_log));
+    }
+}
+
+/*
+ * FUNÇÃO: parse_centi()
+ * PARÂMETROS:
+ *   - text: temperatura em °C, com até duas casas decimais (ponto ou vírgula), ex.: "23.5" ou "-4,25"
+ *   - centi: temperatura lida em centésimos de grau
+ * DESCRIÇÃO: Converte o texto sem ponto flutuante; retorna false se não for um número
+ */
+bool parse_centi(const char *text, int32_t *centi) {
+    int32_t sign = 1, whole = 0, fraction = 0;
+    int digits = 0, decimals = 0;
+
+    while (*text == ' ') text++;
+    if (*text == '-' || *text == '+') {
+        sign = *text++ == '-' ? -1 : 1;
+    }
+    for (; *text >= '0' && *text <= '9' && whole < 100000; text++, digits++) {
+        whole = whole * 10 + (*text - '0');
+    }
+    if (*text == '.' || *text == ',') {
+        for (text++; *text >= '0' && *text <= '9'; text++, digits++) {
+            if (decimals < 2) {
+                fraction = fraction * 10 + (*text - '0');
+                decimals++;
+            }
+        }
+    }
+    while (*text == ' ') text++;
+    if (!digits || *text) {
+        return false;
+    }
+
+    for (; decimals < 2; decimals++) {
+        fraction *= 10;
+    }
+    *centi = sign * (whole * 100 + fraction);
+
+    return true;
+}
+
+/*
+ * FUNÇÃO: print_calibration()
+ * DESCRIÇÃO: Mostra no terminal os pontos e a reta em uso (centésimos de grau por LSB)
+ */
+void print_calibration() {
+    int64_t offset_q16 = temperature_default_offset_q16, slope_q16 = temperature_default_slope_q16;
+
+    if (calibrated) {
+        calibration_line(&calibration, &offset_q16, &slope_q16);
+        for (int i = 0; i < 2; i++) {
+            printf("CAL ponto %d: ADC %lu.%03lu = %ld centesimos de grau\n", i + 1,
+                   calibration.code_q8[i] >> 8, ((calibration.code_q8[i] & 0xFF) * 1000) >> 8, calibration.centi[i]);
+        }
+    }
+    printf("CAL %s: T(0) = %ld, inclinacao %ld/1000 centesimos por LSB\n", calibrated ? "calibrado" : "datasheet",
+           (int32_t)(offset_q16 >> 16), (int32_t)(slope_q16 * 1000 / 65536));
+}
+
+/*
+ * FUNÇÃO: capture_calibration()
+ * PARÂMETROS:
+ *   - code_q8: código médio do ADC da leitura (saída do decimador, independente da tabela)
+ * DESCRIÇÃO: Soma as leituras do ponto em captura; com os dois pontos prontos, grava a calibração
+ * - A gravação afasta o núcleo 1 do flash e remonta a tabela de conversão de uma vez (calibration_store())
+ * - Se a gravação falhar, avisa e mantém os pontos capturados
+ */
+void capture_calibration(uint32_t code_q8) {
+    if (calibration_point < 0) {
+        return;
+    }
+
+    calibration_code_sum += code_q8;
+    if (++calibration_readings < CALIBRATION_READINGS) {
+        return;
+    }
+
+    calibration.code_q8[calibration_point] = (int32_t)((calibration_code_sum + CALIBRATION_READINGS / 2) / CALIBRATION_READINGS);
+    calibration_captured |= 1u << calibration_point;
+    printf("CAL ponto %d capturado: ADC %lu.%03lu\n", calibration_point + 1,
+           calibration.code_q8[calibration_point] >> 8, ((calibration.code_q8[calibration_point] & 0xFF) * 1000) >> 8);
+    calibration_point = -1;
+
+    if (calibration_captured == 3) {
+        int64_t offset_q16, slope_q16;
+
+        if (!calibration_line(&calibration, &offset_q16, &slope_q16)) {
+            calibration_captured = 0;
+            printf("CAL rejeitada: pontos muito proximos ou inclinacao fora da faixa\n");
+        }
+        else if (calibration_store(&calibration)) {
+            calibration_captured = 0;
+            calibrated = true;
+            print_calibration();
+        }
+        else {
+            // Nada foi gravado nem a tabela mudou; os pontos ficam: repetir um deles tenta gravar de novo
+            printf("CAL nao gravada: falha ao gravar o flash (repita k1 ou k2)\n");
+        }
+    }
+}
+
+/*
+ * FUNÇÃO: handle_command()
+ * PARÂMETROS:
+ *   - command: caractere recebido pela USB
+ * DESCRIÇÃO: Atende os comandos da USB
+ * - 'd' ou 'c' no início da linha: exporta o registro (dump_log())
+ * - Linhas terminadas em Enter:
+ *   "k1 <°C>" e "k2 <°C>": captura um ponto da calibração com o sensor na temperatura de referência
+ *   (medida por um termômetro externo); o segundo ponto grava a calibração
+ *   "k0": apaga a calibração (volta à reta do datasheet); "k": mostra a reta em uso
+ */
+void handle_command(int command) {
+    if (command_length == 0 && (command == 'd' || command == 'c')) {
+        dump_log(command);
+        return;
+    }
+    if (command != '\r' && command != '\n') {
+        if (command_length < COMMAND_MAX_LENGTH - 1) {
+            command_line[command_length++] = (char)command;
+        }
+        return;
+    }
+    if (command_length == 0) {
+        return;
+    }
+
+    command_line[command_length] = '\0';
+    command_length = 0;
+
+    int32_t reference;
+    if (strcmp(command_line, "k") == 0) {
+        print_calibration();
+    }
+    else if (strcmp(command_line, "k0") == 0) {
+        if (!calibration_store(NULL)) {
+            printf("CAL nao apagada: falha ao gravar o flash\n");
+            return;
+        }
+        memset(&calibration, 0, sizeof(calibration));
+        calibrated = false;
+        calibration_point = -1;
+        calibration_captured = 0;
+        print_calibration();
+    }
+    else if ((command_line[0] == 'k' && (command_line[1] == '1' || command_line[1] == '2')) &&
+             parse_centi(command_line + 2, &reference)) {
+        calibration_point = command_line[1] - '1';
+        calibration.centi[calibration_point] = reference;
+        calibration_readings = 0;
+        calibration_code_sum = 0;
+        printf("CAL capturando ponto %d em %ld centesimos de grau (%d leituras)\n",
+               calibration_point + 1, reference, CALIBRATION_READINGS);
+    }
+    else {
+        printf("Comando desconhecido: %s\n", command_line);
+    }
+}
+
+/*
+ * FUNÇÃO: handle_reading()
+ * PARÂMETROS:
+ *   - record: leitura recebida do núcleo 1 (temperatura, saída do decimador e contadores)
+ * DESCRIÇÃO: Apresenta uma leitura (núcleo 0): registra no terminal e no flash e atualiza o display
+ */
+void handle_reading(const reading_record_t *record) {
+    const decimator_output_t *reading = &record->reading;
+
+    temperature_centi = record->temperature_centi;
+    capture_calibration(reading->code_q8);
+
+    // Só codifica em RAM; a gravação fica para templog_service() no laço principal
+    templog_append(&temp_log, record->time_ms, temperature_centi);
+
+    // Estatísticas do último minuto
+    streamstats_summary_t stats;
+    streamstats_add(&temp_stats, temperature_centi);
+    bool have_stats = streamstats_sliding(&temp_stats, &stats);
+
+    // Log pela USB: valor decimado, ruído bruto e da saída (em LSB), contadores da aquisição
+    // e leituras descartadas na fila entre os núcleos
+#if TELEMETRY_BINARY
+    int32_t values[] = {
+        record->sequence, record->time_ms, temperature_centi,
+        (int32_t)((reading->code_q8 * 1000) >> 8), reading->effective_bits,
+        (int32_t)((reading->raw_rms_q8 * 1000) >> 8), reading->min, reading->max,
+        (int32_t)((reading->output_rms_q8 * 1000) >> 8),
+        record->blocks_done, record->block_overruns, record->fifo_overruns, record->dropped,
+        templog_used_bytes(&temp_log),
+        (int32_t)((record->adc_quantile_q8[0] * 1000) >> 8), (int32_t)((record->adc_quantile_q8[1] * 1000) >> 8),
+        (int32_t)((record->adc_quantile_q8[2] * 1000) >> 8)
     };
-    calculate_render_area_buffer_length(&area);
-    render_on_display(oled_buffer, &area);
+    telemetry_send(TELEMETRY_TEMPERATURE, record->time_ms * 1000, values, count_of(values));
+
+    // Estatísticas do último minuto num registro à parte (as duas descrições juntas não cabem num quadro),
+    // ligado à leitura pelo número de sequência
+    if (have_stats) {
+        int32_t stats_values[] = {
+            record->sequence, stats.moments.min, stats.moments.max, (streamstats_mean_q8(&stats) + 128) >> 8,
+            (int32_t)((streamstats_stddev_q8(&stats) + 128) >> 8), (stats.quantile_q8[0] + 128) >> 8,
+            (stats.quantile_q8[1] + 128) >> 8, (stats.quantile_q8[2] + 128) >> 8
+        };
+        telemetry_send(TELEMETRY_STATS, record->time_ms * 1000, stats_values, count_of(stats_values));
+    }
+#else
+    const char *sign;
+    int temp_int, temp_decimal;
+    split_temperature(temperature_centi, &sign, &temp_int, &temp_decimal);
+    printf("Leitura %lu (%lu ms): %s%d.%d°C ADC %lu.%03lu (%u bits) ruido %lu.%02lu LSB [%u-%u] saida %lu.%03lu LSB"
+           " | amostras %lu blocos %lu perdidos %lu fifo %lu | fila descartadas %lu | log %lu B\n",
+           record->sequence, record->time_ms, sign, temp_int, temp_decimal,
+           reading->code_q8 >> 8, ((reading->code_q8 & 0xFF) * 1000) >> 8, reading->effective_bits,
+           reading->raw_rms_q8 >> 8, ((reading->raw_rms_q8 & 0xFF) * 100) >> 8, reading->min, reading->max,
+           reading->output_rms_q8 >> 8, ((reading->output_rms_q8 & 0xFF) * 1000) >> 8,
+           record->samples, record->blocks_done, record->block_overruns, record->fifo_overruns,
+           record->dropped, templog_used_bytes(&temp_log));
+#endif
+
+    // Acrescenta a leitura ao histórico e atualiza o display (o gráfico rola quando completa um balde)
+    uint32_t completed = trend_add(&temp_trend, temperature_centi);
+    update_display(temperature_centi, completed, have_stats ? &stats : NULL);
+}
+
+/*
+ * FUNÇÃO: publish_reading()
+ * PARÂMETROS:
+ *   - reading: saída do decimador (valor médio com fração e estatísticas de ruído)
+ * DESCRIÇÃO: Converte a leitura em temperatura e a entrega ao núcleo 0 (núcleo 1)
+ * - O instante da leitura vem da contagem de amostras (sem variação dos laços)
+ * - Com a fila cheia a leitura é descartada e contada; a aquisição não espera
+ */
+void publish_reading(const decimator_output_t *reading) {
+    streamstats_summary_t adc_summary = { 0 };
+    streamstats_tumbling(&adc_stats, &adc_summary); // Janela que acabou de fechar com esta leitura
+
+    reading_record_t record = {
+        .sequence = ++reading_sequence,
+        .time_ms = (uint32_t)((uint64_t)adc_samples_processed * 1000 / ADC_SAMPLE_RATE),
+        .temperature_centi = calculate_temperature(reading->code_q8),
+        .reading = *reading,
+        .samples = adc_samples_processed,
+        .blocks_done = adc_blocks_done,
+        .block_overruns = adc_block_overruns + adc_hold_dropped,
+        .fifo_overruns = adc_fifo_overruns,
+        .adc_quantile_q8 = { adc_summary.quantile_q8[0], adc_summary.quantile_q8[1], adc_summary.quantile_q8[2] }
+    };
+
+    reading_ring_push(&reading_ring, &record);
+}
+
+/*
+ * FUNÇÃO: process_adc_block()
+ * PARÂMETROS:
+ *   - block: bloco de ADC_BLOCK_SIZE amostras, na ordem da aquisição
+ * DESCRIÇÃO: Processa um bloco (núcleo 1)
+ * - Blocos perdidos antes dele avançam a contagem de amostras (o instante das leituras continua o do
+ *   relógio; o registro no flash marca o intervalo sem leituras)
+ * - Acumula as estatísticas das amostras brutas (janelas alinhadas às do decimador)
+ * - Passa as amostras pelo decimador e publica cada leitura pronta
+ */
+void process_adc_block(const uint16_t *block) {
+    decimator_output_t outputs[2];
+    uint32_t lost = adc_blocks_lost + adc_hold_dropped;
+
+    adc_samples_processed += (lost - adc_blocks_skipped) * ADC_BLOCK_SIZE;
+    adc_blocks_skipped = lost;
+
+    streamstats_add_block(&adc_stats, block, ADC_BLOCK_SIZE);
+    int count = decimator_process(&temp_decimator, block, ADC_BLOCK_SIZE, outputs, count_of(outputs));
+
+    adc_samples_processed += ADC_BLOCK_SIZE;
+
+    for (int i = 0; i < count; i++) {
+        publish_reading(&outputs[i]);
+    }
+}
+
+/*
+ * FUNÇÃO: process_adc_blocks()
+ * DESCRIÇÃO: Etapa de processamento, fora da interrupção (núcleo 1)
+ * - Consome os blocos completos na ordem em que foram preenchidos
+ */
+void process_adc_blocks() {
+    while (adc_block_full[adc_next_block]) {
+        process_adc_block(adc_buffer[adc_next_block]);
+        adc_block_full[adc_next_block] = false;
+        adc_next_block ^= 1;
+    }
+}
+
+/*
+ * FUNÇÃO: acquisition_hold()
+ * DESCRIÇÃO: Espera do núcleo 1 enquanto o núcleo 0 grava o flash (pedido por flash_hold_enter())
+ * - Executa só da RAM (o flash fica inacessível durante a gravação), com as interrupções ligadas:
+ *   o DMA e a sua interrupção continuam, e nenhuma amostra é perdida
+ * - Copia cada bloco completo para adc_hold_buffer, na ordem; passando de ADC_HOLD_BLOCKS
+ *   (apagamento mais lento que o normal) os blocos são descartados e contados
+ * - A cópia é feita palavra a palavra (memcpy fica no flash)
+ */
+void __not_in_flash_func(acquisition_hold)() {
+    adc_hold_count = 0;
+    flash_hold_active = true;
+
+    while (flash_hold_request) {
+        if (!adc_block_full[adc_next_block]) {
+            continue;
+        }
+        if (adc_hold_count < ADC_HOLD_BLOCKS) {
+            const uint32_t *from = (const uint32_t *)adc_buffer[adc_next_block];
+            volatile uint32_t *to = (volatile uint32_t *)adc_hold_buffer[adc_hold_count++];
+
+            for (int i = 0; i < ADC_BLOCK_SIZE / 2; i++) {
+                to[i] = from[i];
+            }
+        }
+        else {
+            adc_hold_dropped++;
+        }
+        adc_block_full[adc_next_block] = false;
+        adc_next_block ^= 1;
+    }
+
+    __dmb(); // Cópias completas antes de liberar o núcleo 0
+    flash_hold_active = false;
+}
+
+/*
+ * FUNÇÃO: flash_hold_enter()
+ * PARÂMETROS:
+ *   - timeout_ms: espera máxima pelo núcleo 1
+ * RETORNO: PICO_OK, ou PICO_ERROR_TIMEOUT (nada a desfazer; flash_safe_execute() não grava)
+ * DESCRIÇÃO: Entrada da gravação do flash (núcleo 0), no lugar da pausa padrão do SDK
+ * - Pede ao núcleo 1 que passe a executar só da RAM (acquisition_hold()) e espera a confirmação;
+ *   o núcleo 1 vê o pedido no seu laço, em até um bloco (~4 ms)
+ * - Desliga as interrupções deste núcleo (os tratadores da USB e do display ficam no flash)
+ */
+int flash_hold_enter(uint32_t timeout_ms) {
+    uint32_t start = time_us_32();
+
+    if (acquisition_running) {
+        while (flash_hold_active) {
+            // Saída de uma espera anterior ainda em curso
+        }
+        flash_hold_request = true;
+        while (!flash_hold_active) {
+            if (time_us_32() - start >= timeout_ms * 1000) {
+                flash_hold_request = false;
+                return PICO_ERROR_TIMEOUT;
+            }
+        }
+    }
+    flash_hold_interrupts = save_and_disable_interrupts();
+
+    return PICO_OK;
+}
+
+/*
+ * FUNÇÃO: flash_hold_exit()
+ * DESCRIÇÃO: Saída da gravação do flash (núcleo 0): religa as interrupções e libera o núcleo 1,
+ * que processa os blocos guardados antes dos novos
+ */
+int flash_hold_exit(uint32_t timeout_ms) {
+    (void)timeout_ms;
+    restore_interrupts(flash_hold_interrupts);
+    __dmb(); // Gravação (e tabela de conversão remontada) visível antes de liberar o núcleo 1
+    flash_hold_request = false;
+
+    return PICO_OK;
+}
+
+bool flash_hold_core_init_deinit(bool init) {
+    (void)init;
+    return true;
+}
+
+/*
+ * FUNÇÃO: get_flash_safety_helper()
+ * RETORNO: ajudante usado por flash_safe_execute() (templog_flash.c e calibration_flash.c)
+ * DESCRIÇÃO: Substitui o ajudante padrão do SDK (que pausa o outro núcleo com as interrupções desligadas,
+ * perdendo ~11 blocos do ADC a cada setor apagado) pela espera em RAM de acquisition_hold()
+ */
+flash_safety_helper_t *get_flash_safety_helper() {
+    static flash_safety_helper_t helper = {
+        .core_init_deinit = flash_hold_core_init_deinit,
+        .enter_safe_zone_timeout_ms = flash_hold_enter,
+        .exit_safe_zone_timeout_ms = flash_hold_exit
+    };
+
+    return &helper;
+}
+
+/*
+ * FUNÇÃO: acquisition_core_entry()
+ * DESCRIÇÃO: Laço do núcleo 1: aquisição e processamento de sinal
+ * - A interrupção do DMA é habilitada aqui, portanto atendida por este núcleo
+ * - Enquanto o núcleo 0 grava o flash, espera em RAM guardando os blocos (acquisition_hold())
+ *   e depois os processa na ordem, antes dos que chegarem em seguida
+ */
+void acquisition_core_entry() {
+    init_adc_temp_sensor(); // Configura ADC e sensor de temperatura
+    decimator_init(&temp_decimator, DECIMATION_RATIO, DECIMATION_ORDER); // Prepara a decimação
+    streamstats_init(&adc_stats, DECIMATION_RATIO, 1, ADC_STATS_P2_STRIDE); // Estatísticas das amostras brutas
+    init_dma_adc_transfer(); // Configura DMA para transferir leituras
+
+    acquisition_running = true;
+    while (1) {
+        process_adc_blocks();
+
+        if (flash_hold_request) {
+            acquisition_hold();
+            for (uint32_t i = 0; i < adc_hold_count; i++) {
+                process_adc_block(adc_hold_buffer[i]);
+            }
+            continue;
+        }
+
+        // Dorme até a próxima interrupção (fim de bloco do DMA); com as interrupções
+        // mascaradas entre o teste e o WFI, um bloco que acabou de chegar não fica esperando
+        uint32_t status = save_and_disable_interrupts();
+        if (!adc_block_full[adc_next_block]) {
+            __wfi();
+        }
+        restore_interrupts(status);
+    }
 }
 
 /*
  * FUNÇÃO PRINCIPAL
+ * Núcleo 0: apresentação e E/S pela USB; a aquisição roda no núcleo 1
  */
 int main() {
     // Inicializações básicas
     stdio_init_all(); // Inicializa stdio (para printf)
-    init_adc_temp_sensor(); // Configura ADC e sensor de temperatura
-    init_dma_adc_transfer(); // Configura DMA para transferir leituras
+#if TELEMETRY_BINARY
+    telemetry_define(TELEMETRY_TEMPERATURE, "temperatura",
+                     "leitura,tempo_ms,temperatura_c:2,adc_lsb:3,bits,ruido_lsb:3,min,max,saida_lsb:3,"
+                     "blocos,perdidos,fifo,descartadas,log_bytes,adc_p05:3,adc_p50:3,adc_p95:3");
+    telemetry_define(TELEMETRY_STATS, "temperatura_1min", "leitura,min_c:2,max_c:2,media_c:2,desvio_c:2,p05_c:2,p50_c:2,p95_c:2");
+#endif
+    templog_init(&temp_log, TEMPLOG_PERIOD_MS); // Retoma o registro gravado no flash
+    streamstats_init(&temp_stats, TEMP_STATS_PANE, TEMP_STATS_PANES, 1); // Estatísticas do último minuto
+    trend_init(&temp_trend, TREND_BUCKET_MS / TEMPLOG_PERIOD_MS); // Histórico para o gráfico
+    trend_graph_init(&temp_graph, 0, GRAPH_Y, OLED_WIDTH, GRAPH_HEIGHT);
+
+    // Tabela de conversão montada antes de a aquisição começar: calibração do flash ou reta do datasheet
+    calibrated = calibration_load(&calibration);
+    if (!calibrated) {
+        memset(&calibration, 0, sizeof(calibration));
+    }
+    calibration_apply(calibrated ? &calibration : NULL);
+    print_calibration();
     init_oled(); // Inicializa o display OLED
+    report_oled_fps(); // Mede a taxa de quadros do display
     
-    // Mostra tela inicial (0°C e amostra 0)
-    update_display(0.0f, 0);
+    // Mostra tela inicial (0°C, sem gráfico)
+    update_display(0, 0, NULL);
+
+    multicore_launch_core1(acquisition_core_entry); // Inicia a aquisição no núcleo 1
     
-    // Loop principal
+    // Loop principal: apresenta as leituras que chegam pela fila, grava o registro aos poucos
+    // (no máximo uma operação de flash por volta) e atende os comandos da USB
     while (1) {
-        sleep_ms(500); // Atualiza a cada 500ms
-        
-        // Reinicia a transferência DMA para novas leituras
-        dma_channel_configure(
-            dma_chan,
-            &dma_config,
-            adc_buffer,
-            &adc_hw->fifo,
-            ADC_BUFFER_SIZE,
-            true // Inicia imediatamente
-        );
-        
-        // Espera a transferência DMA completar
-        dma_channel_wait_for_finish_blocking(dma_chan);
-        
-        // Calcula média das amostras no buffer
-        uint32_t sum = 0;
-        for (int i = 0; i < ADC_BUFFER_SIZE; i++) {
-            sum += adc_buffer[i];
+        reading_record_t record;
+
+        while (reading_ring_pop(&reading_ring, &record)) {
+            handle_reading(&record);
+        }
+        bool log_busy = templog_service(&temp_log);
+
+        int command = getchar_timeout_us(0);
+        if (command != PICO_ERROR_TIMEOUT) {
+            handle_command(command);
+        }
+
+        // Sem gravação pendente, espera um evento (nova leitura sinalizada pelo núcleo 1 ou interrupção da USB);
+        // uma leitura publicada depois do teste deixa o evento pendente e o WFE retorna na hora
+        if (!log_busy && reading_ring_empty(&reading_ring)) {
+            __wfe();
         }
-        
-        // Calcula nova temperatura (média das amostras)
-        temperature_c = calculate_temperature(sum / ADC_BUFFER_SIZE);
-        sample_count++; // Incrementa contador
-        
-        // Log no terminal (para debug)
-        printf("Leitura %lu: %d (%.1f°C)\n", sample_count, sum / ADC_BUFFER_SIZE, temperature_c);
-        
-        // Atualiza o display com os novos valores
-        update_display(temperature_c, sample_count);
     }
     
     return 0;
-}
\ No newline at end of file
+}
@@ -0,0 +1,157 @@
+// Confere e mede o desenho de glifos ampliados (ssd1306_draw_char_scaled, tabelas font_scale2/font_scale3
+// de font.h) contra o caminho anterior, pixel a pixel com ssd1306_set_pixel (um bloco scale x scale por
+// bit aceso da fonte), no computador.
+// Conferência: todos os glifos da fonte, em escala 1 a 3, com y de 0 a 7 dentro da página e em posições
+// cortadas nas quatro bordas, dão o mesmo buffer nos dois caminhos; ssd1306_draw_char (cópia da célula)
+// dá o mesmo que a escala 1 num buffer limpo. Falha (código de saída 1) se algum buffer diferir.
+// Medida: tempo por glifo em cada escala, nos dois caminhos, em ns. O computador prevê bem os desvios
+// do caminho por pixel; no RP2040 (sem cache de dados e com o assert em cada pixel) a diferença é maior.
+//
+// Compilação: gcc -std=c11 -O2 -o bench_glyph bench_glyph.c ssd1306_gfx.c
+// Uso:        bench_glyph [-i repeticoes]
+
+#define _POSIX_C_SOURCE 199309L
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include "ssd1306_gfx.h"
+#include "font.h"
+
+static double now_seconds(void) {
+    struct timespec time;
+
+    clock_gettime(CLOCK_MONOTONIC, &time);
+    return time.tv_sec + time.tv_nsec * 1e-9;
+}
+
+// Caminho anterior: um ssd1306_set_pixel (com assert, divisão e resto) por pixel do glifo ampliado;
+// pixels fora da tela são pulados (a versão antiga parava no assert)
+static void reference_draw_char(uint8_t *ssd, int x, int y, uint8_t character, int scale) {
+    int idx = font_index[character];
+
+    for (int col = 0; col < 8; col++) {
+        uint8_t bits = font[idx * 8 + col];
+
+        for (int bit = 0; bit < 8; bit++) {
+            if (!(bits & (1 << bit))) {
+                continue;
+            }
+            for (int dx = 0; dx < scale; dx++) {
+                for (int dy = 0; dy < scale; dy++) {
+                    int px = x + col * scale + dx, py = y + bit * scale + dy;
+
+                    if (px >= 0 && px < ssd1306_width && py >= 0 && py < ssd1306_height) {
+                        ssd1306_set_pixel(ssd, px, py, true);
+                    }
+                }
+            }
+        }
+    }
+}
+
+// Caracteres da fonte: ASCII imprimível e o símbolo de grau
+static int glyph_characters(uint8_t *characters) {
+    int count = 0;
+
+    for (int c = 0x20; c <= 0x7E; c++) {
+        characters[count++] = (uint8_t)c;
+    }
+    characters[count++] = 0xF8;
+
+    return count;
+}
+
+static bool compare_at(uint8_t character, int x, int y, int scale) {
+    static uint8_t fast[ssd1306_buffer_length], slow[ssd1306_buffer_length];
+
+    memset(fast, 0, sizeof(fast));
+    memset(slow, 0, sizeof(slow));
+    ssd1306_draw_char_scaled(fast, (int16_t)x, (int16_t)y, character, scale);
+    reference_draw_char(slow, x, y, character, scale);
+    if (memcmp(fast, slow, sizeof(fast))) {
+        printf("  '%c' (0x%02X) escala %d em (%d, %d): buffers diferentes\n", character, character, scale, x, y);
+        return false;
+    }
+    if (scale == 1) {
+        memset(fast, 0, sizeof(fast));
+        ssd1306_draw_char(fast, (int16_t)x, (int16_t)y, character);
+        if (memcmp(fast, slow, sizeof(fast))) {
+            printf("  '%c' (0x%02X) ssd1306_draw_char em (%d, %d): buffer diferente\n", character, character, x, y);
+            return false;
+        }
+    }
+
+    return true;
+}
+
+int main(int argc, char **argv) {
+    uint32_t iterations = 200000;
+
+    if (argc == 3 && !strcmp(argv[1], "-i")) {
+        iterations = (uint32_t)strtoul(argv[2], NULL, 10);
+    }
+    else if (argc != 1) {
+        fprintf(stderr, "uso: %s [-i repeticoes]\n", argv[0]);
+        return 2;
+    }
+
+    uint8_t characters[128];
+    int count = glyph_characters(characters);
+    int cases = 0, failures = 0;
+
+    // Posições: y em todas as fases da página e cortes em cada borda
+    for (int c = 0; c < count; c++) {
+        for (int scale = 1; scale <= 3; scale++) {
+            const int size = 8 * scale;
+            const int edges[][2] = {
+                { -3, 20 }, { ssd1306_width - size + 5, 20 }, { 40, -5 }, { 40, ssd1306_height - size + 6 },
+                { -size + 1, -size + 1 }, { ssd1306_width - 1, ssd1306_height - 1 }
+            };
+
+            for (int y = 0; y < 8; y++) {
+                cases++;
+                failures += !compare_at(characters[c], 17, 24 + y, scale);
+            }
+            for (size_t e = 0; e < sizeof(edges) / sizeof(edges[0]); e++) {
+                cases++;
+                failures += !compare_at(characters[c], edges[e][0], edges[e][1], scale);
+            }
+        }
+    }
+    printf("conferencia: %d glifos, %d casos, %d diferentes\n", count, cases, failures);
+
+    // Medida: glifos em posições que variam (x e fase de y), sempre dentro da tela
+    static uint8_t ssd[ssd1306_buffer_length];
+    volatile uint8_t sink = 0;
+
+    printf("ns por glifo:      por pixel   tabelas\n");
+    for (int scale = 1; scale <= 3; scale++) {
+        double start = now_seconds();
+        for (uint32_t i = 0; i < iterations; i++) {
+            reference_draw_char(ssd, (int)(i % 64), (int)(i % 8) + 8, characters[i % count], scale);
+        }
+        double slow_ns = (now_seconds() - start) * 1e9 / iterations;
+        sink += ssd[200];
+
+        start = now_seconds();
+        for (uint32_t i = 0; i < iterations; i++) {
+            ssd1306_draw_char_scaled(ssd, (int16_t)(i % 64), (int16_t)(i % 8 + 8), characters[i % count], scale);
+        }
+        double fast_ns = (now_seconds() - start) * 1e9 / iterations;
+        sink += ssd[200];
+
+        printf("  escala %d        %8.1f  %8.1f  (%.1fx)\n", scale, slow_ns, fast_ns, slow_ns / fast_ns);
+    }
+
+    double start = now_seconds();
+    for (uint32_t i = 0; i < iterations; i++) {
+        ssd1306_draw_char(ssd, (int16_t)(i % 64), (int16_t)(i % 8 + 8), characters[i % count]);
+    }
+    printf("  ssd1306_draw_char (copia da celula)   %8.1f\n", (now_seconds() - start) * 1e9 / iterations);
+    sink += ssd[200];
+
+    printf("%s (%d)\n", failures ? "FALHOU" : "OK", sink & 1);
+
+    return failures ? 1 : 0;
+}
@@ -0,0 +1,139 @@
+// Mede o código do display no computador: tempo de CPU das operações de desenho e da busca das janelas
+// alteradas (ssd1306_gfx.c), e bytes por quadro com o enquadramento real (ssd1306_host.c), convertidos
+// em tempo de barramento nos três transportes de ssd1306_i2c.h.
+// O quadro típico é a tela do termômetro: temperatura em escala 2 mudando a cada leitura, linha de
+// estatísticas e gráfico do histórico ganhando uma coluna.
+// Os tempos de barramento são estimativas (9 bits por byte no I2C, 8 no SPI, sem pausas entre transações);
+// na placa, report_oled_fps() mede o transporte em uso.
+//
+// Compilação: gcc -std=c11 -O2 -o bench_oled bench_oled.c ssd1306_gfx.c ssd1306_host.c
+// Uso:        bench_oled [-i repeticoes]
+
+#define _POSIX_C_SOURCE 199309L
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include "ssd1306_host.h"
+
+#define bench_graph_y 40
+#define bench_graph_height 24
+#define bench_readings 128
+
+static double now_seconds(void) {
+    struct timespec time;
+
+    clock_gettime(CLOCK_MONOTONIC, &time);
+    return time.tv_sec + time.tv_nsec * 1e-9;
+}
+
+// Tela do termômetro para a leitura index: texto ampliado, estatísticas e histórico
+static void draw_frame(uint8_t *ssd, const int16_t *history, int index) {
+    char text[24];
+    int centi = history[index];
+
+    ssd1306_fill_rect(ssd, 0, 0, ssd1306_width, bench_graph_y, false);
+    snprintf(text, sizeof(text), "%d,%dC", centi / 100, centi / 10 % 10);
+    ssd1306_draw_string_scaled(ssd, (ssd1306_width - ssd1306_measure_string(text, 2)) / 2, 18, text, 2);
+    snprintf(text, sizeof(text), "%d %d %d", centi / 10 - 3, centi / 10, centi / 10 + 4);
+    ssd1306_draw_string(ssd, 0, 32, text);
+    ssd1306_draw_sparkline(ssd, 0, bench_graph_y, ssd1306_width, bench_graph_height, history, index + 1, 2100, 2500);
+}
+
+// Tempo médio de uma operação, em ns
+#define bench_time(result, iterations, statement) do { \
+        double start_ = now_seconds(); \
+        for (uint32_t i_ = 0; i_ < (iterations); i_++) { statement; } \
+        (result) = (now_seconds() - start_) * 1e9 / (iterations); \
+    } while (0)
+
+int main(int argc, char **argv) {
+    uint32_t iterations = 20000;
+
+    if (argc == 3 && !strcmp(argv[1], "-i")) {
+        iterations = (uint32_t)strtoul(argv[2], NULL, 10);
+    }
+    else if (argc != 1) {
+        fprintf(stderr, "uso: %s [-i repeticoes]\n", argv[0]);
+        return 2;
+    }
+
+    int16_t history[bench_readings];
+    for (int i = 0; i < bench_readings; i++) {
+        history[i] = (int16_t)(2250 + (i * 7 % 40) - (i % 5) * 3);
+    }
+
+    static ssd1306_t oled;
+    static uint8_t shadow[ssd1306_buffer_length];
+    struct render_area windows[ssd1306_n_pages];
+    volatile int sink = 0;
+    double ns;
+
+    ssd1306_init(&oled);
+    uint8_t *ssd = oled.ram_buffer;
+
+    printf("CPU por operacao (ns):\n");
+    bench_time(ns, iterations, ssd1306_clear(&oled));
+    printf("  limpar o buffer                 %8.1f\n", ns);
+    bench_time(ns, iterations, ssd1306_draw_string(ssd, i_ % 8, 0, "TEMP LOG 12"));
+    printf("  texto escala 1 (11 glifos)      %8.1f\n", ns);
+    bench_time(ns, iterations, ssd1306_draw_string_scaled(ssd, 0, 18 + i_ % 8, "23,4C", 2));
+    printf("  texto escala 2 (5 glifos)       %8.1f\n", ns);
+    bench_time(ns, iterations, ssd1306_draw_line(ssd, 0, 0, 127, 63 - i_ % 8, true));
+    printf("  linha diagonal (128 px)         %8.1f\n", ns);
+    bench_time(ns, iterations, ssd1306_draw_sparkline(ssd, 0, 40, 128, 24, history, bench_readings, 2100, 2500));
+    printf("  sparkline 128x24                %8.1f\n", ns);
+    bench_time(ns, iterations, draw_frame(ssd, history, i_ % bench_readings));
+    printf("  quadro completo do termometro   %8.1f\n", ns);
+
+    // Busca das janelas: sem mudança (pior caso da comparação) e com a leitura seguinte
+    memcpy(shadow, ssd, ssd1306_buffer_length);
+    bench_time(ns, iterations, sink += ssd1306_find_changed_windows(ssd, shadow, ssd1306_host_window_overhead(&oled), windows));
+    printf("  janelas, quadro igual           %8.1f\n", ns);
+    draw_frame(ssd, history, 10);
+    memcpy(shadow, ssd, ssd1306_buffer_length);
+    draw_frame(ssd, history, 11);
+    bench_time(ns, iterations, sink += ssd1306_find_changed_windows(ssd, shadow, ssd1306_host_window_overhead(&oled), windows));
+    printf("  janelas, leitura seguinte       %8.1f\n", ns);
+
+    // Bytes por quadro com o enquadramento de cada transporte, quadro completo e só as janelas alteradas
+    static const struct {
+        const char *name;
+        ssd1306_host_transport_t transport;
+        double clock_hz;
+        int bits_per_byte;
+    } transports[] = {
+        { "I2C 400 kHz", ssd1306_host_i2c, 400e3, 9 },
+        { "I2C PIO 1 MHz", ssd1306_host_i2c, 1e6, 9 },
+        { "SPI PIO 10 MHz", ssd1306_host_spi, 10e6, 8 },
+    };
+
+    printf("Barramento por quadro (estimativa, %d leituras):\n", bench_readings - 1);
+    for (size_t t = 0; t < sizeof(transports) / sizeof(transports[0]); t++) {
+        uint32_t full_bytes, changed_bytes = 0;
+
+        ssd1306_init(&oled);
+        ssd1306_host_set_transport(&oled, transports[t].transport);
+        draw_frame(oled.ram_buffer, history, 0);
+        ssd1306_reset_bytes_sent(&oled);
+        ssd1306_send_data(&oled);
+        full_bytes = ssd1306_get_bytes_sent(&oled);
+
+        for (int i = 1; i < bench_readings; i++) {
+            draw_frame(oled.ram_buffer, history, i);
+            ssd1306_reset_bytes_sent(&oled);
+            render_changes_on_display(&oled);
+            changed_bytes += ssd1306_get_bytes_sent(&oled);
+        }
+
+        double changed_mean = (double)changed_bytes / (bench_readings - 1);
+        double byte_us = 1e6 * transports[t].bits_per_byte / transports[t].clock_hz;
+
+        printf("  %-15s completo %5u bytes %7.0f us (%5.0f qps) | alteradas %6.1f bytes %7.0f us (%5.0f qps)\n",
+               transports[t].name, full_bytes, full_bytes * byte_us, 1e6 / (full_bytes * byte_us),
+               changed_mean, changed_mean * byte_us, 1e6 / (changed_mean * byte_us));
+    }
+    printf("(%d)\n", sink & 1);
+
+    return 0;
+}
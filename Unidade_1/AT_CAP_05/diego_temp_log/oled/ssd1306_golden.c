@@ -0,0 +1,154 @@
+// Teste de imagens de referência do código de desenho (ssd1306_gfx.c), no computador.
+// Desenha cenas fixas (textos em escala 1 a 3 fora do alinhamento das páginas, primitivas com recorte nas
+// bordas, modos de cópia de bitmap, gráficos de barras e sparkline), envia cada uma ao painel simulado de
+// ssd1306_host.c só com as janelas alteradas e compara o painel, pixel a pixel, com os PBM de golden/.
+// Falha (código de saída 1) se algum pixel mudar ou se o painel não ficar igual ao framebuffer; a imagem
+// obtida é gravada ao lado da referência (<cena>_atual.pbm) para comparação visual.
+// Com -w as referências são (re)gravadas: só depois de conferir as imagens de uma mudança intencional.
+//
+// Compilação: gcc -std=c11 -O2 -o ssd1306_golden ssd1306_golden.c ssd1306_gfx.c ssd1306_host.c
+// Uso:        ssd1306_golden [-w] [diretorio_das_referencias]
+
+#include <stdio.h>
+#include <string.h>
+#include "ssd1306_host.h"
+
+typedef struct {
+    const char *name;
+    void (*draw)(uint8_t *ssd);
+} golden_scene_t;
+
+// Textos: escala 1 em linhas alinhadas e desalinhadas, escala 2 com a vírgula rebaixada e escala 3 cortada na borda
+static void draw_text(uint8_t *ssd) {
+    ssd1306_draw_string(ssd, 0, 0, "TEMP LOG 0123");
+    ssd1306_draw_string(ssd, 3, 11, "abc XYZ -+.,:");
+    ssd1306_draw_string_scale2(ssd, 4, 22, "23,4");
+    ssd1306_draw_char_scale2(ssd, 70, 22, 'C');
+    ssd1306_draw_string_scaled(ssd, 96, 42, "-8", 3);
+    ssd1306_draw_string_scaled(ssd, -5, 45, "Q", 2);
+}
+
+// Primitivas: linhas em todos os octantes, retângulos e linhas retas, cortados nas bordas
+static void draw_shapes(uint8_t *ssd) {
+    for (int i = 0; i < 8; i++) {
+        int dx = i < 4 ? 30 : 10 * (i - 4) - 15, dy = i < 4 ? 8 * i - 12 : 30;
+
+        ssd1306_draw_line(ssd, 32, 32, 32 + dx, 32 + dy, true);
+    }
+    ssd1306_draw_rect(ssd, 70, 3, 40, 21, true);
+    ssd1306_fill_rect(ssd, 74, 7, 12, 13, true);
+    ssd1306_fill_rect(ssd, 120, 56, 20, 20, true);
+    ssd1306_draw_hline(ssd, 64, 127, 30, true);
+    ssd1306_draw_vline(ssd, 66, 34, 63, true);
+    ssd1306_draw_rect(ssd, 90, 40, 30, 15, true);
+}
+
+// Bitmaps: cópia, OU, limpeza e XOR em deslocamentos de 0 a 7 pixels, inclusive fora da tela
+static void draw_blits(uint8_t *ssd) {
+    static const uint8_t checker[2 * 12] = {
+        0xAA, 0x55, 0xAA, 0x55, 0xAA, 0x55, 0xAA, 0x55, 0xAA, 0x55, 0xAA, 0x55,
+        0x0A, 0x05, 0x0A, 0x05, 0x0A, 0x05, 0x0A, 0x05, 0x0A, 0x05, 0x0A, 0x05
+    };
+
+    ssd1306_fill_rect(ssd, 0, 32, 128, 32, true);
+    for (int shift = 0; shift < 8; shift++) {
+        ssd1306_blit_bitmap(ssd, shift * 15, shift, checker, 12, 12, ssd1306_blit_copy);
+        ssd1306_blit_bitmap(ssd, shift * 15, 34 + shift, checker, 12, 12, ssd1306_blit_clear);
+    }
+    ssd1306_blit_bitmap(ssd, 120, 20, checker, 12, 12, ssd1306_blit_or);
+    ssd1306_blit_bitmap(ssd, -6, 56, checker, 12, 12, ssd1306_blit_xor);
+    ssd1306_blit_bitmap(ssd, 60, -5, checker, 12, 12, ssd1306_blit_xor);
+}
+
+// Gráficos: barras e sparkline de uma série fixa, na área do histórico do termômetro
+static void draw_graphs(uint8_t *ssd) {
+    int16_t values[100];
+
+    for (int i = 0; i < 100; i++) {
+        values[i] = (int16_t)(2200 + (i * 37 % 23) * 10 - (i % 17) * 8 + (i > 60 ? 150 : 0));
+    }
+    ssd1306_draw_string(ssd, 0, 0, "BARRAS");
+    ssd1306_draw_bar_graph(ssd, 0, 10, 128, 20, values, 12, 2100, 2500);
+    ssd1306_draw_sparkline(ssd, 0, 40, 128, 24, values, 100, 2100, 2500);
+    ssd1306_draw_sparkline(ssd, 0, 32, 40, 8, values, 100, 2300, 2300);
+}
+
+static const golden_scene_t golden_scenes[] = {
+    { "texto", draw_text },
+    { "primitivas", draw_shapes },
+    { "bitmaps", draw_blits },
+    { "graficos", draw_graphs },
+};
+
+static int count_pixel_differences(const uint8_t *a, const uint8_t *b) {
+    int count = 0;
+
+    for (int i = 0; i < ssd1306_buffer_length; i++) {
+        count += __builtin_popcount(a[i] ^ b[i]);
+    }
+
+    return count;
+}
+
+int main(int argc, char **argv) {
+    const char *directory = "golden";
+    bool write = false;
+    bool ok = true;
+
+    for (int i = 1; i < argc; i++) {
+        if (!strcmp(argv[i], "-w")) {
+            write = true;
+        }
+        else {
+            directory = argv[i];
+        }
+    }
+
+    static ssd1306_t oled;
+    ssd1306_init(&oled);
+
+    for (size_t s = 0; s < sizeof(golden_scenes) / sizeof(golden_scenes[0]); s++) {
+        const golden_scene_t *scene = &golden_scenes[s];
+        uint8_t reference[ssd1306_buffer_length];
+        char path[256];
+
+        // Cada cena parte da anterior no painel: só as janelas alteradas são enviadas
+        ssd1306_clear(&oled);
+        scene->draw(oled.ram_buffer);
+        ssd1306_reset_bytes_sent(&oled);
+        render_changes_on_display(&oled);
+
+        const uint8_t *panel = ssd1306_host_panel(&oled);
+        bool panel_ok = memcmp(panel, oled.ram_buffer, ssd1306_buffer_length) == 0;
+
+        snprintf(path, sizeof(path), "%s/%s.pbm", directory, scene->name);
+        if (write) {
+            if (!ssd1306_save_pbm(panel, path)) {
+                fprintf(stderr, "erro ao gravar %s\n", path);
+                return 2;
+            }
+            printf("%-10s gravada em %s\n", scene->name, path);
+            continue;
+        }
+        if (!ssd1306_load_pbm(reference, path)) {
+            fprintf(stderr, "referencia %s ausente ou invalida (gerar com -w)\n", path);
+            return 2;
+        }
+
+        int differences = count_pixel_differences(panel, reference);
+
+        printf("%-10s %4d pixels diferentes, painel %s, %4u bytes enviados\n",
+               scene->name, differences, panel_ok ? "igual ao framebuffer" : "DIFERENTE DO FRAMEBUFFER",
+               ssd1306_get_bytes_sent(&oled));
+        if (differences || !panel_ok) {
+            snprintf(path, sizeof(path), "%s/%s_atual.pbm", directory, scene->name);
+            ssd1306_save_pbm(panel, path);
+            ok = false;
+        }
+    }
+    if (!write) {
+        printf("%s\n", ok ? "OK" : "FALHOU");
+    }
+
+    return ok ? 0 : 1;
+}
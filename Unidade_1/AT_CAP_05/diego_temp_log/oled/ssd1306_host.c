@@ -0,0 +1,193 @@
+#include <stdio.h>
+#include <string.h>
+#include "ssd1306_host.h"
+
+uint32_t ssd1306_get_bytes_sent(ssd1306_t *ssd) {
+    return ssd->bytes_sent;
+}
+
+void ssd1306_reset_bytes_sent(ssd1306_t *ssd) {
+    ssd->bytes_sent = 0;
+}
+
+const uint8_t *ssd1306_host_panel(ssd1306_t *ssd) {
+    return ssd->panel;
+}
+
+// Enquadramento de uma transação de length bytes no transporte simulado
+static void ssd1306_host_transaction(ssd1306_t *ssd, int length) {
+    ssd->bytes_sent += length + (ssd->transport == ssd1306_host_i2c ? ssd1306_host_i2c_framing : 0);
+    ssd->transactions++;
+}
+
+// Custo de abrir uma janela: transação dos comandos de endereço e enquadramento da transação de dados
+int ssd1306_host_window_overhead(const ssd1306_t *ssd) {
+    int framing = ssd->transport == ssd1306_host_i2c ? ssd1306_host_i2c_framing : 0;
+
+    return ssd1306_host_window_commands + 2 * framing;
+}
+
+void ssd1306_host_set_transport(ssd1306_t *ssd, ssd1306_host_transport_t transport) {
+    ssd->transport = transport;
+}
+
+// Inicializa a instância, limpa o painel simulado (a RAM do display real tem conteúdo indefinido após ligar)
+// e conta a configuração enviada
+void ssd1306_init(ssd1306_t *ssd) {
+    memset(ssd, 0, sizeof(*ssd));
+    ssd->width = ssd1306_width;
+    ssd->height = ssd1306_height;
+    ssd->pages = ssd1306_n_pages;
+    ssd->ram_buffer = ssd->framebuffer;
+    ssd->bufsize = ssd1306_buffer_length;
+    ssd1306_config(ssd);
+}
+
+// Comandos em transações de até ssd1306_host_max_command_list, como em ssd1306_i2c.c
+void ssd1306_send_command_list(ssd1306_t *ssd, const uint8_t *commands, int number) {
+    (void)commands;
+
+    while (number > 0) {
+        int chunk = number < ssd1306_host_max_command_list ? number : ssd1306_host_max_command_list;
+
+        ssd1306_host_transaction(ssd, chunk);
+        number -= chunk;
+    }
+}
+
+void ssd1306_command(ssd1306_t *ssd, uint8_t command) {
+    ssd1306_send_command_list(ssd, &command, 1);
+}
+
+// Mesma lista de inicialização de ssd1306_i2c.c (display 128x64, alimentação interna)
+void ssd1306_config(ssd1306_t *ssd) {
+    uint8_t commands[] = {
+        0xAE, 0x20, 0x00, 0x40, 0xA1, 0xA8, ssd1306_height - 1, 0xC8, 0xD3, 0x00, 0xDA, 0x12,
+        0xD5, 0x80, 0xD9, 0xF1, 0xDB, 0x30, 0x81, 0xFF, 0xA4, 0xA6, 0x8D, 0x14, 0x2E, 0xAF
+    };
+
+    ssd1306_send_command_list(ssd, commands, sizeof(commands));
+    ssd->panel_valid = false;
+}
+
+void ssd1306_scroll(ssd1306_t *ssd, bool set) {
+    uint8_t commands[] = { 0x26, 0x00, 0x00, 0x00, ssd1306_n_pages - 1, 0x00, 0xFF, 0x2E | (set ? 0x01 : 0) };
+
+    ssd1306_send_command_list(ssd, commands, sizeof(commands));
+    ssd->panel_valid = false;
+}
+
+void ssd1306_clear(ssd1306_t *ssd) {
+    memset(ssd->ram_buffer, 0, ssd->bufsize);
+}
+
+// Copia uma janela do framebuffer para o painel: comandos de endereço e dados, em duas transações
+static void ssd1306_host_window(ssd1306_t *ssd, struct render_area *area) {
+    int columns = area->end_column - area->start_column + 1;
+
+    for (int page = area->start_page; page <= area->end_page; page++) {
+        memcpy(ssd->panel + page * ssd1306_width + area->start_column,
+               ssd->ram_buffer + page * ssd1306_width + area->start_column, columns);
+    }
+    ssd1306_host_transaction(ssd, ssd1306_host_window_commands);
+    ssd1306_host_transaction(ssd, area->buffer_length);
+}
+
+void render_on_display(ssd1306_t *ssd, struct render_area *area) {
+    ssd1306_host_window(ssd, area);
+
+    if (area->buffer_length == ssd1306_buffer_length) {
+        ssd->panel_valid = true;
+    }
+}
+
+void ssd1306_send_data(ssd1306_t *ssd) {
+    struct render_area area = {
+        .start_column = 0,
+        .end_column = ssd1306_width - 1,
+        .start_page = 0,
+        .end_page = ssd1306_n_pages - 1
+    };
+
+    calculate_render_area_buffer_length(&area);
+    render_on_display(ssd, &area);
+}
+
+void render_changes_on_display(ssd1306_t *ssd) {
+    struct render_area windows[ssd1306_n_pages];
+
+    if (!ssd->panel_valid) {
+        ssd1306_send_data(ssd);
+        return;
+    }
+
+    int count = ssd1306_find_changed_windows(ssd->ram_buffer, ssd->panel, ssd1306_host_window_overhead(ssd), windows);
+
+    for (int i = 0; i < count; i++) {
+        ssd1306_host_window(ssd, &windows[i]);
+    }
+}
+
+// Grava um buffer da tela inteira como PBM binário (P4): pixel aceso = 1 (preto na imagem)
+bool ssd1306_write_pbm(const uint8_t *ssd, FILE *file) {
+    uint8_t row[ssd1306_width / 8];
+
+    fprintf(file, "P4\n%d %d\n", ssd1306_width, ssd1306_height);
+
+    for (int y = 0; y < ssd1306_height; y++) {
+        const uint8_t *page = ssd + (y / 8) * ssd1306_width;
+        uint8_t bit = 1 << (y % 8);
+
+        memset(row, 0, sizeof(row));
+        for (int x = 0; x < ssd1306_width; x++) {
+            if (page[x] & bit) {
+                row[x / 8] |= 0x80 >> (x % 8);
+            }
+        }
+        if (fwrite(row, 1, sizeof(row), file) != sizeof(row)) {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+bool ssd1306_save_pbm(const uint8_t *ssd, const char *path) {
+    FILE *file = fopen(path, "wb");
+
+    if (!file) {
+        return false;
+    }
+
+    bool ok = ssd1306_write_pbm(ssd, file);
+
+    return fclose(file) == 0 && ok;
+}
+
+// Lê um PBM binário de 128x64 (por exemplo uma imagem de referência) para um buffer da tela inteira
+bool ssd1306_load_pbm(uint8_t *ssd, const char *path) {
+    FILE *file = fopen(path, "rb");
+    uint8_t row[ssd1306_width / 8];
+    int width, height;
+
+    if (!file) {
+        return false;
+    }
+
+    bool ok = fscanf(file, "P4 %d %d", &width, &height) == 2 && fgetc(file) != EOF
+           && width == ssd1306_width && height == ssd1306_height;
+
+    memset(ssd, 0, ssd1306_buffer_length);
+    for (int y = 0; ok && y < ssd1306_height; y++) {
+        ok = fread(row, 1, sizeof(row), file) == sizeof(row);
+
+        for (int x = 0; ok && x < ssd1306_width; x++) {
+            if (row[x / 8] & (0x80 >> (x % 8))) {
+                ssd[(y / 8) * ssd1306_width + x] |= 1 << (y % 8);
+            }
+        }
+    }
+
+    fclose(file);
+    return ok;
+}
@@ -1,17 +1,19 @@
 #include <stdlib.h>
 #include "pico/stdlib.h"
 #include "hardware/i2c.h"
+#include "hardware/pio.h"
+#include "ssd1306_gfx.h"
 
 #ifndef ssd1306_inc_h
 #define ssd1306_inc_h
 
-#define ssd1306_height 64 // Define a altura do display (32 pixels)
-#define ssd1306_width 128 // Define a largura do display (128 pixels)
-
 #define ssd1306_i2c_address _u(0x3C) // Define o endereço do i2c do display
 
 #define ssd1306_i2c_clock 400 // Define o tempo do clock (pode ser aumentado)
 
+#define ssd1306_pio_i2c_clock 1000 // Clock do I2C por PIO, em fast-mode plus (kHz)
+#define ssd1306_pio_spi_clock 10000 // Clock do SPI por PIO (kHz; máximo do SSD1306)
+
 // Comandos de configuração (endereços)
 #define ssd1306_set_memory_mode _u(0x20)
 #define ssd1306_set_column_address _u(0x21)
@@ -40,29 +42,88 @@
 #define ssd1306_set_common_pin_configuration _u(0xDA)
 #define ssd1306_set_vcomh_deselect_level _u(0xDB)
 
-#define ssd1306_page_height _u(8)
-#define ssd1306_n_pages (ssd1306_height / ssd1306_page_height)
-#define ssd1306_buffer_length (ssd1306_n_pages * ssd1306_width)
+// Custo aproximado, em bytes no barramento, de abrir uma nova janela de escrita
+// (endereço + controle + 6 comandos numa transação, endereço e byte de controle dos dados)
+#define ssd1306_window_overhead _u(10)
+
+// Custo de uma nova janela no SPI: só os 6 comandos de endereço
+#define ssd1306_spi_window_overhead _u(6)
+
+// Formato das palavras da fila para os programas PIO (ver ssd1306.pio)
+#define ssd1306_pio_i2c_start (1u << 15)
+#define ssd1306_pio_i2c_stop (1u << 14)
+#define ssd1306_pio_i2c_shift 6
+#define ssd1306_pio_spi_data (1u << 15)
+#define ssd1306_pio_spi_shift 7
+
+// Maior lista de comandos enviada numa única transação bloqueante
+#define ssd1306_max_command_list _u(32)
+
+// Capacidade de uma fila de transmissão: a tela inteira e, no pior caso, uma janela por página
+// (transação de 6 comandos + bytes de controle e, no I2C por PIO, os bytes de endereço)
+#define ssd1306_queue_length (ssd1306_buffer_length + ssd1306_n_pages * 10)
 
 #define ssd1306_write_mode _u(0xFE)
 #define ssd1306_read_mode _u(0xFF)
 
-struct render_area {
-    uint8_t start_column;
-    uint8_t end_column;
-    uint8_t start_page;
-    uint8_t end_page;
-
-    int buffer_length;
-};
+// Meio físico usado para falar com o display
+typedef enum {
+    ssd1306_transport_i2c,     // Bloco I2C do RP2040 (ssd1306_i2c_clock)
+    ssd1306_transport_pio_i2c, // I2C por PIO, em fast-mode plus (ssd1306_pio_i2c_clock)
+    ssd1306_transport_pio_spi  // SPI de 4 fios por PIO (ssd1306_pio_spi_clock)
+} ssd1306_transport_t;
 
+// Fila de transmissão: transações (byte de controle + bytes, STOP na última palavra) encadeadas,
+// já no formato de palavra do transporte (registrador IC_DATA_CMD do I2C ou programa PIO),
+// enviadas por um único DMA
 typedef struct {
+    uint16_t words[ssd1306_queue_length];
+    int length;
+    int transactions;
+
+    // Codificação das palavras: transporte, endereço e deslocamento/bits da transação aberta
+    ssd1306_transport_t transport;
+    uint8_t address;
+    uint8_t shift;
+    uint16_t flags;
+} ssd1306_queue_t;
+
+struct ssd1306;
+
+// Função chamada quando o DMA termina de entregar uma fila ao FIFO do I2C
+typedef void (*ssd1306_frame_done_callback_t)(struct ssd1306 *ssd, void *user_data);
+
+// Instância de um display: cada uma tem sua porta I2C, endereço, framebuffer, cópia da RAM do display,
+// filas e canal DMA, de modo que vários displays (em barramentos separados) funcionam ao mesmo tempo
+typedef struct ssd1306 {
   uint8_t width, height, pages, address;
   i2c_inst_t * i2c_port;
   bool external_vcc;
   uint8_t *ram_buffer;
   size_t bufsize;
-  uint8_t port_buffer[2];
+
+  // Transporte e, nos transportes por PIO, o bloco, a state machine e o endereço do programa
+  ssd1306_transport_t transport;
+  PIO pio;
+  uint sm;
+  uint pio_offset;
+
+  uint8_t framebuffer[ssd1306_buffer_length];
+
+  // Cópia do que está na RAM do display, usada para enviar apenas as regiões alteradas
+  uint8_t shadow[ssd1306_buffer_length];
+  bool shadow_valid;
+
+  // Duas filas, para que a próxima possa ser montada enquanto a anterior ainda está sendo enviada
+  ssd1306_queue_t queues[2];
+  int back_queue;
+
+  int dma_chan;
+  ssd1306_frame_done_callback_t frame_done_cb;
+  void *frame_done_user_data;
+
+  // Bytes colocados no barramento (endereço + controle + dados) desde a última consulta
+  uint32_t bytes_sent;
 } ssd1306_t;
 
 #endif
\ No newline at end of file
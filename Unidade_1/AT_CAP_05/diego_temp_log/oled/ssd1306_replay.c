@@ -0,0 +1,235 @@
+// Reproduz no computador a sequência de telas do registrador de temperatura (update_display() de
+// diego_temp_log.c: cabeçalho com a escala, temperatura em escala 2, estatísticas do último minuto e
+// gráfico do histórico de trend.c) e conta, leitura a leitura, os bytes que cada atualização coloca no
+// barramento com o enquadramento real (ssd1306_host.c): só as janelas alteradas contra o quadro completo.
+// Falha (código de saída 1) se o painel simulado não ficar igual ao framebuffer depois de alguma atualização
+// ou se as janelas alteradas não custarem menos que o quadro completo.
+// Comandos em lote (ssd1306_send_command_list): confere que a configuração inicial vai numa só transação e
+// compara, na inicialização e por atualização, com o envio de um comando por transação (como era antes).
+// A temperatura simulada oscila devagar (0,5 °C em 20 min) com ruído de alguns centésimos, uma leitura a
+// cada 500 ms como na placa; -p grava o painel da última leitura em PBM para conferir o desenho.
+//
+// Compilação: gcc -std=c11 -O2 -I. -o ssd1306_replay ssd1306_replay.c ssd1306_gfx.c ssd1306_host.c
+//             ../trend/trend.c ../streamstats/streamstats.c -lm
+// Uso:        ssd1306_replay [-n leituras] [-p painel.pbm]
+
+#define _DEFAULT_SOURCE
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include "ssd1306_host.h"
+#include "../trend/trend.h"
+#include "../streamstats/streamstats.h"
+
+// Mesma disposição e ritmo de diego_temp_log.c
+#define replay_period_ms 500
+#define replay_graph_y 40
+#define replay_graph_height 24
+#define replay_trend_bucket_ms 1000
+#define replay_stats_pane 20
+#define replay_stats_panes 6
+
+typedef struct {
+    trend_t trend;
+    trend_graph_t graph;
+    streamstats_t stats;
+} replay_screen_t;
+
+static void replay_split(int centi, const char **sign, int *whole, int *tenth) {
+    int deci = (centi >= 0 ? centi + 5 : centi - 5) / 10;
+
+    *sign = deci < 0 ? "-" : "";
+    if (deci < 0) {
+        deci = -deci;
+    }
+    *whole = deci / 10;
+    *tenth = deci % 10;
+}
+
+static void replay_center(uint8_t *ssd, int page, const char *text) {
+    int x = (ssd1306_width - ssd1306_measure_string(text, 1)) / 2;
+
+    ssd1306_draw_string(ssd, x < 0 ? 0 : x, page * 8, text);
+}
+
+static void replay_format_span(char *text, size_t size, uint32_t seconds) {
+    if (seconds < 2 * 3600) {
+        snprintf(text, size, "%umin", (seconds + 30) / 60);
+    }
+    else if (seconds < 2 * 86400) {
+        snprintf(text, size, "%uh", (seconds + 1800) / 3600);
+    }
+    else {
+        snprintf(text, size, "%ud", (seconds + 43200) / 86400);
+    }
+}
+
+// Uma leitura: histórico, estatísticas e a tela de update_display() no framebuffer
+static void replay_frame(replay_screen_t *screen, uint8_t *ssd, int centi) {
+    char text[40];
+    const char *sign;
+    int whole, tenth;
+    streamstats_summary_t summary;
+
+    uint32_t completed = trend_add(&screen->trend, centi);
+    streamstats_add(&screen->stats, centi);
+    bool have_stats = streamstats_sliding(&screen->stats, &summary);
+
+    trend_graph_update(&screen->graph, &screen->trend, ssd, completed);
+    ssd1306_fill_rect(ssd, 0, 0, ssd1306_width, replay_graph_y, false);
+
+    if (screen->graph.level < 0) {
+        replay_center(ssd, 0, "Temperatura");
+    }
+    else {
+        const char *lo_sign, *hi_sign;
+        int lo_int, lo_decimal, hi_int, hi_decimal;
+        char span[8];
+
+        replay_format_span(span, sizeof(span), screen->graph.w *
+                           trend_bucket_readings(&screen->trend, screen->graph.level) * replay_period_ms / 1000);
+        replay_split(screen->graph.lo, &lo_sign, &lo_int, &lo_decimal);
+        replay_split(screen->graph.hi, &hi_sign, &hi_int, &hi_decimal);
+        snprintf(text, sizeof(text), "%s %s%d,%d a %s%d,%d", span, lo_sign, lo_int, lo_decimal, hi_sign, hi_int, hi_decimal);
+        replay_center(ssd, 0, text);
+    }
+
+    replay_split(centi, &sign, &whole, &tenth);
+    snprintf(text, sizeof(text), "%s%d%c%d%cC", sign, whole, 0x2C, tenth, 0xF8);
+
+    int x = (ssd1306_width - ssd1306_measure_string(text, 2)) / 2;
+    for (size_t i = 0; i < strlen(text); i++) {
+        int y = text[i] == 0x2C ? 16 : (text[i] == (char)0xF8 || text[i] == 'C') ? 8 : 12;
+
+        ssd1306_draw_char_scale2(ssd, x, y, text[i]);
+        x += 2 * ssd1306_char_advance;
+    }
+
+    if (have_stats) {
+        const char *min_sign, *max_sign;
+        int min_int, min_decimal, max_int, max_decimal;
+        uint32_t sd_centi = (streamstats_stddev_q8(&summary) + 128) >> 8;
+
+        replay_split(summary.moments.min, &min_sign, &min_int, &min_decimal);
+        replay_split(summary.moments.max, &max_sign, &max_int, &max_decimal);
+        snprintf(text, sizeof(text), "%s%d,%d/%s%d,%d dp%u,%02u", min_sign, min_int, min_decimal,
+                 max_sign, max_int, max_decimal, sd_centi / 100, sd_centi % 100);
+        replay_center(ssd, 4, text);
+    }
+}
+
+// Temperatura simulada da leitura index (centésimos): deriva lenta e ruído pseudoaleatório fixo
+static int replay_temperature(uint32_t index, uint32_t *seed) {
+    *seed = *seed * 1664525u + 1013904223u;
+
+    double drift = 25 * sin(index * 2 * M_PI * replay_period_ms / (20 * 60 * 1000.0));
+    return (int)lround(2350 + drift) + (int)(*seed >> 29) - 4;
+}
+
+int main(int argc, char **argv) {
+    uint32_t readings = 4 * 3600 * 1000 / replay_period_ms; // 4 h
+    const char *panel_path = NULL;
+
+    for (int i = 1; i < argc; i++) {
+        if (!strcmp(argv[i], "-n") && i + 1 < argc) {
+            readings = (uint32_t)strtoul(argv[++i], NULL, 10);
+        }
+        else if (!strcmp(argv[i], "-p") && i + 1 < argc) {
+            panel_path = argv[++i];
+        }
+        else {
+            fprintf(stderr, "uso: %s [-n leituras] [-p painel.pbm]\n", argv[0]);
+            return 2;
+        }
+    }
+
+    static const struct {
+        const char *name;
+        ssd1306_host_transport_t transport;
+    } transports[] = {
+        { "I2C", ssd1306_host_i2c },
+        { "SPI", ssd1306_host_spi },
+    };
+    bool ok = readings > 0;
+
+    for (size_t t = 0; t < sizeof(transports) / sizeof(transports[0]); t++) {
+        static ssd1306_t oled;
+        static replay_screen_t screen;
+        uint64_t changed_bytes = 0, transactions = 0;
+        uint32_t full_bytes, max_bytes = 0, idle_frames = 0, mismatches = 0, seed = 1;
+
+        ssd1306_init(&oled);
+        ssd1306_host_set_transport(&oled, transports[t].transport);
+
+        // Configuração em lote contra um comando por transação
+        int framing = transports[t].transport == ssd1306_host_i2c ? ssd1306_host_i2c_framing : 0;
+        uint32_t batched_bytes, batched_transactions, single_bytes, commands;
+
+        ssd1306_reset_bytes_sent(&oled);
+        oled.transactions = 0;
+        ssd1306_config(&oled);
+        batched_bytes = ssd1306_get_bytes_sent(&oled);
+        batched_transactions = oled.transactions;
+        commands = batched_bytes - framing * batched_transactions;
+
+        ssd1306_reset_bytes_sent(&oled);
+        for (uint32_t c = 0; c < commands; c++) {
+            ssd1306_command(&oled, 0xE3); // NOP
+        }
+        single_bytes = ssd1306_get_bytes_sent(&oled);
+
+        printf("%s: configuracao %u comandos, em lote %u bytes (%u transacao), um por transacao %u bytes\n",
+               transports[t].name, commands, batched_bytes, batched_transactions, single_bytes);
+        ok = ok && batched_transactions == 1 && batched_bytes == commands + framing &&
+             single_bytes == commands * (1 + framing);
+        trend_init(&screen.trend, replay_trend_bucket_ms / replay_period_ms);
+        trend_graph_init(&screen.graph, 0, replay_graph_y, ssd1306_width, replay_graph_height);
+        streamstats_init(&screen.stats, replay_stats_pane, replay_stats_panes, 1);
+
+        // Quadro completo de referência: o que cada atualização custava antes das janelas
+        ssd1306_reset_bytes_sent(&oled);
+        ssd1306_send_data(&oled);
+        full_bytes = ssd1306_get_bytes_sent(&oled);
+
+        for (uint32_t i = 0; i < readings; i++) {
+            replay_frame(&screen, oled.ram_buffer, replay_temperature(i, &seed));
+
+            ssd1306_reset_bytes_sent(&oled);
+            oled.transactions = 0;
+            render_changes_on_display(&oled);
+
+            uint32_t bytes = ssd1306_get_bytes_sent(&oled);
+            changed_bytes += bytes;
+            transactions += oled.transactions;
+            max_bytes = bytes > max_bytes ? bytes : max_bytes;
+            idle_frames += bytes == 0;
+            mismatches += memcmp(ssd1306_host_panel(&oled), oled.ram_buffer, ssd1306_buffer_length) != 0;
+        }
+
+        double mean = (double)changed_bytes / readings;
+
+        // Cada janela são duas transações; com um comando por transação, os 6 de endereço custariam 6 enquadramentos
+        uint64_t windows = transactions / 2;
+        double unbatched_mean = (changed_bytes + windows * (ssd1306_host_window_commands - 1) * framing) / (double)readings;
+
+        printf("%s: %u leituras, quadro completo %u bytes | alteradas: media %.1f bytes (%.1f transacoes),"
+               " max %u, %u sem envio | %.1fx menos bytes\n",
+               transports[t].name, readings, full_bytes, mean, (double)transactions / readings, max_bytes,
+               idle_frames, full_bytes / mean);
+        printf("  com um comando por transacao: media %.1f bytes (quadro completo %u)\n", unbatched_mean,
+               full_bytes + (ssd1306_host_window_commands - 1) * framing);
+        if (mismatches) {
+            printf("  %u atualizacoes deixaram o painel diferente do framebuffer\n", mismatches);
+        }
+        ok = ok && mismatches == 0 && mean < full_bytes && max_bytes <= full_bytes;
+
+        if (panel_path && t == 0 && !ssd1306_save_pbm(ssd1306_host_panel(&oled), panel_path)) {
+            fprintf(stderr, "erro ao gravar %s\n", panel_path);
+            return 2;
+        }
+    }
+    printf("%s\n", ok ? "OK" : "FALHOU");
+
+    return ok ? 0 : 1;
+}
@@ -0,0 +1,80 @@
+#include <stdint.h>
+#include <stdbool.h>
+#ifdef READING_RING_HOST
+// No computador (reading_ring_test.c): barreira de memória do GCC e sem WFE/SEV
+#define __dmb() __atomic_thread_fence(__ATOMIC_SEQ_CST)
+#define __sev() ((void)0)
+#else
+#include "hardware/sync.h"
+#endif
+#include "decimator/decimator.h"
+
+#ifndef reading_ring_inc_h
+#define reading_ring_inc_h
+
+// Fila circular sem travas de um produtor (núcleo 1: aquisição) e um consumidor (núcleo 0: apresentação).
+// Cada índice só é escrito por um dos lados; a barreira de memória publica o registro antes do índice.
+// Fila cheia: o registro novo é descartado e contado (a aquisição nunca espera pela apresentação)
+
+#define reading_ring_size 16 // Potência de 2
+
+// Leitura com instante e os contadores da aquisição no momento em que foi produzida
+typedef struct {
+    uint32_t sequence;          // Número da leitura (contínuo, inclusive as descartadas)
+    uint32_t time_ms;           // Instante pela contagem de amostras (ms desde o início da aquisição)
+    int32_t temperature_centi;  // Temperatura em centésimos de grau
+    decimator_output_t reading; // Saída do decimador
+    uint32_t samples;           // Amostras desde o início da aquisição (processadas e perdidas)
+    uint32_t blocks_done;       // Blocos completados pelo DMA
+    uint32_t block_overruns;    // Blocos sobrescritos antes de serem processados
+    uint32_t fifo_overruns;     // Estouros do FIFO do ADC
+    uint32_t dropped;           // Registros descartados com a fila cheia
+    int32_t adc_quantile_q8[3]; // Quantis 5%, 50% e 95% das amostras brutas da janela (LSB * 256)
+} reading_record_t;
+
+typedef struct {
+    reading_record_t records[reading_ring_size];
+    volatile uint32_t head;    // Escrito só pelo produtor
+    volatile uint32_t tail;    // Escrito só pelo consumidor
+    volatile uint32_t dropped; // Escrito só pelo produtor
+} reading_ring_t;
+
+// Produtor: copia o registro para a fila e acorda o consumidor; false se a fila estava cheia
+static inline bool reading_ring_push(reading_ring_t *ring, const reading_record_t *record) {
+    uint32_t head = ring->head;
+
+    if (head - ring->tail == reading_ring_size) {
+        ring->dropped++;
+        return false;
+    }
+
+    ring->records[head % reading_ring_size] = *record;
+    ring->records[head % reading_ring_size].dropped = ring->dropped;
+    __dmb(); // O registro fica visível antes do novo índice
+    ring->head = head + 1;
+    __sev(); // Acorda o outro núcleo se estiver em WFE
+
+    return true;
+}
+
+// Consumidor: copia o registro mais antigo; false se a fila estava vazia
+static inline bool reading_ring_pop(reading_ring_t *ring, reading_record_t *record) {
+    uint32_t tail = ring->tail;
+
+    if (ring->head == tail) {
+        return false;
+    }
+
+    __dmb(); // Lê o registro só depois de ver o índice publicado
+    *record = ring->records[tail % reading_ring_size];
+    __dmb(); // Termina a cópia antes de liberar a posição
+    ring->tail = tail + 1;
+
+    return true;
+}
+
+static inline bool reading_ring_empty(const reading_ring_t *ring) {
+    return ring->head == ring->tail;
+}
+
+#endif
@@ -0,0 +1,116 @@
+// Confere a fila entre os núcleos (reading_ring.h) no computador, com duas threads no lugar dos núcleos:
+// o produtor empurra leituras numeradas sem esperar (como a aquisição) e o consumidor as tira em rajadas
+// irregulares (como o display e a USB); as duas cedem o processador em pontos aleatórios (sched_yield), de
+// modo que a fila enche e esvazia muitas vezes mesmo num computador de um só núcleo.
+// Conferência: as leituras saem em ordem crescente, sem registro rasgado (todos os campos da mesma
+// leitura), o contador de descartes gravado em cada uma cresce e bate com as leituras que faltaram antes
+// dela, e entregues + descartadas = produzidas.
+// Falha (código de saída 1) se alguma conferência não passar.
+//
+// Compilação: gcc -std=c11 -O2 -DREADING_RING_HOST -pthread -o reading_ring_test reading_ring_test.c
+// Uso:        reading_ring_test [-n leituras]
+
+#define _POSIX_C_SOURCE 199309L
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <pthread.h>
+#include <sched.h>
+#include "reading_ring.h"
+
+static reading_ring_t ring;
+static volatile bool producer_done = false;
+static uint32_t readings = 1000000;
+
+// Sorteio simples e próprio de cada thread
+static uint32_t next_random(uint32_t *state) {
+    *state = *state * 1103515245u + 12345u;
+    return *state >> 16;
+}
+
+// Campos derivados da sequência: um registro rasgado mistura leituras e não passa na conferência
+static void fill_record(reading_record_t *record, uint32_t sequence) {
+    memset(record, 0, sizeof(*record));
+    record->sequence = sequence;
+    record->time_ms = sequence * 500;
+    record->temperature_centi = (int32_t)(sequence * 2654435761u);
+    record->reading.code_q8 = ~sequence;
+    record->samples = sequence * 125000;
+    record->adc_quantile_q8[2] = (int32_t)(sequence ^ 0x5A5A5A5A);
+}
+
+static bool record_consistent(const reading_record_t *record) {
+    reading_record_t expected;
+
+    fill_record(&expected, record->sequence);
+    return record->time_ms == expected.time_ms && record->temperature_centi == expected.temperature_centi &&
+           record->reading.code_q8 == expected.reading.code_q8 && record->samples == expected.samples &&
+           record->adc_quantile_q8[2] == expected.adc_quantile_q8[2];
+}
+
+static void *producer(void *argument) {
+    reading_record_t record;
+    uint32_t state = 7;
+
+    (void)argument;
+    for (uint32_t sequence = 1; sequence <= readings; sequence++) {
+        fill_record(&record, sequence);
+        reading_ring_push(&ring, &record);
+        if (next_random(&state) % 24 == 0) {
+            sched_yield();
+        }
+    }
+    producer_done = true;
+
+    return NULL;
+}
+
+int main(int argc, char **argv) {
+    if (argc == 3 && !strcmp(argv[1], "-n")) {
+        readings = (uint32_t)strtoul(argv[2], NULL, 10);
+    }
+    else if (argc != 1) {
+        fprintf(stderr, "uso: %s [-n leituras]\n", argv[0]);
+        return 2;
+    }
+
+    pthread_t thread;
+    pthread_create(&thread, NULL, producer, NULL);
+
+    reading_record_t record;
+    uint32_t received = 0, last_sequence = 0, last_dropped = 0, order_errors = 0, torn = 0, count_errors = 0;
+    uint32_t state = 1;
+
+    for (;;) {
+        bool done = producer_done;
+
+        while (reading_ring_pop(&ring, &record)) {
+            received++;
+            order_errors += record.sequence <= last_sequence;
+            torn += !record_consistent(&record);
+            // Antes desta leitura faltaram exatamente as descartadas até ela
+            count_errors += record.dropped < last_dropped || record.sequence - 1 - (received - 1) != record.dropped;
+            last_sequence = record.sequence;
+            last_dropped = record.dropped;
+
+            // Rajadas irregulares: a fila enche enquanto o consumidor está parado
+            if (next_random(&state) % 16 == 0) {
+                sched_yield();
+            }
+        }
+        if (done) {
+            break;
+        }
+        sched_yield();
+    }
+    pthread_join(thread, NULL);
+
+    bool ok = order_errors == 0 && torn == 0 && count_errors == 0 && received + ring.dropped == readings &&
+              received > 0 && ring.dropped > 0;
+
+    printf("produzidas %u, entregues %u, descartadas %u | fora de ordem %u, rasgadas %u, descartes incoerentes %u\n",
+           readings, received, ring.dropped, order_errors, torn, count_errors);
+    printf("%s\n", ok ? "OK" : "FALHOU");
+
+    return ok ? 0 : 1;
+}
@@ -0,0 +1,68 @@
+#include <stdint.h>
+#include <stdbool.h>
+
+#ifndef streamstats_inc_h
+#define streamstats_inc_h
+
+// Estatísticas de um fluxo de amostras inteiras em memória constante: contagem, mínimo, máximo,
+// média e variância (Welford, com blocos combinados pela fórmula de Chan) e quantis pelo algoritmo P²
+// (Jain e Chlamtac), sem guardar as amostras e sem ponto flutuante.
+// O fluxo é dividido em painéis de pane_size amostras:
+//   janela fixa (tumbling): o último painel completo
+//   janela deslizante: os últimos panes painéis completos combinados (momentos exatos; quantis pela média
+//   dos quantis dos painéis, ponderada pela contagem)
+// Por amostra só há soma, soma dos quadrados e extremos; a divisão de 64 bits fica uma vez por bloco.
+// O P² recebe uma amostra a cada p2_stride (para fluxos rápidos, como o ADC a centenas de kHz)
+
+#define streamstats_max_panes 8
+#define streamstats_quantiles 3
+#define streamstats_frac_bits 8 // Média, desvio e quantis com 8 bits de fração (Q8)
+
+// Quantis estimados, em milésimos: 5%, 50% (mediana) e 95%
+#define streamstats_quantile_permille { 50, 500, 950 }
+
+typedef struct {
+    uint32_t count;
+    int32_t min, max;
+    int64_t mean_q16; // Média * 65536
+    int64_t m2_q16;   // Soma dos quadrados dos desvios * 65536
+} streamstats_moments_t;
+
+// Estimador P² de um quantil: alturas (Q8) e posições dos 5 marcadores
+typedef struct {
+    int32_t height[5];
+    int32_t position[5];
+    int64_t desired_q16[5];
+    int32_t increment_q16[5];
+    uint8_t initial; // Amostras recebidas enquanto menos de 5
+} streamstats_p2_t;
+
+typedef struct {
+    streamstats_moments_t moments;
+    int32_t quantile_q8[streamstats_quantiles];
+} streamstats_summary_t;
+
+typedef struct {
+    uint32_t pane_size;
+    uint8_t panes;
+    uint8_t p2_stride;
+    uint8_t stride_phase;
+
+    streamstats_moments_t current;
+    streamstats_p2_t p2[streamstats_quantiles];
+
+    streamstats_summary_t history[streamstats_max_panes]; // Painéis completos (circular)
+    uint8_t head, filled;
+    uint32_t completed; // Painéis completos desde o início
+} streamstats_t;
+
+extern void streamstats_init(streamstats_t *stats, uint32_t pane_size, uint8_t panes, uint8_t p2_stride);
+extern bool streamstats_add(streamstats_t *stats, int32_t value);
+extern bool streamstats_add_block(streamstats_t *stats, const uint16_t *samples, uint32_t count);
+extern bool streamstats_tumbling(const streamstats_t *stats, streamstats_summary_t *summary);
+extern bool streamstats_sliding(const streamstats_t *stats, streamstats_summary_t *summary);
+
+extern int32_t streamstats_mean_q8(const streamstats_summary_t *summary);
+extern uint32_t streamstats_stddev_q8(const streamstats_summary_t *summary);
+
+#endif
@@ -0,0 +1,179 @@
+#include <stdio.h>
+#include <string.h>
+#include <assert.h>
+#ifdef TELEMETRY_HOST
+#define time_us_32() telemetry_host_time_us
+#else
+#include "pico/stdlib.h"
+#endif
+#include "telemetry.h"
+
+typedef struct {
+    const char *name;
+    const char *fields;
+} telemetry_type_t;
+
+// Um registro de dados com todos os campos no pior caso (5 bytes por varint) tem que caber num quadro
+_Static_assert(telemetry_max_fields * 5 + telemetry_frame_overhead <= telemetry_max_frame,
+               "telemetry_max_fields não cabe em telemetry_max_frame");
+
+static telemetry_type_t telemetry_types[telemetry_max_types + 1];
+static uint32_t telemetry_last_describe;
+
+// CRC-16/CCITT-FALSE (polinômio 0x1021, valor inicial 0xFFFF), bit a bit
+uint16_t telemetry_crc16(const uint8_t *data, size_t length) {
+    uint16_t crc = 0xFFFF;
+
+    for (size_t i = 0; i < length; i++) {
+        crc ^= (uint16_t)data[i] << 8;
+        for (int bit = 0; bit < 8; bit++) {
+            crc = crc & 0x8000 ? (uint16_t)((crc << 1) ^ 0x1021) : (uint16_t)(crc << 1);
+        }
+    }
+
+    return crc;
+}
+
+// COBS: cada bloco começa com a distância até o próximo 0x00 (que é omitido); retorna o tamanho codificado
+size_t telemetry_cobs_encode(const uint8_t *data, size_t length, uint8_t *out) {
+    size_t code_pos = 0, out_pos = 1;
+    uint8_t code = 1;
+
+    for (size_t i = 0; i < length; i++) {
+        if (data[i] == 0) {
+            out[code_pos] = code;
+            code_pos = out_pos++;
+            code = 1;
+            continue;
+        }
+
+        out[out_pos++] = data[i];
+        if (++code == 0xFF) {
+            out[code_pos] = code;
+            code_pos = out_pos++;
+            code = 1;
+        }
+    }
+    out[code_pos] = code;
+
+    return out_pos;
+}
+
+// Monta o quadro (tipo, instante, conteúdo, CRC) e o codifica entre dois 0x00; retorna o tamanho final
+size_t telemetry_build_frame(uint8_t type, uint32_t time_us, const uint8_t *payload, size_t length, uint8_t *out) {
+    uint8_t frame[telemetry_max_frame];
+
+    assert(length + telemetry_frame_overhead <= telemetry_max_frame);
+
+    frame[0] = type;
+    for (int i = 0; i < 4; i++) {
+        frame[1 + i] = (uint8_t)(time_us >> (8 * i));
+    }
+    memcpy(frame + 5, payload, length);
+
+    uint16_t crc = telemetry_crc16(frame, length + 5);
+    frame[length + 5] = (uint8_t)crc;
+    frame[length + 6] = (uint8_t)(crc >> 8);
+
+    out[0] = 0;
+    size_t encoded = telemetry_cobs_encode(frame, length + 7, out + 1);
+    out[encoded + 1] = 0;
+
+    return encoded + 2;
+}
+
+// Envia o quadro de uma vez (sob a trava do stdio, sem tradução de fim de linha): quadros de núcleos ou
+// interrupções diferentes não se misturam
+static void telemetry_write(uint8_t type, uint32_t time_us, const uint8_t *payload, size_t length) {
+    uint8_t out[telemetry_max_encoded + 2];
+    size_t size = telemetry_build_frame(type, time_us, payload, length, out);
+
+#ifdef TELEMETRY_HOST
+    telemetry_host_write(out, size);
+#else
+    stdio_put_string((const char *)out, (int)size, false, false);
+#endif
+}
+
+// Conteúdo da descrição: tipo descrito, nome e campos, com os terminadores
+static size_t telemetry_descriptor_length(const char *name, const char *fields) {
+    return 1 + strlen(name) + 1 + strlen(fields) + 1;
+}
+
+static void telemetry_describe(uint8_t type, uint32_t time_us) {
+    uint8_t payload[telemetry_max_frame - telemetry_frame_overhead];
+    size_t name_length = strlen(telemetry_types[type].name) + 1;
+    size_t fields_length = strlen(telemetry_types[type].fields) + 1;
+
+    assert(1 + name_length + fields_length <= sizeof(payload)); // Garantido por telemetry_define()
+
+    payload[0] = type;
+    memcpy(payload + 1, telemetry_types[type].name, name_length);
+    memcpy(payload + 1 + name_length, telemetry_types[type].fields, fields_length);
+    telemetry_write(telemetry_descriptor, time_us, payload, 1 + name_length + fields_length);
+}
+
+bool telemetry_define(uint8_t type, const char *name, const char *fields) {
+    assert(type > telemetry_descriptor && type <= telemetry_max_types);
+
+    // A descrição tem que caber num quadro e os campos não podem passar de telemetry_max_fields;
+    // a verificação vale também sem assert (NDEBUG): o tipo recusado não é registrado nem enviado
+    int field_count = 1;
+    for (const char *c = fields; *c; c++) {
+        field_count += *c == ',';
+    }
+    size_t length = telemetry_descriptor_length(name, fields);
+    if (length + telemetry_frame_overhead > telemetry_max_frame || field_count > telemetry_max_fields) {
+        printf("Erro: telemetria \"%s\" com %d campos e descricao de %u bytes (max %d campos, %d bytes)\n",
+               name, field_count, (unsigned)length, telemetry_max_fields, telemetry_max_frame - telemetry_frame_overhead);
+        assert(false);
+        return false;
+    }
+
+    telemetry_types[type].name = name;
+    telemetry_types[type].fields = fields;
+    telemetry_describe(type, time_us_32());
+
+    return true;
+}
+
+// Varint zigzag: valores pequenos, positivos ou negativos, ocupam um byte
+static size_t telemetry_put_value(uint8_t *out, int32_t value) {
+    uint32_t zigzag = ((uint32_t)value << 1) ^ (uint32_t)(value >> 31);
+    size_t n = 0;
+
+    while (zigzag >= 0x80) {
+        out[n++] = (uint8_t)(zigzag | 0x80);
+        zigzag >>= 7;
+    }
+    out[n++] = (uint8_t)zigzag;
+
+    return n;
+}
+
+void telemetry_send(uint8_t type, uint32_t time_us, const int32_t *values, int count) {
+    uint8_t payload[telemetry_max_fields * 5];
+    size_t length = 0;
+
+    assert(type > telemetry_descriptor && type <= telemetry_max_types && telemetry_types[type].name);
+    assert(count <= telemetry_max_fields);
+    if (type > telemetry_max_types || !telemetry_types[type].name || count > telemetry_max_fields) {
+        return; // Tipo recusado por telemetry_define() (ou nunca definido): nada a enviar
+    }
+
+    // Reenvio periódico das descrições
+    uint32_t now = time_us_32();
+    if (now - telemetry_last_describe >= telemetry_describe_interval_us) {
+        telemetry_last_describe = now;
+        for (int i = 1; i <= telemetry_max_types; i++) {
+            if (telemetry_types[i].name) {
+                telemetry_describe(i, now);
+            }
+        }
+    }
+
+    for (int i = 0; i < count; i++) {
+        length += telemetry_put_value(payload + length, values[i]);
+    }
+    telemetry_write(type, time_us, payload, length);
+}
@@ -0,0 +1,288 @@
+// Decodificador da telemetria binária (telemetry.h) para CSV, executado no computador.
+// Lê o fluxo da porta USB (ou de um arquivo gravado) e escreve uma linha por registro:
+//   nome,tempo_s,campo1,campo2,...
+// precedida, na primeira vez que cada tipo é descrito, pela linha de cabeçalho desse tipo.
+// Quadros com erro de CRC e bytes fora de quadros (textos de printf) são descartados e contados.
+//
+// Compilação: g++ -std=c++17 -O2 -o telemetry_decode telemetry_decode.cpp
+// Uso:        telemetry_decode [arquivo|/dev/ttyACM0] [-t nome] > saida.csv
+
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <map>
+#include <string>
+#include <vector>
+
+namespace {
+
+struct Field {
+    std::string name;
+    int decimals = 0;
+};
+
+struct RecordType {
+    std::string name;
+    std::vector<Field> fields;
+    bool header_printed = false;
+};
+
+struct Stats {
+    unsigned long frames = 0, records = 0, crc_errors = 0, framing_errors = 0, undescribed = 0;
+};
+
+uint16_t crc16(const uint8_t *data, size_t length) {
+    uint16_t crc = 0xFFFF;
+
+    for (size_t i = 0; i < length; i++) {
+        crc ^= static_cast<uint16_t>(data[i] << 8);
+        for (int bit = 0; bit < 8; bit++) {
+            crc = crc & 0x8000 ? static_cast<uint16_t>((crc << 1) ^ 0x1021) : static_cast<uint16_t>(crc << 1);
+        }
+    }
+
+    return crc;
+}
+
+// Desfaz o COBS; false se o bloco for inconsistente
+bool cobs_decode(const std::vector<uint8_t> &in, std::vector<uint8_t> &out) {
+    out.clear();
+
+    for (size_t pos = 0; pos < in.size();) {
+        uint8_t code = in[pos++];
+
+        if (code == 0 || pos + code - 1 > in.size()) {
+            return false;
+        }
+        out.insert(out.end(), in.begin() + pos, in.begin() + pos + code - 1);
+        pos += code - 1;
+        if (code != 0xFF && pos < in.size()) {
+            out.push_back(0);
+        }
+    }
+
+    return true;
+}
+
+bool get_varint(const uint8_t *data, size_t length, size_t &pos, uint32_t &value) {
+    value = 0;
+
+    for (int shift = 0; shift < 35 && pos < length; shift += 7) {
+        uint8_t byte = data[pos++];
+
+        value |= static_cast<uint32_t>(byte & 0x7F) << shift;
+        if (!(byte & 0x80)) {
+            return true;
+        }
+    }
+
+    return false;
+}
+
+std::vector<Field> parse_fields(const std::string &spec) {
+    std::vector<Field> fields;
+    size_t start = 0;
+
+    while (start <= spec.size()) {
+        size_t end = spec.find(',', start);
+        std::string item = spec.substr(start, end == std::string::npos ? std::string::npos : end - start);
+        Field field;
+        size_t colon = item.find(':');
+
+        field.name = item.substr(0, colon);
+        if (colon != std::string::npos) {
+            field.decimals = std::atoi(item.c_str() + colon + 1);
+        }
+        if (!field.name.empty()) {
+            fields.push_back(field);
+        }
+        if (end == std::string::npos) {
+            break;
+        }
+        start = end + 1;
+    }
+
+    return fields;
+}
+
+// Valor inteiro com n casas decimais implícitas, sem passar por ponto flutuante
+std::string format_value(int32_t value, int decimals) {
+    if (decimals <= 0) {
+        return std::to_string(value);
+    }
+
+    int64_t magnitude = value < 0 ? -static_cast<int64_t>(value) : value;
+    int64_t scale = 1;
+    for (int i = 0; i < decimals; i++) {
+        scale *= 10;
+    }
+
+    std::string fraction = std::to_string(magnitude % scale);
+    fraction.insert(0, decimals - fraction.size(), '0');
+
+    return (value < 0 ? "-" : "") + std::to_string(magnitude / scale) + "." + fraction;
+}
+
+class Decoder {
+public:
+    explicit Decoder(const char *filter) : filter_(filter ? filter : "") {}
+
+    void feed(uint8_t byte) {
+        if (byte != 0) {
+            if (chunk_.size() < 512) {
+                chunk_.push_back(byte);
+            }
+            return;
+        }
+        if (!chunk_.empty()) {
+            frame(chunk_);
+            chunk_.clear();
+        }
+    }
+
+    const Stats &stats() const { return stats_; }
+
+private:
+    void frame(const std::vector<uint8_t> &encoded) {
+        if (!cobs_decode(encoded, decoded_) || decoded_.size() < 7) {
+            stats_.framing_errors++;
+            return;
+        }
+
+        size_t length = decoded_.size() - 2;
+        uint16_t crc = static_cast<uint16_t>(decoded_[length] | (decoded_[length + 1] << 8));
+        if (crc16(decoded_.data(), length) != crc) {
+            stats_.crc_errors++;
+            return;
+        }
+        stats_.frames++;
+
+        uint8_t type = decoded_[0];
+        uint32_t time_us = 0;
+        for (int i = 0; i < 4; i++) {
+            time_us |= static_cast<uint32_t>(decoded_[1 + i]) << (8 * i);
+        }
+
+        // Instante em 64 bits: o contador de 32 bits da placa volta a zero a cada ~71 minutos
+        if (have_time_ && time_us < last_time_us_ && last_time_us_ - time_us > 0x80000000u) {
+            time_high_ += 1ULL << 32;
+        }
+        have_time_ = true;
+        last_time_us_ = time_us;
+        uint64_t time = time_high_ | time_us;
+
+        if (type == 0) {
+            describe(decoded_.data() + 5, length - 5);
+        }
+        else {
+            record(type, time, decoded_.data() + 5, length - 5);
+        }
+    }
+
+    void describe(const uint8_t *data, size_t length) {
+        if (length < 3) {
+            return;
+        }
+
+        const char *name = reinterpret_cast<const char *>(data + 1);
+        size_t name_length = strnlen(name, length - 1);
+        if (name_length + 2 >= length) {
+            return;
+        }
+        const char *fields = name + name_length + 1;
+        std::string spec(fields, strnlen(fields, length - 2 - name_length));
+
+        RecordType &entry = types_[data[0]];
+        if (entry.name != name || entry.fields.size() != parse_fields(spec).size()) {
+            entry.name = name;
+            entry.fields = parse_fields(spec);
+            entry.header_printed = false;
+        }
+    }
+
+    void record(uint8_t type, uint64_t time_us, const uint8_t *data, size_t length) {
+        auto it = types_.find(type);
+        if (it == types_.end()) {
+            stats_.undescribed++;
+            return;
+        }
+
+        RecordType &entry = it->second;
+        if (!filter_.empty() && entry.name != filter_) {
+            return;
+        }
+        if (!entry.header_printed) {
+            std::printf("%s,tempo_s", entry.name.c_str());
+            for (const Field &field : entry.fields) {
+                std::printf(",%s", field.name.c_str());
+            }
+            std::printf("\n");
+            entry.header_printed = true;
+        }
+
+        char time[32];
+        std::snprintf(time, sizeof(time), "%llu.%06llu", static_cast<unsigned long long>(time_us / 1000000),
+                      static_cast<unsigned long long>(time_us % 1000000));
+
+        std::string line = entry.name + "," + time;
+        size_t pos = 0;
+        for (const Field &field : entry.fields) {
+            uint32_t zigzag;
+            if (!get_varint(data, length, pos, zigzag)) {
+                break;
+            }
+            int32_t value = static_cast<int32_t>(zigzag >> 1) ^ -static_cast<int32_t>(zigzag & 1);
+            line += "," + format_value(value, field.decimals);
+        }
+        std::printf("%s\n", line.c_str());
+        stats_.records++;
+    }
+
+    std::string filter_;
+    std::vector<uint8_t> chunk_, decoded_;
+    std::map<uint8_t, RecordType> types_;
+    Stats stats_;
+    bool have_time_ = false;
+    uint32_t last_time_us_ = 0;
+    uint64_t time_high_ = 0;
+};
+
+} // namespace
+
+int main(int argc, char **argv) {
+    const char *path = nullptr;
+    const char *filter = nullptr;
+
+    for (int i = 1; i < argc; i++) {
+        if (std::strcmp(argv[i], "-t") == 0 && i + 1 < argc) {
+            filter = argv[++i];
+        }
+        else {
+            path = argv[i];
+        }
+    }
+
+    FILE *input = path ? std::fopen(path, "rb") : stdin;
+    if (!input) {
+        std::perror(path);
+        return 1;
+    }
+
+    Decoder decoder(filter);
+    uint8_t buffer[4096];
+    size_t length;
+
+    while ((length = std::fread(buffer, 1, sizeof(buffer), input)) > 0) {
+        for (size_t i = 0; i < length; i++) {
+            decoder.feed(buffer[i]);
+        }
+        std::fflush(stdout);
+    }
+
+    const Stats &stats = decoder.stats();
+    std::fprintf(stderr, "quadros %lu registros %lu erros de CRC %lu fora de quadro %lu sem descricao %lu\n",
+                 stats.frames, stats.records, stats.crc_errors, stats.framing_errors, stats.undescribed);
+
+    return 0;
+}
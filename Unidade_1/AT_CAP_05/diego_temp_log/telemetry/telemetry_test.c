@@ -0,0 +1,277 @@
+// Confere a codificação da telemetria (telemetry.c) no computador, sem a USB: os quadros enviados vão para
+// um buffer e são desfeitos aqui (COBS, CRC, varint zigzag) como faz telemetry_decode.cpp.
+//   - CRC: o valor de referência do CRC-16/CCITT-FALSE ("123456789" -> 0x29B1).
+//   - COBS: blocos aleatórios de 0 a 600 bytes, com poucos ou muitos zeros e sequências longas sem zero,
+//     codificados sem nenhum 0x00, no tamanho esperado (um byte a mais a cada 254) e desfeitos sem perdas.
+//   - Ida e volta: descrições e registros com valores extremos (0, -1, INT32_MIN, INT32_MAX), um registro
+//     com telemetry_max_fields campos e o instante passando de 2^32 us; cada quadro chega inteiro, com CRC
+//     certo, e os valores voltam iguais.
+//   - Reenvio das descrições a cada telemetry_describe_interval_us, e recusa de uma descrição com campos
+//     demais (também com NDEBUG): nada é enviado para o tipo recusado.
+// Falha (código de saída 1) se alguma conferência não passar.
+// Com -o, grava o fluxo (com linhas de texto entre os quadros, como printf na placa) para conferir o
+// decodificador: telemetry_decode fluxo.bin
+//
+// Compilação: gcc -std=c11 -O2 -DTELEMETRY_HOST -DNDEBUG -o telemetry_test telemetry_test.c telemetry.c
+// Uso:        telemetry_test [-o fluxo.bin]
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdbool.h>
+#include "telemetry.h"
+
+#define test_stream_size 65536
+#define test_max_values telemetry_max_fields
+#define test_rounds 40 // Envios de 100 ms, cada um com uma linha de texto e um registro de cada tipo
+
+uint32_t telemetry_host_time_us;
+
+static uint8_t test_stream[test_stream_size];
+static size_t test_stream_length;
+
+// Recebe os quadros de telemetry.c (no lugar da USB)
+void telemetry_host_write(const uint8_t *data, size_t length) {
+    if (test_stream_length + length <= test_stream_size) {
+        memcpy(test_stream + test_stream_length, data, length);
+        test_stream_length += length;
+    }
+}
+
+// Texto entre os quadros, como um printf na placa
+static void test_text(const char *text) {
+    telemetry_host_write((const uint8_t *)text, strlen(text));
+}
+
+// Desfaz o COBS; devolve o tamanho ou -1 se o bloco for inconsistente
+static long cobs_decode(const uint8_t *in, size_t length, uint8_t *out) {
+    size_t out_pos = 0;
+
+    for (size_t pos = 0; pos < length;) {
+        uint8_t code = in[pos++];
+
+        if (code == 0 || pos + code - 1 > length) {
+            return -1;
+        }
+        memcpy(out + out_pos, in + pos, code - 1);
+        out_pos += code - 1;
+        pos += code - 1;
+        if (code != 0xFF && pos < length) {
+            out[out_pos++] = 0;
+        }
+    }
+
+    return (long)out_pos;
+}
+
+// Quadro desfeito: tipo, instante e conteúdo
+typedef struct {
+    uint8_t type;
+    uint32_t time_us;
+    uint8_t payload[telemetry_max_frame];
+    size_t length;
+} test_frame_t;
+
+// Próximo quadro do fluxo a partir de *pos; texto fora dos quadros (COBS inconsistente ou curto demais) e
+// quadros com CRC errado são contados e pulados, como em telemetry_decode.cpp; false no fim do fluxo
+static bool next_frame(size_t *pos, test_frame_t *frame, unsigned *framing_errors, unsigned *crc_errors) {
+    uint8_t decoded[2 * telemetry_max_encoded];
+
+    while (*pos < test_stream_length) {
+        // Um quadro vai de um 0x00 ao seguinte
+        while (*pos < test_stream_length && test_stream[*pos] != 0) {
+            (*pos)++;
+        }
+        size_t start = ++(*pos);
+        while (*pos < test_stream_length && test_stream[*pos] != 0) {
+            (*pos)++;
+        }
+        if (*pos >= test_stream_length || *pos == start) {
+            continue; // Fim do fluxo, ou o 0x00 final de um quadro seguido do inicial do próximo
+        }
+
+        long length = cobs_decode(test_stream + start, *pos - start, decoded);
+        if (length < telemetry_frame_overhead) {
+            (*framing_errors)++;
+            continue;
+        }
+        uint16_t crc = (uint16_t)(decoded[length - 2] | decoded[length - 1] << 8);
+        if (telemetry_crc16(decoded, (size_t)length - 2) != crc) {
+            (*crc_errors)++;
+            continue;
+        }
+
+        frame->type = decoded[0];
+        frame->time_us = 0;
+        for (int i = 0; i < 4; i++) {
+            frame->time_us |= (uint32_t)decoded[1 + i] << (8 * i);
+        }
+        frame->length = (size_t)length - telemetry_frame_overhead;
+        memcpy(frame->payload, decoded + 5, frame->length);
+        return true;
+    }
+
+    return false;
+}
+
+static int get_values(const test_frame_t *frame, int32_t *values) {
+    size_t pos = 0;
+    int count = 0;
+
+    while (pos < frame->length && count < test_max_values) {
+        uint32_t zigzag = 0;
+
+        for (int shift = 0; shift < 35 && pos < frame->length; shift += 7) {
+            uint8_t byte = frame->payload[pos++];
+
+            zigzag |= (uint32_t)(byte & 0x7F) << shift;
+            if (!(byte & 0x80)) {
+                break;
+            }
+        }
+        values[count++] = (int32_t)((zigzag >> 1) ^ -(zigzag & 1));
+    }
+
+    return count;
+}
+
+static bool check_cobs(void) {
+    static uint8_t data[600], encoded[700], decoded[700];
+    int errors = 0, cases = 0;
+
+    srand(1);
+    for (size_t length = 0; length <= sizeof(data); length++) {
+        for (int density = 0; density < 3; density++) {
+            // Sem zeros (blocos de 254), zeros raros e zeros frequentes
+            for (size_t i = 0; i < length; i++) {
+                int zero = density == 0 ? 0 : density == 1 ? rand() % 100 == 0 : rand() % 3 == 0;
+
+                data[i] = zero ? 0 : (uint8_t)(1 + rand() % 255);
+            }
+
+            size_t size = telemetry_cobs_encode(data, length, encoded);
+            long back = cobs_decode(encoded, size, decoded);
+            bool has_zero = memchr(encoded, 0, size) != NULL;
+            bool size_ok = size >= length + 1 && size <= length + 1 + length / 254;
+
+            if (density == 0 && size != length + 1 + length / 254) {
+                size_ok = false;
+            }
+            cases++;
+            errors += has_zero || !size_ok || back != (long)length || memcmp(decoded, data, length) != 0;
+        }
+    }
+    printf("COBS: %d blocos, %d com zero na saida, tamanho errado ou diferentes na volta\n", cases, errors);
+
+    return errors == 0;
+}
+
+int main(int argc, char **argv) {
+    const char *output = NULL;
+    bool ok = true;
+
+    if (argc == 3 && !strcmp(argv[1], "-o")) {
+        output = argv[2];
+    }
+    else if (argc != 1) {
+        fprintf(stderr, "uso: %s [-o fluxo.bin]\n", argv[0]);
+        return 2;
+    }
+
+    uint16_t check = telemetry_crc16((const uint8_t *)"123456789", 9);
+    printf("CRC-16/CCITT-FALSE de \"123456789\": 0x%04X (esperado 0x29B1)\n", check);
+    ok = ok && check == 0x29B1;
+
+    ok = check_cobs() && ok;
+
+    // Ida e volta pelo envio
+    const int32_t extremes[] = { 0, -1, 1, 63, -64, 64, INT32_MIN, INT32_MAX, -2500, 123456 };
+    const int extreme_count = sizeof(extremes) / sizeof(extremes[0]);
+    char wide_fields[test_max_values * 4];
+    int32_t wide[test_max_values];
+
+    wide_fields[0] = 0;
+    for (int i = 0; i < test_max_values; i++) {
+        snprintf(wide_fields + strlen(wide_fields), sizeof(wide_fields) - strlen(wide_fields), "%sc%d",
+                 i ? "," : "", i);
+        wide[i] = (i & 1 ? -1 : 1) * (int32_t)(0x7FFFFFFFu >> i);
+    }
+
+    telemetry_host_time_us = 0xFFFFFFFFu - 1500000; // O instante passa de 2^32 durante o envio
+    bool defined = telemetry_define(1, "extremos", "a,b,c,d:1,e:2,f,g,h,i:3,j");
+    defined = telemetry_define(2, "largo", wide_fields) && defined;
+
+    // Recusado: um campo além de telemetry_max_fields
+    char too_many[sizeof(wide_fields) + 8];
+    snprintf(too_many, sizeof(too_many), "%s,extra", wide_fields);
+    bool refused = !telemetry_define(3, "demais", too_many);
+
+    int sent = 0;
+    for (int i = 0; i < test_rounds; i++) {
+        telemetry_host_time_us += 100000;
+        test_text("texto de printf entre quadros\n");
+        telemetry_send(1, telemetry_host_time_us, extremes, extreme_count);
+        telemetry_send(2, telemetry_host_time_us, wide, test_max_values);
+        telemetry_send(3, telemetry_host_time_us, extremes, 1); // Tipo recusado: nada enviado
+        sent += 2;
+    }
+
+    // Quadros recebidos: os registros voltam iguais, com o instante do envio
+    size_t pos = 0;
+    test_frame_t frame;
+    unsigned framing_errors = 0, crc_errors = 0, records = 0, value_errors = 0, descriptors = 0, unexpected = 0;
+    uint32_t last_time = 0;
+    int32_t values[test_max_values];
+    bool have_time = false;
+
+    while (next_frame(&pos, &frame, &framing_errors, &crc_errors)) {
+        if (frame.type == telemetry_descriptor) {
+            descriptors++;
+            unexpected += frame.length < 1 || (frame.payload[0] != 1 && frame.payload[0] != 2);
+            continue;
+        }
+
+        int count = get_values(&frame, values);
+        if (frame.type == 1) {
+            value_errors += count != extreme_count || memcmp(values, extremes, sizeof(extremes)) != 0;
+        }
+        else if (frame.type == 2) {
+            value_errors += count != test_max_values || memcmp(values, wide, sizeof(wide)) != 0;
+        }
+        else {
+            unexpected++;
+        }
+        // Instantes crescentes, com a volta do contador de 32 bits
+        value_errors += have_time && (uint32_t)(frame.time_us - last_time) > 100000;
+        have_time = true;
+        last_time = frame.time_us;
+        records++;
+    }
+
+    // 2 na definição e 2 por reenvio: o primeiro logo no primeiro registro, depois a cada intervalo
+    unsigned expected_descriptors = 2 + 2 * (1 + ((test_rounds - 1) * 100000) / telemetry_describe_interval_us);
+    printf("ida e volta: %u registros de %d, %u com valores ou instante errados, %u erros de CRC, %u trechos "
+           "de texto (esperados %d), %u descricoes (esperadas %u), %u quadros inesperados, fluxo de %u bytes\n",
+           records, sent, value_errors, crc_errors, framing_errors, test_rounds, descriptors, expected_descriptors,
+           unexpected, (unsigned)test_stream_length);
+    printf("descricao com campos demais %s\n", refused ? "recusada" : "ACEITA");
+    ok = ok && defined && refused && records == (unsigned)sent && value_errors == 0 && crc_errors == 0 &&
+         framing_errors == test_rounds && descriptors == expected_descriptors && unexpected == 0 &&
+         test_stream_length < test_stream_size;
+
+    if (output) {
+        FILE *file = fopen(output, "wb");
+
+        if (!file || fwrite(test_stream, 1, test_stream_length, file) != test_stream_length) {
+            fprintf(stderr, "erro ao gravar %s\n", output);
+            ok = false;
+        }
+        if (file) {
+            fclose(file);
+        }
+    }
+
+    printf("%s\n", ok ? "OK" : "FALHOU");
+
+    return ok ? 0 : 1;
+}
@@ -0,0 +1,20 @@
+#include "temperature_lut.h"
+
+int32_t temperature_centi_lut[temperature_adc_codes];
+
+static int32_t temperature_round_q16(int64_t value_q16) {
+    return (int32_t)(value_q16 >= 0 ? (value_q16 + 32768) >> 16 : -((-value_q16 + 32768) >> 16));
+}
+
+void temperature_lut_build(int64_t offset_q16, int64_t slope_q16) {
+    int64_t value_q16 = offset_q16;
+
+    for (int code = 0; code < temperature_adc_codes; code++) {
+        temperature_centi_lut[code] = temperature_round_q16(value_q16);
+        value_q16 += slope_q16;
+    }
+}
+
+void temperature_lut_build_default(void) {
+    temperature_lut_build(temperature_default_offset_q16, temperature_default_slope_q16);
+}
@@ -0,0 +1,52 @@
+#include <stdint.h>
+
+#ifndef temperature_lut_inc_h
+#define temperature_lut_inc_h
+
+// Conversão do código do ADC (12 bits) do sensor interno para centésimos de grau Celsius, sem ponto flutuante.
+// A tabela fica em RAM e é montada na partida a partir de uma reta (o sensor é linear no código):
+// a do datasheet do RP2040, T = 27 - (V - 0,706) / 0,001721 com V = código * 3,3 / 4096,
+// ou a da calibração de dois pontos gravada no flash (calibration/calibration.h).
+// Os extremos da faixa do ADC dão de +437 °C a -1480 °C, por isso as entradas têm 32 bits
+
+#define temperature_adc_bits 12
+#define temperature_adc_codes (1 << temperature_adc_bits)
+
+// Temperatura (em °C * 100) do código c pela fórmula do datasheet
+#define temperature_centi_exact(c) (2700.0 - ((c) * 3.3 / temperature_adc_codes - 0.706) / 0.001721 * 100.0)
+
+// Reta do datasheet em Q16 (calculada pelo compilador): temperatura no código 0 e variação por código
+#define temperature_default_offset_q16 ((int64_t)(temperature_centi_exact(0) * 65536.0 + 0.5))
+#define temperature_default_slope_q16 \
+    ((int64_t)((temperature_centi_exact(0) - temperature_centi_exact(temperature_adc_codes)) / temperature_adc_codes * -65536.0 - 0.5))
+
+extern int32_t temperature_centi_lut[temperature_adc_codes];
+
+// Monta a tabela: entrada c = (offset_q16 + slope_q16 * c) / 65536, arredondada
+extern void temperature_lut_build(int64_t offset_q16, int64_t slope_q16);
+extern void temperature_lut_build_default(void);
+
+// Temperatura em centésimos de grau para um código do ADC
+static inline int32_t temperature_centi_from_adc(uint16_t adc_value) {
+    return temperature_centi_lut[adc_value & (temperature_adc_codes - 1)];
+}
+
+// Temperatura em centésimos de grau para um código com 8 bits de fração (saída do decimador),
+// interpolando linearmente entre duas entradas da tabela
+static inline int32_t temperature_centi_from_adc_q8(uint32_t code_q8) {
+    uint32_t index = code_q8 >> 8;
+    int32_t fraction = code_q8 & 0xFF;
+
+    if (index >= temperature_adc_codes - 1) {
+        return temperature_centi_lut[temperature_adc_codes - 1];
+    }
+
+    int32_t low = temperature_centi_lut[index];
+    int32_t high = temperature_centi_lut[index + 1];
+
+    int32_t delta = (high - low) * fraction; // A tabela é decrescente: delta costuma ser negativo
+
+    return low + (delta >= 0 ? delta + 128 : delta - 128) / 256;
+}
+
+#endif
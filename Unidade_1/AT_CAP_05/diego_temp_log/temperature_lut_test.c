@@ -0,0 +1,146 @@
+// Confere e mede a tabela de conversão do sensor de temperatura (temperature_lut.c) no computador.
+// Conferência exaustiva: os 4096 códigos do ADC, pela tabela montada com a reta do datasheet, contra a
+// fórmula em ponto flutuante (temperature_centi_exact), e os códigos com fração (Q8, saída do decimador)
+// interpolados, em todos os 4096 * 256 valores. Falha (código de saída 1) se algum erro passar do limite.
+// Medida: tempo por conversão pela tabela, pela interpolação e pela fórmula em ponto flutuante
+// (a fórmula usada antes da tabela, em float), em ns. O computador tem unidade de ponto flutuante; no RP2040,
+// que não tem, a fórmula em float é emulada em software e a vantagem da tabela é bem maior.
+//
+// Compilação: gcc -std=c11 -O2 -o temperature_lut_test temperature_lut_test.c temperature_lut.c -lm
+// Uso:        temperature_lut_test [-i repeticoes]
+
+#define _POSIX_C_SOURCE 199309L
+#include <stdio.h>
+#include <stdbool.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include <time.h>
+#include "temperature_lut.h"
+
+// Limites: arredondamento de cada entrada (0,5) mais o da inclinação em Q16 somado pelos 4096 códigos;
+// na interpolação, o erro das entradas mais o arredondamento do resultado (0,5)
+#define lut_max_error_centi (0.5 + temperature_adc_codes * 0.5 / 65536)
+#define lut_max_q8_error_centi (lut_max_error_centi + 0.5)
+
+static double now_seconds(void) {
+    struct timespec time;
+
+    clock_gettime(CLOCK_MONOTONIC, &time);
+    return time.tv_sec + time.tv_nsec * 1e-9;
+}
+
+// Fórmula do datasheet em float, como a conversão era feita na placa antes da tabela
+static float temperature_float(uint16_t code) {
+    float voltage = code * 3.3f / temperature_adc_codes;
+
+    return 27.0f - (voltage - 0.706f) / 0.001721f;
+}
+
+int main(int argc, char **argv) {
+    uint32_t iterations = 200;
+    bool ok = true;
+
+    if (argc == 3 && !strcmp(argv[1], "-i")) {
+        iterations = (uint32_t)strtoul(argv[2], NULL, 10);
+    }
+    else if (argc != 1) {
+        fprintf(stderr, "uso: %s [-i repeticoes]\n", argv[0]);
+        return 2;
+    }
+
+    temperature_lut_build_default();
+
+    // Todos os códigos inteiros
+    double worst = 0;
+    int worst_code = 0;
+
+    for (int code = 0; code < temperature_adc_codes; code++) {
+        double error = fabs(temperature_centi_from_adc((uint16_t)code) - temperature_centi_exact(code));
+
+        if (error > worst) {
+            worst = error;
+            worst_code = code;
+        }
+    }
+    printf("tabela: erro max %.4f centesimos (codigo %d: %d, formula %.3f)\n", worst, worst_code,
+           temperature_centi_from_adc((uint16_t)worst_code), temperature_centi_exact(worst_code));
+    ok = ok && worst <= lut_max_error_centi;
+
+    // Todos os códigos com fração até o último código inteiro (acima dele a tabela satura)
+    double worst_q8 = 0;
+    uint32_t worst_q8_code = 0;
+
+    for (uint32_t code_q8 = 0; code_q8 <= (temperature_adc_codes - 1) << 8; code_q8++) {
+        double error = fabs(temperature_centi_from_adc_q8(code_q8) - temperature_centi_exact(code_q8 / 256.0));
+
+        if (error > worst_q8) {
+            worst_q8 = error;
+            worst_q8_code = code_q8;
+        }
+    }
+    printf("interpolacao Q8: erro max %.4f centesimos (codigo %.4f)\n", worst_q8, worst_q8_code / 256.0);
+    ok = ok && worst_q8 <= lut_max_q8_error_centi;
+
+    // Faixa útil do sensor (-40 a 85 °C): a tabela concorda com a fórmula em float a menos de 0,01 °C
+    double worst_float = 0;
+
+    for (int code = 0; code < temperature_adc_codes; code++) {
+        double exact = temperature_centi_exact(code);
+
+        if (exact >= -4000 && exact <= 8500) {
+            double error = fabs(temperature_centi_from_adc((uint16_t)code) - 100.0 * temperature_float((uint16_t)code));
+
+            worst_float = error > worst_float ? error : worst_float;
+        }
+    }
+    printf("tabela contra a formula em float (-40 a 85 C): diferenca max %.4f centesimos\n", worst_float);
+    ok = ok && worst_float <= 1.0;
+
+    // Medida: cada repetição converte os 4096 códigos
+    volatile int32_t sink = 0;
+    double start = now_seconds();
+    for (uint32_t i = 0; i < iterations; i++) {
+        int32_t sum = 0;
+
+        for (int code = 0; code < temperature_adc_codes; code++) {
+            sum += temperature_centi_from_adc((uint16_t)(code ^ i));
+        }
+        sink += sum;
+    }
+    double lut_ns = (now_seconds() - start) * 1e9 / ((double)iterations * temperature_adc_codes);
+
+    start = now_seconds();
+    for (uint32_t i = 0; i < iterations; i++) {
+        int32_t sum = 0;
+
+        for (uint32_t code = 0; code < temperature_adc_codes; code++) {
+            sum += temperature_centi_from_adc_q8((code << 8) | (i & 0xFF));
+        }
+        sink += sum;
+    }
+    double q8_ns = (now_seconds() - start) * 1e9 / ((double)iterations * temperature_adc_codes);
+
+    start = now_seconds();
+    for (uint32_t i = 0; i < iterations; i++) {
+        float sum = 0;
+
+        for (int code = 0; code < temperature_adc_codes; code++) {
+            sum += temperature_float((uint16_t)(code ^ i));
+        }
+        sink += (int32_t)sum;
+    }
+    double float_ns = (now_seconds() - start) * 1e9 / ((double)iterations * temperature_adc_codes);
+
+    start = now_seconds();
+    for (uint32_t i = 0; i < iterations; i++) {
+        temperature_lut_build_default();
+    }
+    double build_us = (now_seconds() - start) * 1e6 / iterations;
+
+    printf("por conversao: tabela %.2f ns, interpolacao Q8 %.2f ns, formula em float %.2f ns; montagem da tabela %.1f us\n",
+           lut_ns, q8_ns, float_ns, build_us);
+    printf("%s (%d)\n", ok ? "OK" : "FALHOU", (int)(sink & 1));
+
+    return ok ? 0 : 1;
+}
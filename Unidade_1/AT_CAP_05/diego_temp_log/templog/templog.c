@@ -0,0 +1,441 @@
+#include <string.h>
+#include <assert.h>
+#include "templog.h"
+
+// Varint sem sinal (7 bits por byte, o bit 7 indica continuação); retorna o número de bytes
+static uint8_t templog_put_varint(uint8_t *out, uint32_t value) {
+    uint8_t n = 0;
+
+    while (value >= 0x80) {
+        out[n++] = (uint8_t)(value | 0x80);
+        value >>= 7;
+    }
+    out[n++] = (uint8_t)value;
+
+    return n;
+}
+
+// Lê um varint de até 5 bytes sem passar de end; false se estiver truncado ou inválido
+static bool templog_get_varint(const uint8_t *data, uint32_t *pos, uint32_t end, uint32_t *value) {
+    uint32_t result = 0;
+
+    for (int shift = 0; shift < 35 && *pos < end; shift += 7) {
+        uint8_t byte = data[(*pos)++];
+
+        result |= (uint32_t)(byte & 0x7F) << shift;
+        if (!(byte & 0x80)) {
+            *value = result;
+            return true;
+        }
+    }
+
+    return false;
+}
+
+// Zigzag: valores pequenos com ou sem sinal viram varints curtos (0, -1, 1, -2... -> 0, 1, 2, 3...)
+static uint32_t templog_zigzag(int32_t value) {
+    return ((uint32_t)value << 1) ^ (uint32_t)(value >> 31);
+}
+
+static int32_t templog_unzigzag(uint32_t value) {
+    return (int32_t)(value >> 1) ^ -(int32_t)(value & 1);
+}
+
+// Enfileira um registro para templog_service(), guardando o estado do decodificador antes dele
+static void templog_queue(templog_t *log, const uint8_t *bytes, uint8_t length, uint32_t base_ms, int32_t base_level) {
+    if (log->pending_count == templog_pending) {
+        log->dropped++;
+        return;
+    }
+
+    templog_record_t *record = &log->pending[(log->pending_head + log->pending_count) % templog_pending];
+
+    memcpy(record->bytes, bytes, length);
+    record->length = length;
+    record->base_ms = base_ms;
+    record->base_level = base_level;
+    log->pending_count++;
+    log->records++;
+}
+
+static void templog_queue_tagged(templog_t *log, templog_tag_t tag, uint32_t payload, uint32_t base_ms, int32_t base_level) {
+    uint8_t bytes[5];
+
+    templog_queue(log, bytes, templog_put_varint(bytes, (payload << 2) | tag), base_ms, base_level);
+}
+
+// Registro de ressincronização: tempo e valor absolutos (é_leitura indica se ele mesmo é uma leitura)
+static uint8_t templog_encode_resync(uint8_t *out, uint16_t boot, bool reading, uint32_t time_ms, int32_t level) {
+    uint8_t n = 0;
+
+    n += templog_put_varint(out + n, templog_resync);
+    n += templog_put_varint(out + n, ((uint32_t)boot << 1) | reading);
+    n += templog_put_varint(out + n, time_ms);
+    n += templog_put_varint(out + n, templog_zigzag(level));
+
+    return n;
+}
+
+// Fecha a sequência de leituras repetidas em aberto
+static void templog_close_run(templog_t *log) {
+    if (log->run) {
+        templog_queue_tagged(log, templog_run, log->run, log->last_ms - log->run * log->period_ms, log->level);
+        log->run = 0;
+    }
+}
+
+// Nível (em quanta) com histerese: só muda quando a leitura se afasta mais de 3/4 de quantum do valor gravado
+static int32_t templog_level_of(const templog_t *log, int32_t centi) {
+    int32_t diff = centi - log->level * templog_quantum_centi;
+
+    if (log->started && diff <= templog_quantum_centi * 3 / 4 && diff >= -templog_quantum_centi * 3 / 4) {
+        return log->level;
+    }
+
+    return (centi >= 0 ? centi + templog_quantum_centi / 2 : centi - templog_quantum_centi / 2) / templog_quantum_centi;
+}
+
+// Acrescenta uma leitura. Só codifica em RAM: nunca acessa o flash
+void templog_append(templog_t *log, uint32_t time_ms, int32_t centi) {
+    int32_t level = templog_level_of(log, centi);
+    int32_t late = (int32_t)(time_ms - (log->last_ms + log->period_ms));
+    int32_t half = log->period_ms / 2;
+
+    log->readings++;
+
+    // Primeira leitura da partida ou relógio adiantado: tempo e valor absolutos
+    if (!log->started || late < -half) {
+        uint8_t bytes[templog_max_record];
+
+        templog_close_run(log);
+        templog_queue(log, bytes, templog_encode_resync(bytes, log->boot, true, time_ms, level), log->last_ms, log->level);
+        log->started = true;
+        log->last_ms = time_ms;
+        log->level = level;
+        return;
+    }
+
+    // Leituras perdidas: o tempo avança os períodos que faltaram
+    if (late >= half) {
+        uint32_t missed = ((uint32_t)late + half) / log->period_ms;
+
+        templog_close_run(log);
+        templog_queue_tagged(log, templog_gap, missed, log->last_ms, log->level);
+        log->last_ms += missed * log->period_ms;
+    }
+
+    if (level != log->level) {
+        templog_close_run(log);
+        templog_queue_tagged(log, templog_delta, templog_zigzag(level - log->level), log->last_ms, log->level);
+        log->level = level;
+        log->last_ms += log->period_ms;
+    }
+    else {
+        log->last_ms += log->period_ms;
+        if (++log->run == templog_max_run) {
+            templog_close_run(log);
+        }
+    }
+}
+
+// Setor inteiramente apagado (pronto para receber dados)?
+static bool templog_sector_erased(const templog_t *log, int sector) {
+    const uint32_t *words = (const uint32_t *)(log->flash + sector * templog_sector_size);
+
+    for (int i = 0; i < templog_sector_size / 4; i++) {
+        if (words[i] != 0xFFFFFFFFu) {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+static int templog_next_sector(int sector) {
+    return (sector + 1) % templog_sectors;
+}
+
+// Grava a página atual (bytes ainda não usados ficam em 0xFF e não alteram o flash).
+// Retorna false se a gravação falhou: a página continua suja e é gravada de novo na próxima chamada
+static bool templog_program_page(templog_t *log) {
+    uint32_t page_offset = (log->fill - 1) / templog_page_size * templog_page_size;
+
+    if (!templog_flash_program(log->sector * templog_sector_size + page_offset, log->page)) {
+        log->failures++;
+        return false;
+    }
+    log->page_dirty = false;
+    log->programs++;
+
+    // Página completa: a próxima começa apagada
+    if (log->fill % templog_page_size == 0) {
+        memset(log->page, 0xFF, templog_page_size);
+    }
+
+    return true;
+}
+
+static void templog_write(templog_t *log, const uint8_t *bytes, uint32_t length) {
+    memcpy(&log->page[log->fill % templog_page_size], bytes, length);
+    log->fill += length;
+    log->bytes_written += length;
+    log->page_dirty = true;
+}
+
+// Abre o próximo setor (já apagado): cabeçalho e o estado de partida do decodificador
+static void templog_open_sector(templog_t *log, const templog_record_t *first) {
+    templog_header_t header = {
+        .magic = templog_magic,
+        .sequence = ++log->sequence,
+        .period_ms = log->period_ms,
+        .quantum = templog_quantum_centi
+    };
+    uint8_t bytes[templog_max_record];
+
+    log->sector = templog_next_sector(log->sector);
+    log->fill = 0;
+    memset(log->page, 0xFF, templog_page_size);
+    templog_write(log, (const uint8_t *)&header, sizeof(header));
+    templog_write(log, bytes, templog_encode_resync(bytes, log->boot, false, first->base_ms, first->base_level));
+
+    log->next_erased = templog_sector_erased(log, templog_next_sector(log->sector));
+}
+
+// Passo de manutenção, para o laço principal: move os registros pendentes para a página em RAM
+// e faz no máximo uma operação de flash. Retorna true se fez alguma (chamar de novo para continuar);
+// false também se a operação falhou (tentada de novo na próxima chamada)
+bool templog_service(templog_t *log) {
+    // Apagamento antecipado: o setor seguinte fica pronto antes de ser necessário
+    if (!log->next_erased) {
+        if (!templog_flash_erase(templog_next_sector(log->sector) * templog_sector_size)) {
+            log->failures++;
+            return false;
+        }
+        log->next_erased = true;
+        log->erases++;
+        return true;
+    }
+
+    // Página completa cuja gravação falhou: grava antes de escrever mais nada nela
+    if (log->page_dirty && log->fill % templog_page_size == 0) {
+        return templog_program_page(log);
+    }
+
+    while (log->pending_count) {
+        const templog_record_t *record = &log->pending[log->pending_head];
+        uint32_t page_left = templog_page_size - log->fill % templog_page_size;
+
+        // Setor cheio: grava o que falta e passa para o seguinte
+        if (log->fill + record->length > templog_sector_size) {
+            if (log->page_dirty) {
+                return templog_program_page(log);
+            }
+            templog_open_sector(log, record);
+            continue;
+        }
+
+        // Um registro nunca atravessa páginas: o resto da página é preenchido com 0x00 (sequência vazia)
+        if (record->length > page_left) {
+            uint8_t padding[templog_max_record] = { 0 };
+
+            templog_write(log, padding, page_left);
+            return templog_program_page(log);
+        }
+
+        templog_write(log, record->bytes, record->length);
+        log->pending_head = (log->pending_head + 1) % templog_pending;
+        log->pending_count--;
+
+        if (log->fill % templog_page_size == 0) {
+            return templog_program_page(log);
+        }
+    }
+
+    if (log->page_dirty) {
+        return templog_program_page(log);
+    }
+
+    return false;
+}
+
+// Fecha a sequência aberta e grava tudo o que está pendente (pode apagar um setor); para numa falha do
+// flash, deixando o resto para as próximas chamadas de templog_service()
+void templog_flush(templog_t *log) {
+    templog_close_run(log);
+    while (templog_service(log)) {
+    }
+}
+
+// Setor com cabeçalho válido?
+static bool templog_sector_valid(const uint8_t *flash, int sector, templog_header_t *header) {
+    memcpy(header, flash + sector * templog_sector_size, sizeof(*header));
+
+    return header->magic == templog_magic && header->period_ms > 0 && header->quantum > 0;
+}
+
+// Decodifica um setor chamando callback para cada leitura; retorna a posição do fim dos dados.
+// Um registro inválido encerra o setor (retorna o tamanho do setor: nada mais é gravado nele)
+static uint32_t templog_decode_sector(const uint8_t *data, const templog_header_t *header, uint16_t *boot,
+                                      templog_reading_callback_t callback, void *user_data) {
+    uint32_t pos = sizeof(*header);
+    uint32_t time_ms = 0;
+    int32_t level = 0;
+
+    while (pos < templog_sector_size && data[pos] != 0xFF) {
+        uint32_t first;
+
+        if (!templog_get_varint(data, &pos, templog_sector_size, &first)) {
+            return templog_sector_size;
+        }
+
+        uint32_t payload = first >> 2;
+
+        switch (first & 3) {
+        case templog_run:
+            for (uint32_t i = 0; i < payload; i++) {
+                time_ms += header->period_ms;
+                if (callback) {
+                    callback(*boot, time_ms, level * header->quantum, user_data);
+                }
+            }
+            break;
+        case templog_delta:
+            time_ms += header->period_ms;
+            level += templog_unzigzag(payload);
+            if (callback) {
+                callback(*boot, time_ms, level * header->quantum, user_data);
+            }
+            break;
+        case templog_gap:
+            time_ms += payload * header->period_ms;
+            break;
+        default: {
+            uint32_t flags, zigzag;
+
+            if (!templog_get_varint(data, &pos, templog_sector_size, &flags) ||
+                !templog_get_varint(data, &pos, templog_sector_size, &time_ms) ||
+                !templog_get_varint(data, &pos, templog_sector_size, &zigzag)) {
+                return templog_sector_size;
+            }
+            *boot = (uint16_t)(flags >> 1);
+            level = templog_unzigzag(zigzag);
+            if ((flags & 1) && callback) {
+                callback(*boot, time_ms, level * header->quantum, user_data);
+            }
+            break;
+        }
+        }
+    }
+
+    return pos;
+}
+
+// Setores válidos do mais antigo ao mais novo; retorna quantos são
+int templog_sector_order(const uint8_t *flash, int *order) {
+    uint32_t sequence[templog_sectors];
+    templog_header_t header;
+    int count = 0;
+
+    for (int sector = 0; sector < templog_sectors; sector++) {
+        if (!templog_sector_valid(flash, sector, &header)) {
+            continue;
+        }
+
+        // Ordenação por inserção pela sequência
+        int i = count++;
+
+        while (i > 0 && sequence[i - 1] > header.sequence) {
+            sequence[i] = sequence[i - 1];
+            order[i] = order[i - 1];
+            i--;
+        }
+        sequence[i] = header.sequence;
+        order[i] = sector;
+    }
+
+    return count;
+}
+
+// Contagem das leituras decodificadas, repassando cada uma ao callback do usuário
+typedef struct {
+    templog_reading_callback_t callback;
+    void *user_data;
+    uint32_t count;
+} templog_counter_t;
+
+static void templog_count_reading(uint16_t boot, uint32_t time_ms, int32_t centi, void *user_data) {
+    templog_counter_t *counter = user_data;
+
+    counter->count++;
+    if (counter->callback) {
+        counter->callback(boot, time_ms, centi, counter->user_data);
+    }
+}
+
+// Percorre todas as leituras gravadas, da mais antiga à mais nova; retorna quantas foram
+uint32_t templog_for_each(const uint8_t *flash, templog_reading_callback_t callback, void *user_data) {
+    templog_counter_t counter = { callback, user_data, 0 };
+    int order[templog_sectors];
+    int count = templog_sector_order(flash, order);
+    templog_header_t header;
+    uint16_t boot = 0;
+
+    for (int i = 0; i < count; i++) {
+        templog_sector_valid(flash, order[i], &header);
+        templog_decode_sector(flash + order[i] * templog_sector_size, &header, &boot, templog_count_reading, &counter);
+    }
+
+    return counter.count;
+}
+
+// Bytes ocupados pelo registro (setores anteriores inteiros mais o atual até a posição de escrita)
+uint32_t templog_used_bytes(const templog_t *log) {
+    int order[templog_sectors];
+    int count = templog_sector_order(log->flash, order);
+
+    return count ? (count - 1) * templog_sector_size + log->fill : 0;
+}
+
+// Retoma o registro existente no flash (ou começa um vazio) para uma nova partida
+void templog_init(templog_t *log, uint16_t period_ms) {
+    int order[templog_sectors];
+    templog_header_t header;
+
+    assert(period_ms > 0);
+    static_assert(sizeof(templog_header_t) == 12, "cabeçalho do setor");
+
+    memset(log, 0, sizeof(*log));
+    log->flash = templog_flash_base();
+    log->period_ms = period_ms;
+    memset(log->page, 0xFF, templog_page_size);
+
+    // Sem setor aberto: o primeiro registro abre o setor 0
+    log->sector = templog_sectors - 1;
+    log->fill = templog_sector_size;
+
+    int count = templog_sector_order(log->flash, order);
+
+    if (count) {
+        int newest = order[count - 1];
+        uint16_t boot = 0;
+
+        templog_sector_valid(log->flash, newest, &header);
+        log->sector = newest;
+        log->sequence = header.sequence;
+        log->fill = templog_decode_sector(log->flash + newest * templog_sector_size, &header, &boot, NULL, NULL);
+        log->boot = boot + 1;
+
+        // Setor gravado com outro período ou resolução: continua no seguinte
+        if (header.period_ms != period_ms || header.quantum != templog_quantum_centi) {
+            log->fill = templog_sector_size;
+        }
+
+        // Página parcial: a cópia em RAM parte do conteúdo já gravado
+        if (log->fill < templog_sector_size && log->fill % templog_page_size) {
+            memcpy(log->page, log->flash + newest * templog_sector_size + log->fill / templog_page_size * templog_page_size,
+                   templog_page_size);
+        }
+    }
+
+    log->next_erased = templog_sector_erased(log, templog_next_sector(log->sector));
+}
@@ -0,0 +1,98 @@
+#include <stdint.h>
+#include <stdbool.h>
+
+#ifndef templog_inc_h
+#define templog_inc_h
+
+// Registro circular de temperatura numa região reservada do flash.
+// A região é dividida em setores de apagamento (4 KB) usados em rodízio (todos são apagados igualmente).
+// Cada setor tem um cabeçalho e registros varint com deltas:
+//   primeiro varint = (payload << 2) | tipo
+//   templog_run:    payload leituras repetidas (mesmo valor, uma a cada período)
+//   templog_delta:  uma leitura com o valor anterior + zigzag(payload) quanta
+//   templog_gap:    o tempo avança payload períodos sem leituras (leituras perdidas)
+//   templog_resync: payload 0, seguido de varints boot << 1 | é_leitura, tempo em ms e zigzag(valor) absolutos
+// Nenhum registro começa com 0xFF, que marca o fim dos dados (flash apagado).
+// templog_append() só codifica em RAM; templog_service() faz no máximo uma operação de flash por chamada
+// (programar uma página ou apagar um setor), apagando o próximo setor com antecedência; uma operação que
+// falha não muda o estado e é repetida na chamada seguinte
+
+#define templog_sector_size 4096
+#define templog_page_size 256
+#define templog_region_size (128 * 1024) // Região reservada no fim do flash
+#define templog_sectors (templog_region_size / templog_sector_size)
+#define templog_magic 0x474F4C54u        // "TLOG"
+
+#define templog_quantum_centi 10 // Resolução gravada: 0,1 °C
+#define templog_max_run 120      // Uma sequência sem mudança é fechada a cada minuto (a 2 Hz), limitando a perda
+#define templog_max_record 16
+#define templog_pending 16       // Registros aguardando templog_service()
+
+typedef enum {
+    templog_run,
+    templog_delta,
+    templog_gap,
+    templog_resync
+} templog_tag_t;
+
+typedef struct {
+    uint32_t magic;
+    uint32_t sequence;  // Ordem de uso dos setores (o maior é o mais novo)
+    uint16_t period_ms; // Intervalo nominal entre leituras
+    uint16_t quantum;   // Resolução dos valores, em centésimos de grau
+} templog_header_t;
+
+// Registro codificado e o estado do codificador antes dele (para reabrir a base em um novo setor)
+typedef struct {
+    uint8_t length;
+    uint8_t bytes[templog_max_record];
+    uint32_t base_ms;
+    int32_t base_level;
+} templog_record_t;
+
+typedef struct {
+    const uint8_t *flash; // Região mapeada em memória
+    uint16_t period_ms;
+    uint16_t boot;
+
+    // Setor em escrita: página atual espelhada em RAM e posição de escrita
+    int sector;
+    uint32_t sequence;
+    uint32_t fill;
+    uint8_t page[templog_page_size];
+    bool page_dirty;
+    bool sector_open;
+    bool next_erased;
+
+    // Codificador: último valor (em quanta), tempo da última leitura e sequência aberta
+    bool started;
+    int32_t level;
+    uint32_t last_ms;
+    uint32_t run;
+
+    templog_record_t pending[templog_pending];
+    int pending_head, pending_count;
+
+    // Estatísticas
+    uint32_t readings, records, bytes_written, erases, programs, dropped;
+    uint32_t failures; // Operações de flash que não foram feitas (repetidas na chamada seguinte)
+} templog_t;
+
+// Leitura decodificada (tempo em ms desde a partida indicada por boot)
+typedef void (*templog_reading_callback_t)(uint16_t boot, uint32_t time_ms, int32_t centi, void *user_data);
+
+extern void templog_init(templog_t *log, uint16_t period_ms);
+extern void templog_append(templog_t *log, uint32_t time_ms, int32_t centi);
+extern void templog_flush(templog_t *log);
+extern bool templog_service(templog_t *log);
+extern uint32_t templog_for_each(const uint8_t *flash, templog_reading_callback_t callback, void *user_data);
+extern int templog_sector_order(const uint8_t *flash, int *order);
+extern uint32_t templog_used_bytes(const templog_t *log);
+
+// Acesso ao flash, fornecido por templog_flash.c (RP2040) ou templog_host.c (arquivo de imagem no computador)
+extern const uint8_t *templog_flash_base(void);
+// Apagar e programar retornam false se a operação não foi feita (o registro tenta de novo depois)
+extern bool templog_flash_erase(uint32_t offset);
+extern bool templog_flash_program(uint32_t offset, const uint8_t *page);
+
+#endif
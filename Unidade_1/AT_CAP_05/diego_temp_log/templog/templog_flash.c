@@ -0,0 +1,53 @@
+#include <assert.h>
+#include "pico/stdlib.h"
+#include "pico/flash.h"
+#include "hardware/flash.h"
+#include "templog.h"
+
+// Acesso ao flash do RP2040: a região do registro ocupa os últimos setores, longe do programa
+
+#define templog_flash_offset (PICO_FLASH_SIZE_BYTES - templog_region_size)
+#define templog_flash_timeout_ms 1000 // Espera máxima pelo outro núcleo
+
+static_assert(templog_sector_size == FLASH_SECTOR_SIZE, "setor de apagamento do flash");
+static_assert(templog_page_size == FLASH_PAGE_SIZE, "página de programação do flash");
+
+typedef struct {
+    uint32_t offset;
+    const uint8_t *page; // NULL: apagar o setor
+} templog_flash_op_t;
+
+// Executada com o XIP indisponível: interrupções desligadas e o outro núcleo executando só da RAM
+static void templog_flash_run(void *param) {
+    const templog_flash_op_t *op = param;
+
+    if (op->page) {
+        flash_range_program(templog_flash_offset + op->offset, op->page, templog_page_size);
+    }
+    else {
+        flash_range_erase(templog_flash_offset + op->offset, templog_sector_size);
+    }
+}
+
+// O outro núcleo é afastado do flash pelo ajudante do aplicativo (get_flash_safety_helper()).
+// Sem o outro núcleo liberado a tempo nada é feito e o resultado é false: quem chamou tenta de novo
+static bool templog_flash_execute(templog_flash_op_t *op) {
+    return flash_safe_execute(templog_flash_run, op, templog_flash_timeout_ms) == PICO_OK;
+}
+
+// A região pode ser lida diretamente pelo XIP
+const uint8_t *templog_flash_base(void) {
+    return (const uint8_t *)(XIP_BASE + templog_flash_offset);
+}
+
+bool templog_flash_erase(uint32_t offset) {
+    templog_flash_op_t op = { offset, NULL };
+
+    return templog_flash_execute(&op);
+}
+
+bool templog_flash_program(uint32_t offset, const uint8_t *page) {
+    templog_flash_op_t op = { offset, page };
+
+    return templog_flash_execute(&op);
+}
@@ -0,0 +1,104 @@
+#include <stdio.h>
+#include <string.h>
+#include "templog_host.h"
+
+static uint8_t templog_host_image[templog_region_size];
+static bool templog_host_ready;
+static uint32_t templog_host_erase_count, templog_host_program_count;
+static uint32_t templog_host_fail_count; // Próximas operações que falham
+
+static void templog_host_erase_all(void) {
+    memset(templog_host_image, 0xFF, sizeof(templog_host_image));
+    templog_host_ready = true;
+}
+
+bool templog_host_load(const char *path) {
+    FILE *file = fopen(path, "rb");
+
+    templog_host_erase_all();
+    if (!file) {
+        return true;
+    }
+
+    size_t length = fread(templog_host_image, 1, sizeof(templog_host_image), file);
+    bool extra = fgetc(file) != EOF;
+
+    fclose(file);
+    if (length != sizeof(templog_host_image) || extra) {
+        templog_host_erase_all();
+        return false;
+    }
+
+    return true;
+}
+
+bool templog_host_save(const char *path) {
+    FILE *file = fopen(path, "wb");
+
+    if (!file) {
+        return false;
+    }
+
+    size_t length = fwrite(templog_host_image, 1, sizeof(templog_host_image), file);
+
+    return fclose(file) == 0 && length == sizeof(templog_host_image);
+}
+
+void templog_host_clear(void) {
+    templog_host_erase_all();
+    templog_host_erase_count = 0;
+    templog_host_program_count = 0;
+    templog_host_fail_count = 0;
+}
+
+uint32_t templog_host_erases(void) {
+    return templog_host_erase_count;
+}
+
+uint32_t templog_host_programs(void) {
+    return templog_host_program_count;
+}
+
+void templog_host_fail(uint32_t count) {
+    templog_host_fail_count = count;
+}
+
+// Falha simulada: a operação não muda a imagem
+static bool templog_host_failed(void) {
+    if (templog_host_fail_count) {
+        templog_host_fail_count--;
+        return true;
+    }
+
+    return false;
+}
+
+const uint8_t *templog_flash_base(void) {
+    if (!templog_host_ready) {
+        templog_host_erase_all();
+    }
+
+    return templog_host_image;
+}
+
+bool templog_flash_erase(uint32_t offset) {
+    if (templog_host_failed()) {
+        return false;
+    }
+    memset(templog_host_image + offset, 0xFF, templog_sector_size);
+    templog_host_erase_count++;
+
+    return true;
+}
+
+bool templog_flash_program(uint32_t offset, const uint8_t *page) {
+    if (templog_host_failed()) {
+        return false;
+    }
+    for (int i = 0; i < templog_page_size; i++) {
+        templog_host_image[offset + i] &= page[i];
+    }
+    templog_host_program_count++;
+
+    return true;
+}
@@ -0,0 +1,25 @@
+#include <stdint.h>
+#include "templog.h"
+
+#ifndef templog_host_inc_h
+#define templog_host_inc_h
+
+// Backend de computador para o registro: substitui templog_flash.c, com a região do flash em memória.
+// A imagem pode ser carregada de um arquivo (por exemplo, um despejo feito pela placa) e gravada de volta.
+// Programar só leva bits de 1 para 0, como no flash NOR
+
+// Carrega a imagem (ou começa apagada, se o arquivo não existir); retorna false se o arquivo tiver outro tamanho
+extern bool templog_host_load(const char *path);
+extern bool templog_host_save(const char *path);
+
+// Volta à região apagada, zerando as contagens de operações (novo caso sobre a mesma imagem)
+extern void templog_host_clear(void);
+
+// Operações feitas no flash simulado
+extern uint32_t templog_host_erases(void);
+extern uint32_t templog_host_programs(void);
+
+// As próximas count operações falham sem mudar a imagem (como um flash_safe_execute() sem sucesso)
+extern void templog_host_fail(uint32_t count);
+
+#endif
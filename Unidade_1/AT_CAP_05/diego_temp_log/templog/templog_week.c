@@ -0,0 +1,231 @@
+// Confere o registro no flash (templog.c) no computador, sobre a imagem simulada de templog_host.c.
+// Grava leituras a 2 Hz (ciclo diário, ruído abaixo da histerese e intervalos sem leituras como os de uma
+// gravação do flash), chamando templog_service() como o laço principal da placa, e confere:
+//   - templog_append() nunca acessa o flash (apagamentos e gravações só em templog_service());
+//   - operações de flash que falham (duas seguidas a cada week_fail_every leituras) são repetidas depois,
+//     sem perder nem corromper dados;
+//   - uma semana cabe na região: nenhum apagamento e todas as leituras voltam;
+//   - com mais dias do que cabem (week_wrap_days), os setores mais antigos são apagados e reusados em rodízio:
+//     a região fica cheia com sequências consecutivas, cada apagamento recicla o setor mais antigo e as
+//     leituras que sobram são as últimas gravadas;
+//   - as leituras que voltam têm os instantes exatos e valores a menos de 3/4 de quantum da entrada;
+//   - uma nova partida (templog_init sobre a mesma imagem) continua o registro com o número de partida seguinte.
+// Sem -d, roda os dois casos (7 e week_wrap_days dias); com -d, só o pedido.
+// Falha (código de saída 1) se alguma conferência não passar. A imagem final pode ser gravada em arquivo.
+//
+// Compilação: gcc -std=c11 -O2 -o templog_week templog_week.c templog.c templog_host.c -lm
+// Uso:        templog_week [-d dias] [-o imagem.bin]
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include "templog_host.h"
+
+#define week_period_ms 500     // 2 leituras por segundo, como na placa
+#define week_gap_every 7200    // Um intervalo sem leituras a cada hora
+#define week_gap_readings 3    // Leituras perdidas em cada intervalo
+#define week_fail_every 997    // Falhas simuladas do flash a cada tantas leituras
+#define week_wrap_days 30      // Passa da capacidade da região (~25 dias com este sinal)
+#define week_restart_readings 10
+#define week_pi 3.14159265358979323846
+
+typedef struct {
+    uint32_t first;    // Índice gravado da leitura mais antiga que sobrou
+    uint32_t count;    // Leituras da partida 0 decodificadas
+    uint32_t restarts; // Leituras da nova partida decodificadas
+    uint32_t time_errors, value_errors, boot_errors;
+} week_check_t;
+
+static uint32_t week_readings; // Leituras gravadas (o índice de cada uma dá instante e valor esperados)
+
+// Instante (ms) da leitura index: períodos regulares, pulando os intervalos perdidos
+static uint32_t week_time_ms(uint32_t index) {
+    return (index + index / week_gap_every * week_gap_readings) * week_period_ms;
+}
+
+// Temperatura (centésimos) no instante: 22 °C com ciclo diário de ±3 °C e ruído de ±4 centésimos
+static int32_t week_centi(uint32_t time_ms) {
+    double day = time_ms / 86400000.0;
+    uint32_t hash = time_ms * 2654435761u;
+
+    return (int32_t)lround(2200 + 300 * sin(2 * week_pi * day)) + (int32_t)(hash >> 29) - 4;
+}
+
+// Leituras da partida 0 são as gravadas a partir de first; as da partida 1, as da nova partida (2500 a cada período)
+static void week_check_reading(uint16_t boot, uint32_t time_ms, int32_t centi, void *user_data) {
+    week_check_t *check = user_data;
+
+    if (boot == 1) {
+        uint32_t index = check->restarts++;
+
+        if (time_ms != index * week_period_ms || centi != 2500) {
+            check->value_errors++;
+        }
+        return;
+    }
+    if (boot != 0 || check->restarts) {
+        check->boot_errors++;
+        return;
+    }
+
+    uint32_t index = check->first + check->count++;
+
+    if (index >= week_readings) {
+        return;
+    }
+    if (time_ms != week_time_ms(index)) {
+        if (check->time_errors++ < 5) {
+            printf("  leitura %u: instante %u ms, esperado %u ms\n", index, time_ms, week_time_ms(index));
+        }
+    }
+
+    int32_t error = centi - week_centi(week_time_ms(index));
+    if (error > templog_quantum_centi * 3 / 4 || error < -templog_quantum_centi * 3 / 4) {
+        if (check->value_errors++ < 5) {
+            printf("  leitura %u: %d centesimos, entrada %d\n", index, centi, week_centi(week_time_ms(index)));
+        }
+    }
+}
+
+// Decodifica a imagem: as leituras da partida 0 que sobraram devem ser as últimas gravadas (até week_readings),
+// seguidas de restarts leituras da nova partida
+static bool week_check_image(uint32_t restarts, uint32_t *decoded) {
+    week_check_t check = { 0 };
+    uint32_t total = templog_for_each(templog_flash_base(), NULL, NULL);
+
+    if (total < restarts || total - restarts > week_readings) {
+        return false;
+    }
+    check.first = week_readings - (total - restarts);
+    templog_for_each(templog_flash_base(), week_check_reading, &check);
+    *decoded = total - restarts;
+    printf("decodificadas: %u (gravadas %u a %u) e %u da nova partida; erros de instante %u, de valor %u, de partida %u\n",
+           check.count, check.first, week_readings - 1, check.restarts, check.time_errors, check.value_errors,
+           check.boot_errors);
+
+    return check.count == total - restarts && check.restarts == restarts && check.time_errors == 0 &&
+           check.value_errors == 0 && check.boot_errors == 0;
+}
+
+// Setores válidos: sequências consecutivas (nenhum setor no meio perdido); retorna a mais antiga e quantos são
+static bool week_check_sectors(uint32_t *oldest, int *count) {
+    int order[templog_sectors];
+    templog_header_t header;
+
+    *count = templog_sector_order(templog_flash_base(), order);
+    *oldest = 0;
+    for (int i = 0; i < *count; i++) {
+        memcpy(&header, templog_flash_base() + order[i] * templog_sector_size, sizeof(header));
+        if (i == 0) {
+            *oldest = header.sequence;
+        }
+        else if (header.sequence != *oldest + i) {
+            return false;
+        }
+    }
+
+    return *count > 0;
+}
+
+// Grava days dias numa região apagada e confere; wrap: a gravação deve passar da capacidade da região
+static bool week_run(uint32_t days, bool wrap, const char *output) {
+    static templog_t log;
+    uint32_t total = days * 86400u * (1000 / week_period_ms) / (week_gap_every + week_gap_readings) * week_gap_every;
+    uint32_t append_flash_ops = 0, injected = 0, decoded, oldest;
+    int sectors;
+    bool ok = true;
+
+    templog_host_clear();
+    templog_init(&log, week_period_ms);
+    for (week_readings = 0; week_readings < total; week_readings++) {
+        uint32_t time_ms = week_time_ms(week_readings);
+        uint32_t before = templog_host_erases() + templog_host_programs();
+
+        templog_append(&log, time_ms, week_centi(time_ms));
+        append_flash_ops += templog_host_erases() + templog_host_programs() - before;
+
+        // Falhas longe do fim: templog_flush() para na primeira e deixaria o resto sem gravar
+        if (week_readings % week_fail_every == week_fail_every - 1 && week_readings + week_fail_every < total) {
+            templog_host_fail(2);
+            injected += 2;
+        }
+
+        // Laço principal: uma operação de flash por volta, algumas voltas por leitura
+        for (int turn = 0; turn < 4 && templog_service(&log); turn++) {
+        }
+    }
+    templog_flush(&log);
+
+    printf("%u dias a %u ms: %u leituras, %u registros, %u bytes gravados (%u%% da regiao de %u KB)\n",
+           days, week_period_ms, total, log.records, log.bytes_written,
+           (uint32_t)(100ull * log.bytes_written / templog_region_size), templog_region_size / 1024);
+    printf("flash: %u apagamentos, %u paginas gravadas (%u durante templog_append), %u falhas (simuladas %u);"
+           " %u registros descartados\n", templog_host_erases(), templog_host_programs(), append_flash_ops,
+           log.failures, injected, log.dropped);
+    ok = ok && append_flash_ops == 0 && log.dropped == 0 && log.failures == injected;
+    ok = week_check_image(0, &decoded) && ok;
+
+    // Cada apagamento recicla o setor mais antigo: os que sobram vêm logo depois dos apagados
+    ok = week_check_sectors(&oldest, &sectors) && ok;
+    printf("setores: %u validos, sequencias %u a %u\n", sectors, oldest, oldest + sectors - 1);
+    ok = ok && log.erases == templog_host_erases() && log.erases == oldest - 1;
+    if (wrap) {
+        ok = ok && log.erases > 0 && sectors >= templog_sectors - 1 && decoded < total;
+    }
+    else {
+        ok = ok && log.erases == 0 && decoded == total;
+    }
+
+    // Nova partida sobre a mesma imagem: as leituras antigas continuam lá (menos as de um setor reciclado)
+    // e as novas vêm com a partida 1
+    templog_init(&log, week_period_ms);
+    ok = ok && log.boot == 1;
+    for (uint32_t i = 0; i < week_restart_readings; i++) {
+        templog_append(&log, i * week_period_ms, 2500);
+    }
+    templog_flush(&log);
+
+    uint32_t kept;
+    printf("nova partida %u:\n", log.boot);
+    ok = week_check_image(week_restart_readings, &kept) && ok;
+    ok = ok && (wrap ? kept <= decoded : kept == decoded);
+
+    if (output && !templog_host_save(output)) {
+        fprintf(stderr, "erro ao gravar %s\n", output);
+        exit(2);
+    }
+    printf("%s\n\n", ok ? "ok" : "ERRO");
+
+    return ok;
+}
+
+int main(int argc, char **argv) {
+    const char *output = NULL;
+    uint32_t days = 0;
+    bool ok;
+
+    for (int i = 1; i + 1 < argc; i += 2) {
+        if (!strcmp(argv[i], "-d")) {
+            days = (uint32_t)strtoul(argv[i + 1], NULL, 10);
+        }
+        else if (!strcmp(argv[i], "-o")) {
+            output = argv[i + 1];
+        }
+        else {
+            fprintf(stderr, "uso: %s [-d dias] [-o imagem.bin]\n", argv[0]);
+            return 2;
+        }
+    }
+
+    if (days) {
+        ok = week_run(days, days > 7, output);
+    }
+    else {
+        ok = week_run(7, false, NULL);
+        ok = week_run(week_wrap_days, true, output) && ok;
+    }
+    printf("%s\n", ok ? "OK" : "FALHOU");
+
+    return ok ? 0 : 1;
+}
@@ -0,0 +1,196 @@
+#include <string.h>
+#include <assert.h>
+#include "trend.h"
+#include "ssd1306_gfx.h"
+
+void trend_init(trend_t *trend, uint32_t readings_per_bucket) {
+    assert(readings_per_bucket >= 1);
+
+    memset(trend, 0, sizeof(*trend));
+    trend->readings_per_bucket = readings_per_bucket;
+}
+
+static int16_t trend_clamp(int32_t centi) {
+    return centi > INT16_MAX ? INT16_MAX : centi < INT16_MIN ? INT16_MIN : (int16_t)centi;
+}
+
+// Junta uma entrada ao balde em formação do nível; retorna true se o balde completou
+static bool trend_level_add(trend_level_t *level, trend_bucket_t entry, uint32_t per_bucket) {
+    if (level->partial_count == 0) {
+        level->partial = entry;
+    }
+    else {
+        if (entry.min < level->partial.min) {
+            level->partial.min = entry.min;
+        }
+        if (entry.max > level->partial.max) {
+            level->partial.max = entry.max;
+        }
+    }
+
+    if (++level->partial_count < per_bucket) {
+        return false;
+    }
+
+    level->buckets[level->count % trend_buckets] = level->partial;
+    level->count++;
+    level->partial_count = 0;
+
+    return true;
+}
+
+uint32_t trend_add(trend_t *trend, int32_t centi) {
+    trend_bucket_t entry = { trend_clamp(centi), trend_clamp(centi) };
+    uint32_t completed = 0;
+
+    trend->readings++;
+    for (int i = 0; i < trend_levels; i++) {
+        trend_level_t *level = &trend->levels[i];
+
+        if (!trend_level_add(level, entry, i == 0 ? trend->readings_per_bucket : trend_factor)) {
+            break;
+        }
+        completed |= 1u << i;
+        entry = level->buckets[(level->count - 1) % trend_buckets]; // Sobe para o nível seguinte
+    }
+
+    return completed;
+}
+
+uint32_t trend_bucket_readings(const trend_t *trend, int level) {
+    uint32_t readings = trend->readings_per_bucket;
+
+    for (int i = 0; i < level; i++) {
+        readings *= trend_factor;
+    }
+
+    return readings;
+}
+
+int trend_auto_level(const trend_t *trend, int columns) {
+    for (int level = 0; level < trend_levels - 1; level++) {
+        if (trend->readings <= (uint64_t)columns * trend_bucket_readings(trend, level)) {
+            return level;
+        }
+    }
+
+    return trend_levels - 1;
+}
+
+int trend_columns(const trend_t *trend, int level, int columns, trend_bucket_t *out) {
+    const trend_level_t *source = &trend->levels[level];
+    uint32_t available = source->count < trend_buckets ? source->count : trend_buckets;
+    uint32_t first = source->count - available; // Índice (contínuo) do balde mais antigo disponível
+
+    if (available <= (uint32_t)columns) {
+        for (uint32_t i = 0; i < available; i++) {
+            out[i] = source->buckets[(first + i) % trend_buckets];
+        }
+        return available;
+    }
+
+    // Mais baldes que colunas: cada coluna fica com o mínimo e o máximo dos baldes que cobre
+    for (int column = 0; column < columns; column++) {
+        uint32_t begin = first + (uint64_t)column * available / columns;
+        uint32_t end = first + (uint64_t)(column + 1) * available / columns;
+
+        out[column] = source->buckets[begin % trend_buckets];
+        for (uint32_t i = begin + 1; i < end; i++) {
+            const trend_bucket_t *bucket = &source->buckets[i % trend_buckets];
+
+            if (bucket->min < out[column].min) {
+                out[column].min = bucket->min;
+            }
+            if (bucket->max > out[column].max) {
+                out[column].max = bucket->max;
+            }
+        }
+    }
+
+    return columns;
+}
+
+void trend_graph_init(trend_graph_t *graph, int x, int y, int w, int h) {
+    assert(y % ssd1306_page_height == 0 && h % ssd1306_page_height == 0);
+    assert(x >= 0 && x + w <= ssd1306_width && w <= trend_buckets && y + h <= ssd1306_height);
+
+    *graph = (trend_graph_t){ .x = x, .y = y, .w = w, .h = h, .level = -1 };
+}
+
+// Linha do display de um valor na escala do gráfico
+static int trend_graph_row(const trend_graph_t *graph, int32_t centi) {
+    int32_t offset = centi < graph->lo ? 0 : centi > graph->hi ? graph->hi - graph->lo : centi - graph->lo;
+
+    return graph->y + graph->h - 1 - offset * (graph->h - 1) / (graph->hi - graph->lo);
+}
+
+// Apaga a coluna e desenha a faixa mínimo-máximo do balde
+static void trend_graph_column(const trend_graph_t *graph, uint8_t *ssd, int x, const trend_bucket_t *bucket) {
+    ssd1306_draw_vline(ssd, x, graph->y, graph->y + graph->h - 1, false);
+    ssd1306_draw_vline(ssd, x, trend_graph_row(graph, bucket->max), trend_graph_row(graph, bucket->min), true);
+}
+
+// Escala que cobre as colunas, arredondada para fora em degraus de trend_scale_step
+static void trend_graph_scale(const trend_bucket_t *columns, int count, int32_t *lo, int32_t *hi) {
+    int32_t min = columns[0].min, max = columns[0].max;
+
+    for (int i = 1; i < count; i++) {
+        if (columns[i].min < min) {
+            min = columns[i].min;
+        }
+        if (columns[i].max > max) {
+            max = columns[i].max;
+        }
+    }
+
+    *lo = (min >= 0 ? min : min - (trend_scale_step - 1)) / trend_scale_step * trend_scale_step;
+    *hi = (max >= 0 ? max + (trend_scale_step - 1) : max) / trend_scale_step * trend_scale_step;
+    while (*hi - *lo < trend_scale_min_span) {
+        *hi += trend_scale_step;
+        if (*hi - *lo < trend_scale_min_span) {
+            *lo -= trend_scale_step;
+        }
+    }
+}
+
+bool trend_graph_update(trend_graph_t *graph, const trend_t *trend, uint8_t *ssd, uint32_t completed) {
+    trend_bucket_t columns[trend_buckets];
+    int level = trend_auto_level(trend, graph->w);
+    int count = trend_columns(trend, level, graph->w, columns);
+    int32_t lo, hi;
+
+    if (count == 0) {
+        return false;
+    }
+    trend_graph_scale(columns, count, &lo, &hi);
+
+    // Mesmo nível e mesma escala, um balde por coluna: rola uma coluna por balde novo
+    // (rolagem byte a byte em cada página); com decimação todas as colunas mudam e o redesenho é completo
+    bool one_per_column = trend->levels[level].count <= (uint32_t)graph->w || graph->w == trend_buckets;
+
+    if (level == graph->level && lo == graph->lo && hi == graph->hi && one_per_column) {
+        if (!(completed & (1u << level))) {
+            return false;
+        }
+        for (int page = graph->y / ssd1306_page_height; page < (graph->y + graph->h) / ssd1306_page_height; page++) {
+            uint8_t *row = ssd + page * ssd1306_width + graph->x;
+
+            memmove(row, row + 1, graph->w - 1);
+        }
+        trend_graph_column(graph, ssd, graph->x + graph->w - 1, &columns[count - 1]);
+        graph->columns = count;
+        return false;
+    }
+
+    // Redesenho completo: colunas alinhadas à direita, a mais nova na borda
+    graph->level = level;
+    graph->lo = lo;
+    graph->hi = hi;
+    graph->columns = count;
+    ssd1306_fill_rect(ssd, graph->x, graph->y, graph->w, graph->h, false);
+    for (int i = 0; i < count; i++) {
+        trend_graph_column(graph, ssd, graph->x + graph->w - count + i, &columns[i]);
+    }
+
+    return true;
+}
@@ -0,0 +1,66 @@
+#include <stdint.h>
+#include <stdbool.h>
+
+#ifndef trend_inc_h
+#define trend_inc_h
+
+// Histórico de longo prazo em memória limitada, em vários níveis de resolução: cada nível guarda os
+// últimos trend_buckets baldes com mínimo e máximo; trend_factor baldes de um nível formam um do seguinte.
+// Com 1 s por balde no nível 0: 2 min, 8,5 min, 34 min, 2,3 h, 9,1 h, 36 h e 6 dias de histórico.
+// O gráfico (trend_graph_t) mostra um nível com uma coluna por balde (faixa mínimo-máximo, que preserva
+// picos e vales) e rola uma coluna por balde completo: só a coluna nova é desenhada; o gráfico inteiro
+// só é redesenhado quando muda o nível ou a escala vertical
+
+#define trend_levels 7
+#define trend_buckets 128 // Baldes por nível (uma coluna do display cada)
+#define trend_factor 4
+
+// Escala vertical: múltiplos de trend_scale_step centésimos, com pelo menos trend_scale_min_span
+#define trend_scale_step 50
+#define trend_scale_min_span 100
+
+typedef struct {
+    int16_t min, max; // Centésimos de grau
+} trend_bucket_t;
+
+typedef struct {
+    trend_bucket_t buckets[trend_buckets];
+    uint32_t count;          // Baldes completos desde o início (o mais novo em (count - 1) % trend_buckets)
+    trend_bucket_t partial;  // Balde em formação
+    uint32_t partial_count;  // Entradas no balde em formação (leituras no nível 0, baldes nos outros)
+} trend_level_t;
+
+typedef struct {
+    trend_level_t levels[trend_levels];
+    uint32_t readings_per_bucket; // Leituras por balde do nível 0
+    uint32_t readings;            // Leituras recebidas
+} trend_t;
+
+typedef struct {
+    int x, y, w, h;  // Área no display (y e h múltiplos de 8: a rolagem move bytes das páginas)
+    int level;       // Nível mostrado (-1: nada desenhado)
+    int32_t lo, hi;  // Escala vertical em centésimos
+    int columns;     // Colunas com dados (alinhadas à direita)
+} trend_graph_t;
+
+void trend_init(trend_t *trend, uint32_t readings_per_bucket);
+
+// Acrescenta uma leitura; retorna os níveis (bit n = nível n) que completaram um balde
+uint32_t trend_add(trend_t *trend, int32_t centi);
+
+// Leituras por balde de um nível
+uint32_t trend_bucket_readings(const trend_t *trend, int level);
+
+// Nível mais fino cujos columns baldes cobrem todo o histórico (o mais grosso quando nenhum cobre)
+int trend_auto_level(const trend_t *trend, int columns);
+
+// Mapeia os baldes mais recentes de um nível em até columns colunas (do mais antigo ao mais novo) por
+// decimação mínimo/máximo; retorna quantas colunas têm dados
+int trend_columns(const trend_t *trend, int level, int columns, trend_bucket_t *out);
+
+void trend_graph_init(trend_graph_t *graph, int x, int y, int w, int h);
+
+// Atualiza o gráfico no buffer do display depois de trend_add(); retorna true se redesenhou tudo
+bool trend_graph_update(trend_graph_t *graph, const trend_t *trend, uint8_t *ssd, uint32_t completed);
+
+#endif